@@ -0,0 +1,100 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    Mosaic is distributed under the MIT License. This gives everyone the
+    freedoms to use Mosaic in any context: commercial or non-commercial,
+    public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppGLFWWindow.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+// Benchmark runner: generates a synthetic patch, loads it and runs it headless.
+//
+//   --objects N        objects per category (default 10)
+//   --categories a,b   object categories (default: every category)
+//   --fanout F         links from every outlet to the next chain level (default 2)
+//   --depth D          chain depth, levels of the generated graph (default 4)
+//   --links t,t        link types: numeric,string,array,texture,audio (default numeric)
+//   --frames M         update() frames and audio buffers to run (default 600)
+//   --out file.json    report (default benchmark_report.json, in data/)
+//   --gl               hidden GL window, GL objects included
+//
+int main(int argc, char *argv[]){
+
+    vector<string> options;
+
+    if(argc > 1){
+        for(int i = 0; i < argc; i++){
+            options.push_back(argv[i]);
+        }
+    }
+
+    shared_ptr<ofApp> benchmarkApp(new ofApp);
+
+    bool useGL = false;
+    for(size_t i=1;i<options.size();i++){
+        if(options[i] == "--gl"){
+            useGL = true;
+        }else if(i+1 < options.size()){
+            if(options[i] == "--objects"){
+                benchmarkApp->objectsPerCategory = ofToInt(options[i+1]);
+            }else if(options[i] == "--categories"){
+                benchmarkApp->categories = ofSplitString(options[i+1],",",true,true);
+            }else if(options[i] == "--fanout"){
+                benchmarkApp->fanout = ofToInt(options[i+1]);
+            }else if(options[i] == "--depth"){
+                benchmarkApp->depth = ofToInt(options[i+1]);
+            }else if(options[i] == "--links"){
+                benchmarkApp->linkTypes = ofSplitString(options[i+1],",",true,true);
+            }else if(options[i] == "--frames"){
+                benchmarkApp->numFrames = ofToInt(options[i+1]);
+            }else if(options[i] == "--out"){
+                benchmarkApp->reportFile = options[i+1];
+            }
+        }
+    }
+
+    if(useGL){
+        ofGLFWWindowSettings settings;
+        settings.setGLVersion(2, 1);
+        settings.setSize(1280,720);
+        settings.visible = false;
+        shared_ptr<ofAppBaseWindow> benchmarkWindow = ofCreateWindow(settings);
+        ofRunApp(benchmarkWindow,benchmarkApp);
+        ofRunMainLoop();
+    }else{
+        ofSetupOpenGL(make_shared<ofAppNoWindow>(),1280,720,OF_WINDOW);
+        ofRunApp(benchmarkApp);
+    }
+
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,400 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    Mosaic is distributed under the MIT License. This gives everyone the
+    freedoms to use Mosaic in any context: commercial or non-commercial,
+    public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "ofApp.h"
+
+#include <new>
+
+#if defined(TARGET_LINUX)
+#include <unistd.h>
+#elif defined(TARGET_OSX)
+#include <sys/resource.h>
+#endif
+
+//--------------------------------------------------------------
+// allocation counters, every new/delete of the process goes through here
+static std::atomic<uint64_t> numAllocations(0);
+static std::atomic<uint64_t> allocatedBytes(0);
+
+void* operator new(size_t size){
+    numAllocations.fetch_add(1,std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size,std::memory_order_relaxed);
+    void *p = malloc(size == 0 ? 1 : size);
+    if(p == nullptr){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size){
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept{
+    free(p);
+}
+
+//--------------------------------------------------------------
+static int linkTypeFromName(const string &name){
+    if(name == "numeric"){
+        return VP_LINK_NUMERIC;
+    }else if(name == "string"){
+        return VP_LINK_STRING;
+    }else if(name == "array"){
+        return VP_LINK_ARRAY;
+    }else if(name == "texture"){
+        return VP_LINK_TEXTURE;
+    }else if(name == "audio"){
+        return VP_LINK_AUDIO;
+    }
+    return -1;
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+    ofSetFrameRate(0);
+
+    // virtual time, every run renders the same frames and audio buffers
+    PatchClock::getInstance().setFixedStep(60);
+
+    memoryStart = getResidentMemory();
+
+    visualProgramming = new ofxVisualProgramming();
+    visualProgramming->setHeadless(true);
+    visualProgramming->setup();
+
+    generatePatch();
+    loadGeneratedPatch();
+
+    memoryLoaded = getResidentMemory();
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+    runFrames();
+
+    memoryEnd = getResidentMemory();
+
+    writeReport();
+
+    ofExit(0);
+}
+
+//--------------------------------------------------------------
+void ofApp::exit(){
+    visualProgramming->exit();
+}
+
+//--------------------------------------------------------------
+void ofApp::generatePatch(){
+    depth = std::max(depth,1);
+    fanout = std::max(fanout,0);
+
+    // GENERATE: N objects for every requested category
+    uint64_t startAllocations = numAllocations;
+    uint64_t startBytes = allocatedBytes;
+    uint64_t startTime = ofGetElapsedTimeMicros();
+
+    std::map<std::string,std::vector<std::string>> factoryCategories = ObjectFactory::getInstance().getCategories();
+    vector<string> names;
+    for(std::map<std::string,std::vector<std::string>>::iterator it = factoryCategories.begin(); it != factoryCategories.end(); it++ ){
+        if(!categories.empty() && std::find(categories.begin(),categories.end(),it->first) == categories.end()){
+            continue;
+        }
+        for(size_t i=0;i<it->second.size();i++){
+            const ObjectFactoryEntry *entry = ObjectFactory::getInstance().getEntry(it->second.at(i));
+            // single instance and hardware bound objects are not part of a synthetic patch
+            if(entry == nullptr || it->second.at(i) == "live patching" || it->second.at(i) == "audio device"){
+                continue;
+            }
+            if(entry->isMainThreadOnly() && !visualProgramming->getHasGLContext()){
+                continue;
+            }
+            names.push_back(it->second.at(i));
+        }
+    }
+
+    // objects go round robin over the chain levels, so every level mixes all the categories
+    vector<vector<PatchObject*>> levels(depth);
+    int index = 0;
+    for(int n=0;n<objectsPerCategory;n++){
+        for(size_t i=0;i<names.size();i++){
+            int level = index % depth;
+            ofVec2f pos(200 + level*300, 100 + static_cast<int>(levels[level].size())*150);
+            visualProgramming->addObject(names.at(i),pos);
+            PatchObject *obj = visualProgramming->getLastAddedObject();
+            if(obj != nullptr && obj->getName() == names.at(i)){
+                levels[level].push_back(obj);
+                numObjects++;
+            }
+            index++;
+        }
+    }
+
+    phasesMicros["generate"] = ofGetElapsedTimeMicros() - startTime;
+    phasesAllocations["generate"] = numAllocations - startAllocations;
+    phasesAllocatedBytes["generate"] = allocatedBytes - startBytes;
+
+    // CONNECT: every outlet of a requested type feeds up to F free inlets of the next level
+    vector<int> types;
+    for(size_t i=0;i<linkTypes.size();i++){
+        int type = linkTypeFromName(linkTypes.at(i));
+        if(type != -1){
+            types.push_back(type);
+        }else{
+            ofLog(OF_LOG_WARNING,"Unknown link type %s",linkTypes.at(i).c_str());
+        }
+    }
+
+    startAllocations = numAllocations;
+    startBytes = allocatedBytes;
+    startTime = ofGetElapsedTimeMicros();
+
+    for(int l=0;l<depth-1;l++){
+        vector<PatchObject*> &targets = levels[l+1];
+        if(targets.empty()){
+            continue;
+        }
+        size_t cursor = 0;
+        for(size_t i=0;i<levels[l].size();i++){
+            PatchObject *from = levels[l].at(i);
+            for(int j=0;j<from->getNumOutlets();j++){
+                if(std::find(types.begin(),types.end(),from->getOutletType(j)) == types.end()){
+                    continue;
+                }
+                int linked = 0;
+                for(size_t t=0;t<targets.size() && linked < fanout;t++){
+                    PatchObject *to = targets.at((cursor+t) % targets.size());
+                    for(int k=0;k<to->getNumInlets();k++){
+                        if(to->getInletType(k) == from->getOutletType(j) && !to->inletsConnected[k]){
+                            if(visualProgramming->connect(from->getId(),j,to->getId(),k,from->getOutletType(j))){
+                                linked++;
+                                numLinks++;
+                            }
+                            break;
+                        }
+                    }
+                }
+                cursor += static_cast<size_t>(std::max(linked,1));
+            }
+            from->saveConfig(true,from->getId());
+        }
+    }
+
+    phasesMicros["connect"] = ofGetElapsedTimeMicros() - startTime;
+    phasesAllocations["connect"] = numAllocations - startAllocations;
+    phasesAllocatedBytes["connect"] = allocatedBytes - startBytes;
+
+    // SAVE
+    startTime = ofGetElapsedTimeMicros();
+
+    patchFile = ofToDataPath("benchmark_patch.xml",true);
+    visualProgramming->savePatchAs(patchFile);
+
+    phasesMicros["save"] = ofGetElapsedTimeMicros() - startTime;
+
+    ofLog(OF_LOG_NOTICE,"Generated patch with %i objects and %i links",numObjects,numLinks);
+}
+
+//--------------------------------------------------------------
+void ofApp::loadGeneratedPatch(){
+    uint64_t startAllocations = numAllocations;
+    uint64_t startBytes = allocatedBytes;
+    uint64_t startTime = ofGetElapsedTimeMicros();
+
+    visualProgramming->newTempPatchFromFile(patchFile);
+
+    phasesMicros["load"] = ofGetElapsedTimeMicros() - startTime;
+    phasesAllocations["load"] = numAllocations - startAllocations;
+    phasesAllocatedBytes["load"] = allocatedBytes - startBytes;
+}
+
+//--------------------------------------------------------------
+void ofApp::runFrames(){
+    updateMicros.reserve(numFrames);
+    audioMicros.reserve(numFrames);
+
+    // UPDATE: every frame advances the patch by 1/60 s, headless audio included
+    uint64_t startAllocations = numAllocations;
+    uint64_t startBytes = allocatedBytes;
+
+    for(int i=0;i<numFrames;i++){
+        uint64_t startTime = ofGetElapsedTimeMicros();
+        visualProgramming->update();
+        updateMicros.push_back(ofGetElapsedTimeMicros() - startTime);
+    }
+
+    phasesAllocations["update"] = numAllocations - startAllocations;
+    phasesAllocatedBytes["update"] = allocatedBytes - startBytes;
+
+    // AUDIO: the audio callback alone, one buffer per run, silent input
+    int bufferSize = visualProgramming->audioBufferSize > 0 ? visualProgramming->audioBufferSize : 256;
+    vector<float> input(static_cast<size_t>(bufferSize),0.0f);
+
+    startAllocations = numAllocations;
+    startBytes = allocatedBytes;
+
+    for(int i=0;i<numFrames;i++){
+        uint64_t startTime = ofGetElapsedTimeMicros();
+        visualProgramming->processAudioBlock(&input[0],bufferSize,1);
+        audioMicros.push_back(ofGetElapsedTimeMicros() - startTime);
+    }
+
+    phasesAllocations["audio"] = numAllocations - startAllocations;
+    phasesAllocatedBytes["audio"] = allocatedBytes - startBytes;
+
+    // close the current profiler window, the report reads the latest percentiles
+    PatchProfiler::getInstance().update(true);
+}
+
+//--------------------------------------------------------------
+BenchmarkTimings ofApp::computeTimings(vector<uint64_t> &samples){
+    BenchmarkTimings t;
+    t.count         = samples.size();
+    t.meanMicros    = 0.0f;
+    t.p50Micros     = 0;
+    t.p95Micros     = 0;
+    t.maxMicros     = 0;
+
+    if(samples.empty()){
+        return t;
+    }
+
+    vector<uint64_t> sorted(samples);
+    std::sort(sorted.begin(),sorted.end());
+
+    uint64_t total = 0;
+    for(size_t i=0;i<sorted.size();i++){
+        total += sorted.at(i);
+    }
+    t.meanMicros    = static_cast<float>(total) / static_cast<float>(sorted.size());
+    t.p50Micros     = sorted.at((sorted.size()-1) * 50 / 100);
+    t.p95Micros     = sorted.at((sorted.size()-1) * 95 / 100);
+    t.maxMicros     = sorted.back();
+
+    return t;
+}
+
+//--------------------------------------------------------------
+string ofApp::timingsToJson(const BenchmarkTimings &t){
+    return "{ \"count\": "+ofToString(t.count)+", \"mean_us\": "+ofToString(t.meanMicros,2)+", \"p50_us\": "+ofToString(t.p50Micros)+", \"p95_us\": "+ofToString(t.p95Micros)+", \"max_us\": "+ofToString(t.maxMicros)+" }";
+}
+
+//--------------------------------------------------------------
+uint64_t ofApp::getResidentMemory(){
+#if defined(TARGET_LINUX)
+    ifstream statm("/proc/self/statm");
+    uint64_t pages = 0;
+    uint64_t residentPages = 0;
+    if(statm >> pages >> residentPages){
+        return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+    return 0;
+#elif defined(TARGET_OSX)
+    // peak resident size, in bytes on osx
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF,&usage) == 0){
+        return static_cast<uint64_t>(usage.ru_maxrss);
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+//--------------------------------------------------------------
+void ofApp::writeReport(){
+    string path = ofToDataPath(reportFile,true);
+    ofstream out(path.c_str());
+    if(!out.is_open()){
+        ofLog(OF_LOG_ERROR,"Can't write the benchmark report to %s",path.c_str());
+        return;
+    }
+
+    out << "{" << endl;
+
+    out << "  \"parameters\": { \"objects_per_category\": " << objectsPerCategory << ", \"fanout\": " << fanout << ", \"depth\": " << depth << ", \"frames\": " << numFrames << ", \"categories\": [";
+    for(size_t i=0;i<categories.size();i++){
+        out << (i > 0 ? ", " : "") << "\"" << categories.at(i) << "\"";
+    }
+    out << "], \"links\": [";
+    for(size_t i=0;i<linkTypes.size();i++){
+        out << (i > 0 ? ", " : "") << "\"" << linkTypes.at(i) << "\"";
+    }
+    out << "], \"gl\": " << (visualProgramming->getHasGLContext() ? "true" : "false") << " }," << endl;
+
+    out << "  \"patch\": { \"objects\": " << numObjects << ", \"links\": " << numLinks << ", \"loaded_objects\": " << visualProgramming->patchObjects.size() << " }," << endl;
+
+    out << "  \"phases_us\": { ";
+    for(map<string,uint64_t>::iterator it = phasesMicros.begin(); it != phasesMicros.end(); it++ ){
+        out << (it != phasesMicros.begin() ? ", " : "") << "\"" << it->first << "\": " << it->second;
+    }
+    out << " }," << endl;
+
+    out << "  \"update\": " << timingsToJson(computeTimings(updateMicros)) << "," << endl;
+    out << "  \"audio\": " << timingsToJson(computeTimings(audioMicros)) << "," << endl;
+
+    out << "  \"allocations\": { ";
+    for(map<string,uint64_t>::iterator it = phasesAllocations.begin(); it != phasesAllocations.end(); it++ ){
+        out << (it != phasesAllocations.begin() ? ", " : "") << "\"" << it->first << "\": { \"count\": " << it->second << ", \"bytes\": " << phasesAllocatedBytes[it->first] << " }";
+    }
+    out << " }," << endl;
+
+    out << "  \"memory\": { \"start_bytes\": " << memoryStart << ", \"loaded_bytes\": " << memoryLoaded << ", \"end_bytes\": " << memoryEnd << " }," << endl;
+
+    out << "  \"top_objects\": {" << endl;
+    for(int p=0;p<VP_PROFILE_NUM_PHASES;p++){
+        vector<ProfilerSummary> top = PatchProfiler::getInstance().getTopObjects(p,10);
+        out << "    \"" << PatchProfiler::getPhaseName(p) << "\": [";
+        for(size_t i=0;i<top.size();i++){
+            out << (i > 0 ? ", " : "") << "{ \"id\": " << top.at(i).objectID << ", \"name\": \"" << top.at(i).objectName << "\", \"mean_us\": " << ofToString(top.at(i).meanMicros,2) << ", \"p95_us\": " << top.at(i).p95Micros << ", \"max_us\": " << top.at(i).maxMicros << " }";
+        }
+        out << "]" << (p < VP_PROFILE_NUM_PHASES-1 ? "," : "") << endl;
+    }
+    out << "  }" << endl;
+
+    out << "}" << endl;
+
+    ofLog(OF_LOG_NOTICE,"Benchmark report saved to %s",path.c_str());
+}
@@ -0,0 +1,87 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    Mosaic is distributed under the MIT License. This gives everyone the
+    freedoms to use Mosaic in any context: commercial or non-commercial,
+    public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+#include "ofxVisualProgramming.h"
+
+struct BenchmarkTimings{
+    uint64_t        count;
+    float           meanMicros;
+    uint64_t        p50Micros;
+    uint64_t        p95Micros;
+    uint64_t        maxMicros;
+};
+
+class ofApp : public ofBaseApp{
+
+public:
+    void setup();
+    void update();
+    void exit();
+
+    void                generatePatch();
+    void                loadGeneratedPatch();
+    void                runFrames();
+    void                writeReport();
+
+    BenchmarkTimings    computeTimings(vector<uint64_t> &samples);
+    string              timingsToJson(const BenchmarkTimings &t);
+    uint64_t            getResidentMemory();
+
+    ofxVisualProgramming    *visualProgramming;
+
+    // PARAMETERS
+    int                     objectsPerCategory = 10;
+    vector<string>          categories;
+    int                     fanout = 2;
+    int                     depth = 4;
+    vector<string>          linkTypes = {"numeric"};
+    int                     numFrames = 600;
+    string                  reportFile = "benchmark_report.json";
+
+    // RESULTS
+    string                  patchFile;
+    int                     numObjects = 0;
+    int                     numLinks = 0;
+    map<string,uint64_t>    phasesMicros;           // generate, connect, save, load
+    map<string,uint64_t>    phasesAllocations;
+    map<string,uint64_t>    phasesAllocatedBytes;
+    vector<uint64_t>        updateMicros;
+    vector<uint64_t>        audioMicros;
+    uint64_t                memoryStart = 0;
+    uint64_t                memoryLoaded = 0;
+    uint64_t                memoryEnd = 0;
+
+};
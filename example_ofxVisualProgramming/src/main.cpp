@@ -33,6 +33,7 @@
 #include "ofMain.h"
 #include "ofApp.h"
 #include "ofAppGLFWWindow.h"
+#include "ofAppNoWindow.h"
 #include "ofxTimeMeasurements.h"
 
 //========================================================================
@@ -48,11 +49,36 @@ int main(int argc, char *argv[]){
 
     shared_ptr<ofApp> mosaicApp(new ofApp);
 
+    // --headless patch.xml : run the patch without a visible window (batch processing, build servers),
+    //                        GL and GUI objects need a display for the offscreen GL context
+    // --fixed-step fps : virtual patch time, 1/fps seconds every frame, with no frame rate limit
+    for(size_t i=1;i+1<options.size();i++){
+        if(options[i] == "--headless"){
+            mosaicApp->headlessPatch = options[i+1];
+        }else if(options[i] == "--fixed-step"){
+            mosaicApp->fixedStepFPS = ofToInt(options[i+1]);
+        }
+    }
+
     ofGLFWWindowSettings settings;
     settings.setGLVersion(2, 1);
     settings.stencilBits = 0;
     settings.setSize(1280,720);
 
+    if(mosaicApp->headlessPatch != ""){
+        bool hasDisplay = true;
+#ifdef TARGET_LINUX
+        hasDisplay = getenv("DISPLAY") != nullptr || getenv("WAYLAND_DISPLAY") != nullptr;
+#endif
+        if(!hasDisplay){
+            // no GL context at all, only the objects with neither GL nor GUI are loaded
+            ofSetupOpenGL(make_shared<ofAppNoWindow>(),1280,720,OF_WINDOW);
+            return ofRunApp(mosaicApp);
+        }
+        // hidden window: an offscreen GL context for the GL and GUI objects
+        settings.visible = false;
+    }
+
     // Mosaic main visual-programming window
     shared_ptr<ofAppBaseWindow> mosaicWindow = ofCreateWindow(settings);
 
@@ -37,8 +37,20 @@ void ofApp::setup(){
     ofSetWindowTitle("ofxVisualProgramming Example");
     ofSetDrawBitmapMode(OF_BITMAPMODE_SIMPLE);
 
+    if(fixedStepFPS > 0){
+        PatchClock::getInstance().setFixedStep(fixedStepFPS);
+        ofSetFrameRate(0);
+    }
+
     visualProgramming = new ofxVisualProgramming();
+    if(headlessPatch != ""){
+        visualProgramming->setHeadless(true);
+    }
     visualProgramming->setup();
+
+    if(headlessPatch != ""){
+        visualProgramming->newTempPatchFromFile(headlessPatch);
+    }
 }
 
 //--------------------------------------------------------------
@@ -56,5 +56,7 @@ public:
     void gotMessage(ofMessage msg);
 
     ofxVisualProgramming    *visualProgramming;
+    string                  headlessPatch;
+    int                     fixedStepFPS = 0;
 
 };
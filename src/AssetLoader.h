@@ -0,0 +1,119 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+#include "ThreadPool.h"
+
+// Background loading of the objects resources (images, audio files, cascades, ...).
+// The load function runs on the loader threads and must not touch GL or the object GUI,
+// the done function runs on the main thread (from update()), where the object goes live.
+class AssetLoader{
+
+public:
+
+    static AssetLoader& getInstance(){
+        static AssetLoader instance;
+        return instance;
+    }
+
+    ~AssetLoader(){
+        stop();
+    }
+
+    void setup(int numThreads = 2){
+        pool.setup(numThreads);
+    }
+
+    void stop(){
+        pool.stop();
+        std::unique_lock<std::mutex> lck(doneMutex);
+        doneTasks.clear();
+    }
+
+    void load(std::function<void()> loadFunc, std::function<void()> doneFunc){
+        if(!pool.isRunning()){
+            setup();
+        }
+        if(numTotal == numCompleted){
+            startTime = ofGetElapsedTimeMillis();
+        }
+        numTotal++;
+        pool.submit(job,[this,loadFunc,doneFunc](){
+            loadFunc();
+            std::unique_lock<std::mutex> lck(doneMutex);
+            doneTasks.push_back(doneFunc);
+        });
+    }
+
+    // main thread: hand the loaded resources to their objects
+    void update(){
+        std::vector<std::function<void()>> tempTasks;
+        {
+            std::unique_lock<std::mutex> lck(doneMutex);
+            tempTasks.swap(doneTasks);
+        }
+        for(size_t i=0;i<tempTasks.size();i++){
+            tempTasks.at(i)();
+        }
+        if(!tempTasks.empty()){
+            numCompleted += tempTasks.size();
+            if(numCompleted == numTotal){
+                ofLog(OF_LOG_NOTICE,"[verbose] %zu assets loaded in %i ms",numTotal,static_cast<int>(ofGetElapsedTimeMillis()-startTime));
+                numTotal        = 0;
+                numCompleted    = 0;
+            }
+        }
+    }
+
+    bool    isLoading() const { return numCompleted < numTotal; }
+    size_t  getNumPending() const { return numTotal - numCompleted; }
+    float   getProgress() const { return numTotal > 0 ? static_cast<float>(numCompleted)/static_cast<float>(numTotal) : 1.0f; }
+
+protected:
+
+    AssetLoader(){
+        numTotal        = 0;
+        numCompleted    = 0;
+        startTime       = 0;
+    }
+
+    ThreadPool                              pool;
+    ThreadPool::Job                         job;
+    std::mutex                              doneMutex;
+    std::vector<std::function<void()>>      doneTasks;
+    size_t                                  numTotal;
+    size_t                                  numCompleted;
+    uint64_t                                startTime;
+
+};
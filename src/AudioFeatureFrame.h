@@ -0,0 +1,132 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+// single values of an analysis window, in frame order
+enum AudioFeatureValue{
+    AUDIO_FEATURE_RMS,
+    AUDIO_FEATURE_POWER,
+    AUDIO_FEATURE_PITCH,
+    AUDIO_FEATURE_HFC,
+    AUDIO_FEATURE_CENTROID,
+    AUDIO_FEATURE_INHARMONICITY,
+    AUDIO_FEATURE_DISSONANCE,
+    AUDIO_FEATURE_ROLLOFF,
+    AUDIO_FEATURE_ONSET,
+    AUDIO_FEATURE_BPM,
+    AUDIO_FEATURE_BEAT,
+    AUDIO_FEATURE_VALUES
+};
+
+// Read only window over a part of an AudioFeatureFrame, valid until the frame is reallocated.
+class AudioFeatureView{
+
+public:
+
+    AudioFeatureView(const float *_data=nullptr, size_t _size=0) : data(_data), length(_size) {}
+
+    const float*    begin() const { return data; }
+    const float*    end() const { return data+length; }
+    size_t          size() const { return length; }
+    bool            empty() const { return length == 0; }
+    float           operator[](size_t i) const { return data[i]; }
+
+private:
+
+    const float     *data;
+    size_t          length;
+
+};
+
+// Payload of the VP_LINK_AUDIOFEATURES links (audio analyzer outlet): one analysis window laid out
+// in a single buffer, signal | spectrum | mel bands | mfcc | hpcp | tristimulus | single values.
+// The extractors read it through the named views, nothing is copied per extractor.
+class AudioFeatureFrame{
+
+public:
+
+    enum Section{ SIGNAL, SPECTRUM, MELBANDS, MFCC, HPCP, TRISTIMULUS, VALUES, SECTIONS };
+
+    AudioFeatureFrame(){ std::fill(offsets,offsets+SECTIONS+1,0); }
+
+    // sizes of the vector sections, the single values are appended
+    void allocate(size_t signalSize, size_t spectrumSize, size_t melBandsSize, size_t mfccSize, size_t hpcpSize, size_t tristimulusSize){
+        size_t sizes[VALUES] = {signalSize,spectrumSize,melBandsSize,mfccSize,hpcpSize,tristimulusSize};
+        offsets[0] = 0;
+        for(int i=0;i<VALUES;i++){
+            offsets[i+1] = offsets[i]+sizes[i];
+        }
+        offsets[SECTIONS] = offsets[VALUES]+AUDIO_FEATURE_VALUES;
+        data.assign(offsets[SECTIONS],0.0f);
+    }
+
+    bool                empty() const { return data.empty(); }
+
+    // follow raw with an exponential smoothing (0 none, towards 1 slower): the vector sections and the
+    // values up to the onset, the signal and the onset, bpm and beat values are copied as they are
+    void smoothFrom(const AudioFeatureFrame &raw, float smoothing){
+        if(raw.data.size() != data.size() || smoothing <= 0.0f){
+            *this = raw;
+            return;
+        }
+        size_t begin    = offsets[SPECTRUM];
+        size_t end      = offsets[VALUES]+AUDIO_FEATURE_ONSET;
+        std::copy(raw.data.begin(),raw.data.begin()+begin,data.begin());
+        for(size_t i=begin;i<end;i++){
+            data[i] = data[i]*smoothing + raw.data[i]*(1.0f-smoothing);
+        }
+        std::copy(raw.data.begin()+end,raw.data.end(),data.begin()+end);
+    }
+
+    // the whole layout, for the analyzer filling it
+    vector<float>&      getData() { return data; }
+    size_t              getOffset(Section s) const { return offsets[s]; }
+
+    AudioFeatureView    getSignal() const { return getSection(SIGNAL); }
+    AudioFeatureView    getSpectrum() const { return getSection(SPECTRUM); }
+    AudioFeatureView    getMelBands() const { return getSection(MELBANDS); }
+    AudioFeatureView    getMFCC() const { return getSection(MFCC); }
+    AudioFeatureView    getHPCP() const { return getSection(HPCP); }
+    AudioFeatureView    getTristimulus() const { return getSection(TRISTIMULUS); }
+    float               getValue(int feature) const { return empty() ? 0.0f : data[offsets[VALUES]+feature]; }
+
+protected:
+
+    AudioFeatureView    getSection(Section s) const { return empty() ? AudioFeatureView() : AudioFeatureView(data.data()+offsets[s],offsets[s+1]-offsets[s]); }
+
+    vector<float>                   data;
+    size_t                          offsets[SECTIONS+1];
+
+};
@@ -0,0 +1,284 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "AudioFileWriter.h"
+
+//--------------------------------------------------------------
+AudioFileWriter::AudioFileWriter(){
+    sampleRate      = 0;
+    numChannels     = 0;
+    samplesHead     = 0;
+    samplesTail     = 0;
+    blocksHead      = 0;
+    blocksTail      = 0;
+    recording       = false;
+    pushing         = false;
+    overruns        = 0;
+    framesIn        = 0;
+    framesWritten   = 0;
+}
+
+//--------------------------------------------------------------
+AudioFileWriter::~AudioFileWriter(){
+    stop();
+}
+
+//--------------------------------------------------------------
+bool AudioFileWriter::startFile(const string &path, int _sampleRate, int _numChannels){
+    stop();
+
+    file.open(path.c_str(),std::ios::binary | std::ios::trunc);
+    if(!file.is_open()){
+        ofLog(OF_LOG_ERROR,"Can't open %s for recording",path.c_str());
+        return false;
+    }
+
+    // header with final sizes written on stop, the JUNK chunk is the room of the RF64 ds64 chunk
+    uint32_t u32;
+    uint16_t u16;
+    char junk[28] = {0};
+    file.write("RIFF",4);
+    u32 = 0;                                                    file.write(reinterpret_cast<char*>(&u32),4);
+    file.write("WAVE",4);
+    file.write("JUNK",4);
+    u32 = 28;                                                   file.write(reinterpret_cast<char*>(&u32),4);
+    file.write(junk,28);
+    file.write("fmt ",4);
+    u32 = 16;                                                   file.write(reinterpret_cast<char*>(&u32),4);
+    u16 = 3;                                                    file.write(reinterpret_cast<char*>(&u16),2);   // IEEE float
+    u16 = static_cast<uint16_t>(_numChannels);                  file.write(reinterpret_cast<char*>(&u16),2);
+    u32 = static_cast<uint32_t>(_sampleRate);                   file.write(reinterpret_cast<char*>(&u32),4);
+    u32 = static_cast<uint32_t>(_sampleRate*_numChannels*4);    file.write(reinterpret_cast<char*>(&u32),4);
+    u16 = static_cast<uint16_t>(_numChannels*4);                file.write(reinterpret_cast<char*>(&u16),2);
+    u16 = 32;                                                   file.write(reinterpret_cast<char*>(&u16),2);
+    file.write("data",4);
+    u32 = 0;                                                    file.write(reinterpret_cast<char*>(&u32),4);
+
+    callback = nullptr;
+    return start(_sampleRate,_numChannels);
+}
+
+//--------------------------------------------------------------
+bool AudioFileWriter::startCallback(int _sampleRate, int _numChannels, BlockCallback _callback){
+    stop();
+
+    callback = _callback;
+    return start(_sampleRate,_numChannels);
+}
+
+//--------------------------------------------------------------
+bool AudioFileWriter::start(int _sampleRate, int _numChannels){
+    sampleRate      = std::max(_sampleRate,1);
+    numChannels     = std::max(_numChannels,1);
+
+    // all the memory the audio thread will touch
+    samples.assign(static_cast<size_t>(sampleRate*numChannels*WRITER_RING_SECONDS),0.0f);
+    blocks.assign(WRITER_RING_BLOCKS,Block());
+    scratch.assign(samples.size(),0.0f);
+
+    samplesHead     = 0;
+    samplesTail     = 0;
+    blocksHead      = 0;
+    blocksTail      = 0;
+    overruns        = 0;
+    framesIn        = 0;
+    framesWritten   = 0;
+
+    startThread();
+    recording = true;
+    return true;
+}
+
+//--------------------------------------------------------------
+void AudioFileWriter::stop(){
+    if(!recording){
+        return;
+    }
+    recording = false;
+
+    // the audio thread can be inside push, let it publish its last block
+    while(pushing.load()){
+        std::this_thread::yield();
+    }
+
+    stopThread();
+    waitForThread(false);
+    while(drain()){}
+
+    if(file.is_open()){
+        finalizeFile();
+        file.close();
+    }
+    callback = nullptr;
+
+    ofLog(OF_LOG_NOTICE,"[verbose] recording stopped, %s frames written, %s overruns",ofToString(framesWritten.load()).c_str(),ofToString(overruns.load()).c_str());
+}
+
+//--------------------------------------------------------------
+bool AudioFileWriter::push(const ofSoundBuffer &buffer){
+    pushing.store(true);
+    if(!recording.load()){
+        pushing.store(false);
+        return false;
+    }
+
+    size_t numFrames = buffer.getNumFrames();
+    size_t bufferChannels = buffer.getNumChannels();
+    size_t needed = numFrames*static_cast<size_t>(numChannels);
+    uint64_t startFrame = framesIn;
+    framesIn += numFrames;
+
+    uint64_t sh = samplesHead.load(std::memory_order_relaxed);
+    uint64_t bh = blocksHead.load(std::memory_order_relaxed);
+    if(bh-blocksTail.load(std::memory_order_acquire) >= blocks.size() || samples.size()-(sh-samplesTail.load(std::memory_order_acquire)) < needed){
+        // writer too slow, the block is dropped and will be written as silence
+        overruns.fetch_add(1,std::memory_order_relaxed);
+        pushing.store(false);
+        return false;
+    }
+
+    const float *src = buffer.getBuffer().data();
+    size_t capacity = samples.size();
+    for(size_t i=0;i<numFrames;i++){
+        for(size_t c=0;c<static_cast<size_t>(numChannels);c++){
+            samples[(sh+i*numChannels+c) % capacity] = c < bufferChannels ? src[i*bufferChannels+c] : 0.0f;
+        }
+    }
+    blocks[bh % blocks.size()].startFrame = startFrame;
+    blocks[bh % blocks.size()].numFrames = numFrames;
+
+    samplesHead.store(sh+needed,std::memory_order_release);
+    blocksHead.store(bh+1,std::memory_order_release);
+
+    pushing.store(false);
+    return true;
+}
+
+//--------------------------------------------------------------
+size_t AudioFileWriter::getQueueDepth() const{
+    if(numChannels <= 0){
+        return 0;
+    }
+    return static_cast<size_t>((samplesHead.load()-samplesTail.load())/static_cast<uint64_t>(numChannels));
+}
+
+//--------------------------------------------------------------
+bool AudioFileWriter::drain(){
+    uint64_t bt = blocksTail.load(std::memory_order_relaxed);
+    uint64_t bh = blocksHead.load(std::memory_order_acquire);
+    if(bt == bh){
+        return false;
+    }
+
+    for(;bt<bh;bt++){
+        Block block = blocks[bt % blocks.size()];
+
+        // frames dropped on overrun before this block
+        if(block.startFrame > framesWritten.load()){
+            writeSilence(block.startFrame-framesWritten.load());
+        }
+
+        uint64_t st = samplesTail.load(std::memory_order_relaxed);
+        size_t count = block.numFrames*static_cast<size_t>(numChannels);
+        size_t capacity = samples.size();
+        for(size_t i=0;i<count;i++){
+            scratch[i] = samples[(st+i) % capacity];
+        }
+        samplesTail.store(st+count,std::memory_order_release);
+        blocksTail.store(bt+1,std::memory_order_release);
+
+        write(scratch.data(),block.numFrames);
+    }
+    return true;
+}
+
+//--------------------------------------------------------------
+void AudioFileWriter::write(const float *interleaved, size_t numFrames){
+    if(callback){
+        callback(interleaved,numFrames,numChannels);
+    }else if(file.is_open()){
+        file.write(reinterpret_cast<const char*>(interleaved),static_cast<std::streamsize>(numFrames*static_cast<size_t>(numChannels)*sizeof(float)));
+    }
+    framesWritten.fetch_add(numFrames);
+}
+
+//--------------------------------------------------------------
+void AudioFileWriter::writeSilence(uint64_t numFrames){
+    vector<float> silence(static_cast<size_t>(std::min<uint64_t>(numFrames,static_cast<uint64_t>(sampleRate)))*static_cast<size_t>(numChannels),0.0f);
+    while(numFrames > 0){
+        size_t n = static_cast<size_t>(std::min<uint64_t>(numFrames,static_cast<uint64_t>(sampleRate)));
+        write(silence.data(),n);
+        numFrames -= n;
+    }
+}
+
+//--------------------------------------------------------------
+void AudioFileWriter::finalizeFile(){
+    uint64_t dataBytes = framesWritten.load()*static_cast<uint64_t>(numChannels)*4;
+    uint64_t riffBytes = 4 + (8+28) + (8+16) + (8+dataBytes);
+    uint32_t u32;
+
+    if(riffBytes <= 0xFFFFFFFFull){
+        u32 = static_cast<uint32_t>(riffBytes);
+        file.seekp(4);
+        file.write(reinterpret_cast<char*>(&u32),4);
+        u32 = static_cast<uint32_t>(dataBytes);
+        file.seekp(12+(8+28)+(8+16)+4);
+        file.write(reinterpret_cast<char*>(&u32),4);
+    }else{
+        // RF64: 32 bit sizes set to -1, the real ones in the ds64 chunk
+        uint64_t sampleCount = framesWritten.load();
+        uint32_t tableLength = 0;
+        u32 = 0xFFFFFFFF;
+        file.seekp(0);
+        file.write("RF64",4);
+        file.write(reinterpret_cast<char*>(&u32),4);
+        file.seekp(12);
+        file.write("ds64",4);
+        file.seekp(20);
+        file.write(reinterpret_cast<char*>(&riffBytes),8);
+        file.write(reinterpret_cast<char*>(&dataBytes),8);
+        file.write(reinterpret_cast<char*>(&sampleCount),8);
+        file.write(reinterpret_cast<char*>(&tableLength),4);
+        file.seekp(12+(8+28)+(8+16)+4);
+        file.write(reinterpret_cast<char*>(&u32),4);
+    }
+}
+
+//--------------------------------------------------------------
+void AudioFileWriter::threadedFunction(){
+    while(isThreadRunning()){
+        if(!drain()){
+            std::this_thread::sleep_for(std::chrono::microseconds(2000));
+        }
+    }
+}
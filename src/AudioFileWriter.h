@@ -0,0 +1,105 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+#define WRITER_RING_SECONDS     8       // audio held by the ring before overruns
+#define WRITER_RING_BLOCKS      2048    // audio buffers held by the ring
+
+// Audio recorder decoupled from the audio thread. push() only copies the buffer into
+// a preallocated single producer / single consumer ring, a writer thread drains it to
+// a 32 bit float WAV file (promoted to RF64 above 4 GB) or to a callback (i.e. an encoder).
+// Every block carries its first frame index, so frames dropped on overrun become silence
+// in the file and the recording timeline stays sample accurate.
+class AudioFileWriter : public ofThread {
+
+public:
+
+    typedef std::function<void(const float *interleaved, size_t numFrames, int numChannels)> BlockCallback;
+
+    AudioFileWriter();
+    ~AudioFileWriter();
+
+    // main thread
+    bool            startFile(const string &path, int sampleRate, int numChannels);
+    bool            startCallback(int sampleRate, int numChannels, BlockCallback callback);
+    void            stop();
+
+    // audio thread
+    bool            push(const ofSoundBuffer &buffer);
+
+    bool            isRecording() const { return recording.load(); }
+    int             getSampleRate() const { return sampleRate; }
+    int             getNumChannels() const { return numChannels; }
+    uint64_t        getOverruns() const { return overruns.load(); }
+    size_t          getQueueDepth() const;                          // frames waiting for the writer
+    uint64_t        getFramesWritten() const { return framesWritten.load(); }
+
+protected:
+
+    struct Block{
+        uint64_t    startFrame;
+        size_t      numFrames;
+    };
+
+    bool                    start(int sampleRate, int numChannels);
+    void                    threadedFunction();
+    bool                    drain();
+    void                    write(const float *interleaved, size_t numFrames);
+    void                    writeSilence(uint64_t numFrames);
+    void                    finalizeFile();
+
+    int                     sampleRate;
+    int                     numChannels;
+
+    // ring, samples and blocks headers
+    vector<float>           samples;
+    vector<Block>           blocks;
+    std::atomic<uint64_t>   samplesHead;
+    std::atomic<uint64_t>   samplesTail;
+    std::atomic<uint64_t>   blocksHead;
+    std::atomic<uint64_t>   blocksTail;
+
+    std::atomic<bool>       recording;
+    std::atomic<bool>       pushing;
+    std::atomic<uint64_t>   overruns;
+    uint64_t                framesIn;
+    std::atomic<uint64_t>   framesWritten;
+
+    // writer thread
+    vector<float>           scratch;
+    std::ofstream           file;
+    BlockCallback           callback;
+
+};
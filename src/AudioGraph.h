@@ -0,0 +1,115 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+class PatchObject;
+
+// Immutable audio graph: the audio nodes the sound stream runs, in execution order
+struct AudioGraphSnapshot{
+    vector<PatchObject*>    inNodes;
+    vector<PatchObject*>    outNodes;
+};
+
+// Read-copy-update publication of the audio graph. The main thread builds a new snapshot
+// and swaps the pointer, the audio thread never takes a lock and never sees a half built graph.
+// The single reader (the audio callback) announces the snapshot it runs in a hazard pointer,
+// replaced snapshots are deleted by the main thread once the reader has left them.
+class AudioGraph{
+
+public:
+
+    AudioGraph() : current(new AudioGraphSnapshot()), reading(nullptr) {}
+
+    ~AudioGraph(){
+        for(size_t i=0;i<retired.size();i++){
+            delete retired.at(i);
+        }
+        delete current.load();
+    }
+
+    // main thread
+    void publish(AudioGraphSnapshot *snapshot){
+        retired.push_back(current.exchange(snapshot));
+        reclaim();
+    }
+
+    // frees the replaced snapshots the audio thread is not running
+    void reclaim(){
+        AudioGraphSnapshot *inUse = reading.load();
+        for(size_t i=0;i<retired.size();){
+            if(retired.at(i) != inUse){
+                delete retired.at(i);
+                retired.erase(retired.begin()+i);
+            }else{
+                i++;
+            }
+        }
+    }
+
+    // waits for the audio thread to leave the replaced snapshots, after this the objects
+    // that are not in the current snapshot can be safely torn down
+    void synchronize(){
+        while(!retired.empty()){
+            reclaim();
+            if(!retired.empty()){
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // audio thread, acquire and release around every buffer
+    const AudioGraphSnapshot* acquire(){
+        AudioGraphSnapshot *snapshot = current.load();
+        for(;;){
+            reading.store(snapshot);
+            AudioGraphSnapshot *check = current.load();
+            if(check == snapshot){
+                return snapshot;
+            }
+            snapshot = check;
+        }
+    }
+
+    void release(){
+        reading.store(nullptr);
+    }
+
+private:
+
+    std::atomic<AudioGraphSnapshot*>    current;
+    std::atomic<AudioGraphSnapshot*>    reading;
+    vector<AudioGraphSnapshot*>         retired;
+
+};
@@ -0,0 +1,211 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "ControlThread.h"
+#include "PatchClock.h"
+
+// set while this thread fires the wheel timers, a callback canceling a timer must not wait for itself
+static thread_local bool firingTimers = false;
+
+//--------------------------------------------------------------
+ControlThread::ControlThread(){
+    wheel.resize(CONTROL_WHEEL_SIZE);
+    currentTick = 0;
+}
+
+//--------------------------------------------------------------
+void ControlThread::setup(){
+    currentTick = PatchClock::getInstance().getElapsedTimeMillis();
+    if(!isThreadRunning()){
+        startThread();
+    }
+}
+
+//--------------------------------------------------------------
+void ControlThread::stop(){
+    if(isThreadRunning()){
+        stopThread();
+        waitForThread(false);
+    }
+}
+
+//--------------------------------------------------------------
+ControlThread::TimerHandle ControlThread::schedule(uint64_t delayMs, std::function<void()> callback){
+    return addTimer(delayMs,0,callback);
+}
+
+//--------------------------------------------------------------
+ControlThread::TimerHandle ControlThread::scheduleRepeating(uint64_t periodMs, std::function<void()> callback){
+    return addTimer(periodMs,periodMs > 0 ? periodMs : 1,callback);
+}
+
+//--------------------------------------------------------------
+void ControlThread::cancel(TimerHandle &timer){
+    if(timer){
+        *timer = false;
+        timer.reset();
+    }
+}
+
+//--------------------------------------------------------------
+void ControlThread::cancelAndWait(TimerHandle &timer){
+    cancel(timer);
+    if(!firingTimers){
+        // the callbacks run with the wheel locked, the next tick skips the canceled timer
+        std::unique_lock<std::mutex> lock(wheelMutex);
+    }
+}
+
+//--------------------------------------------------------------
+ControlThread::TimerHandle ControlThread::addTimer(uint64_t delayMs, uint64_t periodMs, std::function<void()> callback){
+    Timer timer;
+    timer.deadline  = currentTick + (delayMs > 0 ? delayMs : 1);
+    timer.period    = periodMs;
+    timer.callback  = callback;
+    timer.alive     = make_shared<std::atomic<bool>>(true);
+
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    pendingTimers.push_back(timer);
+    return timer.alive;
+}
+
+//--------------------------------------------------------------
+void ControlThread::insertTimer(Timer &timer){
+    // late timers fire on the next tick
+    if(timer.deadline < currentTick){
+        timer.deadline = currentTick;
+    }
+    wheel[timer.deadline % CONTROL_WHEEL_SIZE].push_back(timer);
+}
+
+//--------------------------------------------------------------
+void ControlThread::rebase(uint64_t timeMs, vector<Timer> &timers){
+    for(size_t s=0;s<wheel.size();s++){
+        timers.insert(timers.end(),wheel.at(s).begin(),wheel.at(s).end());
+        wheel.at(s).clear();
+    }
+    for(size_t i=0;i<timers.size();i++){
+        uint64_t remaining = timers.at(i).deadline > currentTick ? timers.at(i).deadline - currentTick : 0;
+        timers.at(i).deadline = timeMs + remaining;
+    }
+    currentTick = timeMs;
+}
+
+//--------------------------------------------------------------
+void ControlThread::advanceTo(uint64_t timeMs){
+    std::unique_lock<std::mutex> lock(wheelMutex);
+    firingTimers = true;
+
+    vector<Timer> tempTimers;
+    {
+        std::unique_lock<std::mutex> pendingLock(pendingMutex);
+        tempTimers.swap(pendingTimers);
+    }
+
+    // the time jumped (clock mode switch, long stall), move the schedule instead of replaying it
+    if(timeMs + 1 < currentTick || timeMs > currentTick + CONTROL_WHEEL_SIZE){
+        rebase(timeMs,tempTimers);
+    }
+
+    for(size_t i=0;i<tempTimers.size();i++){
+        insertTimer(tempTimers.at(i));
+    }
+
+    vector<Timer> repeating;
+    while(currentTick <= timeMs){
+        vector<Timer> &slot = wheel[currentTick % CONTROL_WHEEL_SIZE];
+        for(size_t i=0;i<slot.size();){
+            Timer &timer = slot.at(i);
+            if(!*timer.alive){
+                slot.erase(slot.begin()+i);
+            }else if(timer.deadline == currentTick){
+                timer.callback();
+                if(timer.period > 0){
+                    timer.deadline += timer.period;
+                    repeating.push_back(timer);
+                }
+                slot.erase(slot.begin()+i);
+            }else{
+                // a later round of the wheel
+                i++;
+            }
+        }
+        for(size_t i=0;i<repeating.size();i++){
+            wheel[repeating.at(i).deadline % CONTROL_WHEEL_SIZE].push_back(repeating.at(i));
+        }
+        repeating.clear();
+        currentTick++;
+    }
+    firingTimers = false;
+}
+
+//--------------------------------------------------------------
+void ControlThread::threadedFunction(){
+    while(isThreadRunning()){
+        if(!PatchClock::getInstance().isFixedStep()){
+            advanceTo(PatchClock::getInstance().getElapsedTimeMillis());
+        }
+        // wake up every ms, sleep_for is more precise than ofThread::sleep on most systems
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+}
+
+//--------------------------------------------------------------
+void ControlOutputQueue::start(){
+    std::unique_lock<std::mutex> lock(mutex);
+    if(!timer){
+        timer = ControlThread::getInstance().scheduleRepeating(1,[this](){ service(ControlThread::getInstance().getCurrentTime()); });
+    }
+}
+
+//--------------------------------------------------------------
+void ControlOutputQueue::stop(){
+    // returns once no service() runs anymore, the queue can be destroyed after it
+    ControlThread::getInstance().cancelAndWait(timer);
+    std::unique_lock<std::mutex> lock(mutex);
+    pending.clear();
+}
+
+//--------------------------------------------------------------
+void ControlOutputQueue::push(uint64_t time, std::function<void()> send){
+    std::unique_lock<std::mutex> lock(mutex);
+    pending.insert(std::make_pair(time/1000 + CONTROL_OUTPUT_LATENCY,send));
+}
+
+//--------------------------------------------------------------
+void ControlOutputQueue::service(uint64_t timeMs){
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!pending.empty() && pending.begin()->first <= timeMs){
+        pending.begin()->second();
+        pending.erase(pending.begin());
+    }
+}
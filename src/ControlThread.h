@@ -0,0 +1,170 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+#define CONTROL_WHEEL_SIZE      1024    // timer wheel slots, 1 ms each
+#define CONTROL_MAILBOX_SIZE    256     // events buffered between two render frames
+#define CONTROL_OUTPUT_LATENCY  40      // ms from an event time to its send on the control thread
+
+// Lock-free hand off of timestamped control events (bangs) from the control thread
+// to the render thread: single producer, single consumer ring
+class ControlMailbox{
+
+public:
+
+    ControlMailbox(){ head = 0; tail = 0; }
+
+    // control thread, the event is dropped if the render thread is more than CONTROL_MAILBOX_SIZE events late
+    void post(uint64_t time){
+        size_t h = head.load(std::memory_order_relaxed);
+        if(h - tail.load(std::memory_order_acquire) < CONTROL_MAILBOX_SIZE){
+            times[h % CONTROL_MAILBOX_SIZE] = time;
+            head.store(h+1,std::memory_order_release);
+        }
+    }
+
+    // render thread, events posted since the last take, oldest first
+    int take(vector<uint64_t> &eventsTimes){
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+        for(size_t i=t;i<h;i++){
+            eventsTimes.push_back(times[i % CONTROL_MAILBOX_SIZE]);
+        }
+        tail.store(h,std::memory_order_release);
+        return static_cast<int>(h-t);
+    }
+
+protected:
+
+    uint64_t                times[CONTROL_MAILBOX_SIZE];
+    std::atomic<size_t>     head;
+    std::atomic<size_t>     tail;
+
+};
+
+// Control rate thread: runs the timing objects schedules on a 1 kHz timer wheel,
+// independent from the render frame rate. Timers fire on the control thread, so
+// their callbacks must only touch atomics (i.e. post to a ControlMailbox).
+// In PatchClock fixed step mode the wheel is advanced from the render thread
+// with the virtual time instead, so offline renders stay deterministic.
+class ControlThread : public ofThread {
+
+public:
+
+    // cleared on cancel, the wheel drops the timer when it comes up
+    typedef shared_ptr<std::atomic<bool>>   TimerHandle;
+
+    static ControlThread& getInstance(){
+        static ControlThread instance;
+        return instance;
+    }
+
+    ~ControlThread(){
+        stop();
+    }
+
+    void            setup();
+    void            stop();
+
+    // thread safe, callbacks run on the control thread
+    TimerHandle     schedule(uint64_t delayMs, std::function<void()> callback);
+    // rescheduled from its own deadline, so a periodic timer never drifts
+    TimerHandle     scheduleRepeating(uint64_t periodMs, std::function<void()> callback);
+    static void     cancel(TimerHandle &timer);
+    // cancel, then wait for a callback of the timer already running on the control thread (if any),
+    // so the objects its callback captured can be destroyed once it returns
+    void            cancelAndWait(TimerHandle &timer);
+
+    // fire every timer due up to timeMs (patch time)
+    void            advanceTo(uint64_t timeMs);
+
+    uint64_t        getCurrentTime() const { return currentTick; }
+
+protected:
+
+    struct Timer{
+        uint64_t                deadline;
+        uint64_t                period;
+        std::function<void()>   callback;
+        TimerHandle             alive;
+    };
+
+    ControlThread();
+
+    void                    threadedFunction();
+    TimerHandle             addTimer(uint64_t delayMs, uint64_t periodMs, std::function<void()> callback);
+    void                    insertTimer(Timer &timer);
+    void                    rebase(uint64_t timeMs, vector<Timer> &timers);
+
+    std::mutex              wheelMutex;
+    vector<vector<Timer>>   wheel;
+    std::atomic<uint64_t>   currentTick;
+
+    // timers scheduled from other threads, moved into the wheel at the next tick
+    std::mutex              pendingMutex;
+    vector<Timer>           pendingTimers;
+
+};
+
+// Sends of the output objects (midi, osc), run on the control thread at their event time
+// plus CONTROL_OUTPUT_LATENCY. Events reach the senders at render frame rate, the constant
+// latency absorbs that quantization, so the sends keep the spacing of the timers that made
+// the events (as long as a frame takes less than the latency). Sends are serialized
+// with the output reconfiguration through getMutex().
+class ControlOutputQueue{
+
+public:
+
+    ControlOutputQueue(){}
+    ~ControlOutputQueue(){ stop(); }
+
+    void            start();
+    void            stop();
+
+    // render thread, time in patch clock microseconds (PatchEvent::time)
+    void            push(uint64_t time, std::function<void()> send);
+
+    // hold it while changing the output (port, host), no send runs meanwhile
+    std::mutex&     getMutex() { return mutex; }
+
+protected:
+
+    void            service(uint64_t timeMs);
+
+    std::mutex                                  mutex;
+    multimap<uint64_t,std::function<void()>>    pending;    // by due time (ms), same time in push order
+    ControlThread::TimerHandle                  timer;
+
+};
@@ -0,0 +1,130 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class PatchObject;
+
+// Object capabilities, declared once at registration
+enum OBJECT_CAPABILITY {
+    VP_OBJECT_GL            = 1 << 0,   // uses the GL context: main thread only, not available headless
+    VP_OBJECT_AUDIO_IN      = 1 << 1,   // receives the audio input buffer on the sound stream thread
+    VP_OBJECT_AUDIO_OUT     = 1 << 2,   // fills audio output on the sound stream thread
+    VP_OBJECT_GUI           = 1 << 3    // builds an ofxDatGui: main thread only, not available headless
+};
+
+struct ObjectFactoryEntry{
+    std::string                     name;
+    std::string                     category;   // empty category: not listed in the objects menu
+    int                             capabilities;
+    std::function<PatchObject*()>   create;
+
+    bool usesGL() const { return (capabilities & VP_OBJECT_GL) != 0; }
+    bool usesAudio() const { return (capabilities & (VP_OBJECT_AUDIO_IN | VP_OBJECT_AUDIO_OUT)) != 0; }
+    // GL or GUI: updated on the main thread, needs a GL context to be created
+    bool isMainThreadOnly() const { return (capabilities & (VP_OBJECT_GL | VP_OBJECT_GUI)) != 0; }
+};
+
+// Registry of the patch objects, filled at static init time by every object class
+// with OBJECT_REGISTER, so creating an object by name is a single hash lookup
+class ObjectFactory{
+
+public:
+
+    static ObjectFactory& getInstance(){
+        // constructed on first use, safe to call from other static initializers
+        static ObjectFactory instance;
+        return instance;
+    }
+
+    bool registerObject(const std::string &name, const std::string &category, int capabilities, std::function<PatchObject*()> create){
+        ObjectFactoryEntry entry;
+        entry.name          = name;
+        entry.category      = category;
+        entry.capabilities  = capabilities;
+        entry.create        = create;
+        return entries.insert(std::make_pair(name,entry)).second;
+    }
+
+    PatchObject* create(const std::string &name) const{
+        std::unordered_map<std::string,ObjectFactoryEntry>::const_iterator it = entries.find(name);
+        if(it != entries.end()){
+            return it->second.create();
+        }
+        return nullptr;
+    }
+
+    bool exists(const std::string &name) const{
+        return entries.find(name) != entries.end();
+    }
+
+    const ObjectFactoryEntry* getEntry(const std::string &name) const{
+        std::unordered_map<std::string,ObjectFactoryEntry>::const_iterator it = entries.find(name);
+        if(it != entries.end()){
+            return &it->second;
+        }
+        return nullptr;
+    }
+
+    // menu listing: category -> sorted object names
+    std::map<std::string,std::vector<std::string>> getCategories() const{
+        std::map<std::string,std::vector<std::string>> categories;
+        for(std::unordered_map<std::string,ObjectFactoryEntry>::const_iterator it = entries.begin(); it != entries.end(); it++ ){
+            if(it->second.category != ""){
+                categories[it->second.category].push_back(it->first);
+            }
+        }
+        for(std::map<std::string,std::vector<std::string>>::iterator it = categories.begin(); it != categories.end(); it++ ){
+            std::sort(it->second.begin(),it->second.end());
+        }
+        return categories;
+    }
+
+    size_t size() const { return entries.size(); }
+
+private:
+
+    ObjectFactory(){}
+
+    std::unordered_map<std::string,ObjectFactoryEntry> entries;
+
+};
+
+#define OBJECT_REGISTER(CLASS,NAME,CATEGORY,CAPABILITIES) \
+    static bool CLASS##_registered = ObjectFactory::getInstance().registerObject(NAME,CATEGORY,CAPABILITIES,[](){ PatchObject *object = new CLASS(); object->setCapabilities(CAPABILITIES); return object; });
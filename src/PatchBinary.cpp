@@ -0,0 +1,390 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "PatchBinary.h"
+
+#if defined(TARGET_LINUX) || defined(TARGET_OSX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//--------------------------------------------------------------
+// string pool used while writing, every distinct string stored once
+struct PatchBinaryStrings{
+    string                          data;
+    map<string,uint32_t>            index;
+
+    uint32_t add(const string &s){
+        map<string,uint32_t>::iterator it = index.find(s);
+        if(it != index.end()){
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(data.size());
+        data.append(s);
+        data.push_back('\0');
+        index[s] = offset;
+        return offset;
+    }
+};
+
+//--------------------------------------------------------------
+static string getChildText(TiXmlElement *el, const char *name){
+    TiXmlElement *child = el->FirstChildElement(name);
+    if(child != nullptr && child->GetText() != nullptr){
+        return child->GetText();
+    }
+    return "";
+}
+
+//--------------------------------------------------------------
+static void writeNodes(TiXmlElement *el, uint32_t depth, vector<PatchBinary::Node> &nodes, PatchBinaryStrings &strings){
+    PatchBinary::Node node;
+    node.name           = strings.add(el->Value());
+    node.text           = el->GetText() != nullptr ? strings.add(el->GetText()) : PatchBinary::NO_STRING;
+    node.depth          = depth;
+    node.numChildren    = 0;
+
+    size_t nodeIndex = nodes.size();
+    nodes.push_back(node);
+
+    for(TiXmlElement *child = el->FirstChildElement(); child != nullptr; child = child->NextSiblingElement()){
+        nodes.at(nodeIndex).numChildren++;
+        writeNodes(child,depth+1,nodes,strings);
+    }
+}
+
+//--------------------------------------------------------------
+PatchBinary::PatchBinary(){
+    data        = nullptr;
+    dataSize    = 0;
+    mapped      = false;
+
+    header      = nullptr;
+    nodes       = nullptr;
+    objects     = nullptr;
+    links       = nullptr;
+    strings     = nullptr;
+}
+
+//--------------------------------------------------------------
+PatchBinary::~PatchBinary(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool PatchBinary::open(const string &file){
+    close();
+
+    string path = ofToDataPath(file,true);
+
+#if defined(TARGET_LINUX) || defined(TARGET_OSX)
+    int fd = ::open(path.c_str(),O_RDONLY);
+    if(fd < 0){
+        ofLog(OF_LOG_ERROR,"Binary patch: can't open %s",path.c_str());
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd,&st) == 0 && st.st_size > 0){
+        void *ptr = mmap(nullptr,static_cast<size_t>(st.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+        if(ptr != MAP_FAILED){
+            data        = static_cast<const char *>(ptr);
+            dataSize    = static_cast<size_t>(st.st_size);
+            mapped      = true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if(!mapped){
+        ifstream in(path.c_str(), ios::in | ios::binary);
+        if(!in.is_open()){
+            ofLog(OF_LOG_ERROR,"Binary patch: can't open %s",path.c_str());
+            return false;
+        }
+        fileBuffer.assign(istreambuf_iterator<char>(in),istreambuf_iterator<char>());
+        data        = fileBuffer.data();
+        dataSize    = fileBuffer.size();
+    }
+
+    if(!validate()){
+        ofLog(OF_LOG_ERROR,"Binary patch: %s is not a valid binary patch",path.c_str());
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------
+void PatchBinary::close(){
+#if defined(TARGET_LINUX) || defined(TARGET_OSX)
+    if(mapped && data != nullptr){
+        munmap(const_cast<char *>(data),dataSize);
+    }
+#endif
+    fileBuffer.clear();
+    data        = nullptr;
+    dataSize    = 0;
+    mapped      = false;
+
+    header      = nullptr;
+    nodes       = nullptr;
+    objects     = nullptr;
+    links       = nullptr;
+    strings     = nullptr;
+}
+
+//--------------------------------------------------------------
+bool PatchBinary::validate(){
+    if(data == nullptr || dataSize < sizeof(Header)){
+        return false;
+    }
+    const Header *h = reinterpret_cast<const Header *>(data);
+    if(memcmp(h->magic,PATCH_BINARY_MAGIC,4) != 0 || h->version != PATCH_BINARY_VERSION){
+        return false;
+    }
+
+    // every table must be aligned and fit in the file
+    uint64_t nodesEnd   = static_cast<uint64_t>(h->nodesOffset) + static_cast<uint64_t>(h->numNodes)*sizeof(Node);
+    uint64_t objectsEnd = static_cast<uint64_t>(h->objectsOffset) + static_cast<uint64_t>(h->numObjects)*sizeof(Object);
+    uint64_t linksEnd   = static_cast<uint64_t>(h->linksOffset) + static_cast<uint64_t>(h->numLinks)*sizeof(Link);
+    uint64_t stringsEnd = static_cast<uint64_t>(h->stringsOffset) + static_cast<uint64_t>(h->stringsSize);
+    if(nodesEnd > dataSize || objectsEnd > dataSize || linksEnd > dataSize || stringsEnd > dataSize){
+        return false;
+    }
+    if(h->nodesOffset % 4 != 0 || h->objectsOffset % 4 != 0 || h->linksOffset % 4 != 0){
+        return false;
+    }
+    if(h->stringsSize == 0 || data[h->stringsOffset + h->stringsSize - 1] != '\0'){
+        return false;
+    }
+
+    header      = h;
+    nodes       = reinterpret_cast<const Node *>(data + h->nodesOffset);
+    objects     = reinterpret_cast<const Object *>(data + h->objectsOffset);
+    links       = reinterpret_cast<const Link *>(data + h->linksOffset);
+    strings     = data + h->stringsOffset;
+
+    // the node depths must describe a tree
+    for(uint32_t i=0;i<h->numNodes;i++){
+        if((i == 0 && nodes[i].depth != 0) || (i > 0 && nodes[i].depth > nodes[i-1].depth+1)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------
+uint32_t PatchBinary::getNextSibling(uint32_t node) const{
+    // skip the subtree: the next node at the same depth or above
+    uint32_t next = node+1;
+    while(next < header->numNodes && nodes[next].depth > nodes[node].depth){
+        next++;
+    }
+    if(next < header->numNodes && nodes[next].depth == nodes[node].depth){
+        return next;
+    }
+    return NO_NODE;
+}
+
+//--------------------------------------------------------------
+uint32_t PatchBinary::findChild(uint32_t node, const char *name, int which) const{
+    if(!isOpen() || node >= header->numNodes || nodes[node].numChildren == 0){
+        return NO_NODE;
+    }
+    for(uint32_t child = node+1; child != NO_NODE; child = getNextSibling(child)){
+        if(strcmp(getString(nodes[child].name),name) == 0 && which-- == 0){
+            return child;
+        }
+    }
+    return NO_NODE;
+}
+
+//--------------------------------------------------------------
+uint32_t PatchBinary::findRoot(const char *name) const{
+    for(uint32_t node = 0; node < getNumNodes() && node != NO_NODE; node = getNextSibling(node)){
+        if(strcmp(getString(nodes[node].name),name) == 0){
+            return node;
+        }
+    }
+    return NO_NODE;
+}
+
+//--------------------------------------------------------------
+int PatchBinary::getNumChildren(uint32_t node, const char *name) const{
+    int count = 0;
+    if(!isOpen() || node >= header->numNodes || nodes[node].numChildren == 0){
+        return count;
+    }
+    for(uint32_t child = node+1; child != NO_NODE; child = getNextSibling(child)){
+        if(strcmp(getString(nodes[child].name),name) == 0){
+            count++;
+        }
+    }
+    return count;
+}
+
+//--------------------------------------------------------------
+string PatchBinary::getValue(uint32_t node, const string &path, const string &defaultValue) const{
+    vector<string> names = ofSplitString(path,":");
+    for(size_t i=0;i<names.size() && node != NO_NODE;i++){
+        node = findChild(node,names[i].c_str());
+    }
+    if(node == NO_NODE || nodes[node].text == NO_STRING){
+        return defaultValue;
+    }
+    return getString(nodes[node].text);
+}
+
+//--------------------------------------------------------------
+bool PatchBinary::toXml(ofxXmlSettings &XML) const{
+    if(!isOpen()){
+        return false;
+    }
+
+    XML.clear();
+
+    vector<TiXmlNode*> parents;
+    for(uint32_t i=0;i<header->numNodes;i++){
+        const Node &node = nodes[i];
+        TiXmlNode *parent = node.depth == 0 ? static_cast<TiXmlNode *>(&XML.doc) : parents.at(node.depth-1);
+
+        TiXmlElement *el = new TiXmlElement(getString(node.name));
+        if(node.text != NO_STRING){
+            el->LinkEndChild(new TiXmlText(getString(node.text)));
+        }
+        parent->LinkEndChild(el);
+
+        parents.resize(node.depth+1);
+        parents.at(node.depth) = el;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------
+bool PatchBinary::save(const string &file, ofxXmlSettings &XML){
+    PatchBinaryStrings  tempStrings;
+    vector<Node>        tempNodes;
+    vector<Object>      tempObjects;
+    vector<Link>        tempLinks;
+
+    tempStrings.add("");
+
+    for(TiXmlElement *el = XML.doc.FirstChildElement(); el != nullptr; el = el->NextSiblingElement()){
+        uint32_t nodeIndex = static_cast<uint32_t>(tempNodes.size());
+        writeNodes(el,0,tempNodes,tempStrings);
+
+        if(string(el->Value()) != "object"){
+            continue;
+        }
+
+        // objects and links tables
+        Object obj;
+        obj.id      = ofToInt(getChildText(el,"id"));
+        obj.name    = tempStrings.add(getChildText(el,"name"));
+        obj.node    = nodeIndex;
+        obj.x       = 0;
+        obj.y       = 0;
+        TiXmlElement *position = el->FirstChildElement("position");
+        if(position != nullptr){
+            obj.x   = ofToFloat(getChildText(position,"x"));
+            obj.y   = ofToFloat(getChildText(position,"y"));
+        }
+        tempObjects.push_back(obj);
+
+        TiXmlElement *outlets = el->FirstChildElement("outlets");
+        if(outlets != nullptr){
+            int outlet = 0;
+            for(TiXmlElement *link = outlets->FirstChildElement("link"); link != nullptr; link = link->NextSiblingElement("link"), outlet++){
+                for(TiXmlElement *to = link->FirstChildElement("to"); to != nullptr; to = to->NextSiblingElement("to")){
+                    Link l;
+                    l.fromObjectID  = obj.id;
+                    l.fromOutletID  = outlet;
+                    l.toObjectID    = ofToInt(getChildText(to,"id"));
+                    l.toInletID     = ofToInt(getChildText(to,"inlet"));
+                    l.type          = ofToInt(getChildText(link,"type"));
+                    tempLinks.push_back(l);
+                }
+            }
+        }
+    }
+
+    Header h;
+    memcpy(h.magic,PATCH_BINARY_MAGIC,4);
+    h.version       = PATCH_BINARY_VERSION;
+    h.numNodes      = static_cast<uint32_t>(tempNodes.size());
+    h.numObjects    = static_cast<uint32_t>(tempObjects.size());
+    h.numLinks      = static_cast<uint32_t>(tempLinks.size());
+    h.stringsSize   = static_cast<uint32_t>(tempStrings.data.size());
+    h.nodesOffset   = sizeof(Header);
+    h.objectsOffset = h.nodesOffset + h.numNodes*sizeof(Node);
+    h.linksOffset   = h.objectsOffset + h.numObjects*sizeof(Object);
+    h.stringsOffset = h.linksOffset + h.numLinks*sizeof(Link);
+
+    string path = ofToDataPath(file,true);
+    string tempPath = path+".tmp";
+    {
+        ofstream out(tempPath.c_str(), ios::out | ios::trunc | ios::binary);
+        if(!out.is_open()){
+            ofLog(OF_LOG_ERROR,"Binary patch: can't write %s",tempPath.c_str());
+            return false;
+        }
+        out.write(reinterpret_cast<const char *>(&h),sizeof(Header));
+        out.write(reinterpret_cast<const char *>(tempNodes.data()),tempNodes.size()*sizeof(Node));
+        out.write(reinterpret_cast<const char *>(tempObjects.data()),tempObjects.size()*sizeof(Object));
+        out.write(reinterpret_cast<const char *>(tempLinks.data()),tempLinks.size()*sizeof(Link));
+        out.write(tempStrings.data.data(),tempStrings.data.size());
+        out.close();
+        if(out.fail()){
+            ofLog(OF_LOG_ERROR,"Binary patch: error writing %s",tempPath.c_str());
+            return false;
+        }
+    }
+#ifdef TARGET_WIN32
+    std::remove(path.c_str());
+#endif
+    return std::rename(tempPath.c_str(),path.c_str()) == 0;
+}
+
+//--------------------------------------------------------------
+bool PatchBinary::isBinaryPatch(const string &file){
+    ifstream in(ofToDataPath(file,true).c_str(), ios::in | ios::binary);
+    char magic[4];
+    if(!in.is_open() || !in.read(magic,4)){
+        return false;
+    }
+    return memcmp(magic,PATCH_BINARY_MAGIC,4) == 0;
+}
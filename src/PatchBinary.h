@@ -0,0 +1,136 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxXmlSettings.h"
+
+#define PATCH_BINARY_MAGIC      "VPB1"
+#define PATCH_BINARY_VERSION    1
+#define PATCH_BINARY_EXTENSION  "vpb"
+
+// Compact binary patch format: the whole XML tree as a flat pre-order node table, plus a flat object table
+// and a link table indexing it, all strings in a single pool. The file is memory mapped (linux/osx) and
+// read in place, no parsing: the objects are configured from their own node subtree.
+// Conversion from/to the XML patch format keeps the elements and their text, in order; attributes and
+// comments are dropped (the patch files don't use them).
+//
+// File layout:  Header | nodes | objects | links | string pool
+class PatchBinary {
+
+public:
+
+    struct Header{
+        char        magic[4];
+        uint32_t    version;
+        uint32_t    numNodes;
+        uint32_t    numObjects;
+        uint32_t    numLinks;
+        uint32_t    stringsSize;
+        uint32_t    nodesOffset;
+        uint32_t    objectsOffset;
+        uint32_t    linksOffset;
+        uint32_t    stringsOffset;
+    };
+
+    // XML element, in document order
+    struct Node{
+        uint32_t    name;       // string pool offset
+        uint32_t    text;       // string pool offset, NO_STRING for elements without text
+        uint32_t    depth;      // 0 for the root elements
+        uint32_t    numChildren;
+    };
+
+    struct Object{
+        int32_t     id;
+        uint32_t    name;
+        uint32_t    node;       // <object> node index
+        float       x, y;
+    };
+
+    struct Link{
+        int32_t     fromObjectID;
+        int32_t     fromOutletID;
+        int32_t     toObjectID;
+        int32_t     toInletID;
+        int32_t     type;
+    };
+
+    static const uint32_t NO_STRING = 0xFFFFFFFF;
+    static const uint32_t NO_NODE   = 0xFFFFFFFF;
+
+    PatchBinary();
+    ~PatchBinary();
+
+    bool            open(const string &file);
+    void            close();
+    bool            isOpen() const { return header != nullptr; }
+
+    uint32_t        getNumObjects() const { return isOpen() ? header->numObjects : 0; }
+    uint32_t        getNumLinks() const { return isOpen() ? header->numLinks : 0; }
+    const Object*   getObjects() const { return objects; }
+    const Link*     getLinks() const { return links; }
+    const char*     getString(uint32_t offset) const { return offset < header->stringsSize ? strings + offset : ""; }
+
+    // node table navigation, a lookup walks only the subtree of the node it starts from
+    uint32_t        getNumNodes() const { return isOpen() ? header->numNodes : 0; }
+    uint32_t        getNextSibling(uint32_t node) const;
+    uint32_t        findChild(uint32_t node, const char *name, int which=0) const;     // NO_NODE if missing
+    uint32_t        findRoot(const char *name) const;
+    int             getNumChildren(uint32_t node, const char *name) const;
+    // text of the descendant at path ("position:x"), defaultValue if missing
+    string          getValue(uint32_t node, const string &path, const string &defaultValue) const;
+
+    // rebuild the XML patch
+    bool            toXml(ofxXmlSettings &XML) const;
+
+    // write an XML patch in binary format
+    static bool     save(const string &file, ofxXmlSettings &XML);
+    static bool     isBinaryPatch(const string &file);
+
+protected:
+
+    bool            validate();
+
+    const char          *data;
+    size_t              dataSize;
+    vector<char>        fileBuffer;     // used where memory mapping is not available
+    bool                mapped;
+
+    const Header        *header;
+    const Node          *nodes;
+    const Object        *objects;
+    const Link          *links;
+    const char          *strings;
+
+};
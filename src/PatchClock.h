@@ -0,0 +1,102 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+// Patch wide time source for the timing objects (metronome, delays, shaders time, ...).
+// Realtime mode (default) reads the wall clock, fixed step mode advances a virtual time of
+// exactly 1/fps seconds every frame, so offline renders run as fast as the CPU allows
+// and give the same result on every run.
+class PatchClock{
+
+public:
+
+    static PatchClock& getInstance(){
+        static PatchClock instance;
+        return instance;
+    }
+
+    void setRealtime(){
+        fixedStep = false;
+    }
+
+    void setFixedStep(int fps){
+        stepFPS         = fps > 0 ? fps : 1;
+        frames          = 0;
+        virtualMicros   = 0;
+        fixedStep       = true;
+    }
+
+    // once per frame, from ofxVisualProgramming::update(), before the objects update
+    void tick(){
+        if(fixedStep){
+            // computed from the frame count, no rounding accumulates over long renders
+            virtualMicros = frames * 1000000 / static_cast<uint64_t>(stepFPS);
+        }
+        frames++;
+    }
+
+    bool        isFixedStep() const { return fixedStep; }
+    int         getFixedStepFPS() const { return stepFPS; }
+    uint64_t    getFrameNum() const { return frames; }
+
+    // duration of a frame (ms): the fixed step one, or from the measured frame rate (0 until it is measured)
+    uint64_t    getFrameMillis() const {
+        if(fixedStep){
+            return 1000/static_cast<uint64_t>(stepFPS.load());
+        }
+        int fps = static_cast<int>(ofGetFrameRate());
+        return fps > 0 ? 1000/static_cast<uint64_t>(fps) : 0;
+    }
+
+    uint64_t    getElapsedTimeMicros() const { return fixedStep ? virtualMicros.load() : ofGetElapsedTimeMicros(); }
+    uint64_t    getElapsedTimeMillis() const { return fixedStep ? virtualMicros.load()/1000 : ofGetElapsedTimeMillis(); }
+    float       getElapsedTimef() const { return fixedStep ? static_cast<float>(static_cast<double>(virtualMicros.load())/1000000.0) : ofGetElapsedTimef(); }
+
+protected:
+
+    PatchClock(){
+        fixedStep       = false;
+        stepFPS         = 60;
+        frames          = 0;
+        virtualMicros   = 0;
+    }
+
+    // read from the parallel update workers and the audio thread
+    std::atomic<bool>       fixedStep;
+    std::atomic<int>        stepFPS;
+    std::atomic<uint64_t>   frames;
+    std::atomic<uint64_t>   virtualMicros;
+
+};
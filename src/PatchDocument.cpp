@@ -0,0 +1,245 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "PatchDocument.h"
+#include "PatchBinary.h"
+
+//--------------------------------------------------------------
+PatchDocument::PatchDocument(){
+    flushDelay = 500;
+}
+
+//--------------------------------------------------------------
+shared_ptr<PatchDocument::Document> PatchDocument::getDocument(const string &file){
+    string path = ofToDataPath(file,true);
+
+    shared_ptr<Document> doc;
+    std::unique_lock<std::mutex> docLock;
+    {
+        std::unique_lock<std::mutex> lock(documentsMutex);
+        map<string,shared_ptr<Document>>::iterator it = documents.find(path);
+        if(it != documents.end()){
+            return it->second;
+        }
+        // lock the new document before publishing it, so other callers wait for the first parse
+        // (it's not in the map yet, so this never waits while holding documentsMutex)
+        doc = make_shared<Document>();
+        docLock = std::unique_lock<std::mutex>(doc->mutex);
+        documents[path] = doc;
+    }
+
+    // first access, parse the file from disk
+    doc->loaded = doc->xml.loadFile(path);
+    docLock.unlock();
+
+    if(!isThreadRunning()){
+        startThread();
+    }
+
+    return doc;
+}
+
+//--------------------------------------------------------------
+PatchDocument::Access PatchDocument::access(const string &file){
+    return Access(getDocument(file));
+}
+
+//--------------------------------------------------------------
+PatchDocument::Settings PatchDocument::settings(const string &file){
+    return Settings(getDocument(file));
+}
+
+//--------------------------------------------------------------
+bool PatchDocument::load(const string &file, ofxXmlSettings &XML){
+    shared_ptr<Document> doc = getDocument(file);
+    std::unique_lock<std::mutex> lock(doc->mutex);
+
+    if(!doc->loaded){
+        return false;
+    }
+    if(!doc->bufferValid){
+        doc->xml.copyXmlToString(doc->buffer);
+        doc->bufferValid = true;
+    }
+    return XML.loadFromBuffer(doc->buffer);
+}
+
+//--------------------------------------------------------------
+bool PatchDocument::save(const string &file, ofxXmlSettings &XML){
+    shared_ptr<Document> doc = getDocument(file);
+    std::unique_lock<std::mutex> lock(doc->mutex);
+
+    XML.copyXmlToString(doc->buffer);
+    doc->loaded         = doc->xml.loadFromBuffer(doc->buffer);
+    doc->bufferValid    = doc->loaded;
+    doc->version++;
+    doc->lastEditTime   = ofGetElapsedTimeMillis();
+
+    return doc->loaded;
+}
+
+//--------------------------------------------------------------
+bool PatchDocument::load(const string &file, const PatchBinary &binary){
+    forget(file);
+
+    shared_ptr<Document> doc = getDocument(file);
+    std::unique_lock<std::mutex> lock(doc->mutex);
+
+    doc->loaded         = binary.toXml(doc->xml);
+    doc->bufferValid    = false;
+    doc->onDisk         = false;
+    doc->flushedVersion = doc->version;
+
+    return doc->loaded;
+}
+
+//--------------------------------------------------------------
+void PatchDocument::flush(const string &file){
+    string path = ofToDataPath(file,true);
+    shared_ptr<Document> doc;
+    {
+        std::unique_lock<std::mutex> lock(documentsMutex);
+        map<string,shared_ptr<Document>>::iterator it = documents.find(path);
+        if(it == documents.end()){
+            return;
+        }
+        doc = it->second;
+    }
+    flushDocument(path,doc,true);
+}
+
+//--------------------------------------------------------------
+void PatchDocument::flushAll(){
+    map<string,shared_ptr<Document>> tempDocuments;
+    {
+        std::unique_lock<std::mutex> lock(documentsMutex);
+        tempDocuments = documents;
+    }
+    for(map<string,shared_ptr<Document>>::iterator it = tempDocuments.begin(); it != tempDocuments.end(); it++ ){
+        flushDocument(it->first,it->second,true);
+    }
+}
+
+//--------------------------------------------------------------
+void PatchDocument::forget(const string &file){
+    flush(file);
+
+    std::unique_lock<std::mutex> lock(documentsMutex);
+    documents.erase(ofToDataPath(file,true));
+}
+
+//--------------------------------------------------------------
+bool PatchDocument::copyFile(const string &from, const string &to){
+    flush(from);
+    forget(to);
+    return ofFile::copyFromTo(from,to,true,true);
+}
+
+//--------------------------------------------------------------
+void PatchDocument::close(){
+    if(isThreadRunning()){
+        stopThread();
+        waitForThread(false);
+    }
+    flushAll();
+}
+
+//--------------------------------------------------------------
+bool PatchDocument::flushDocument(const string &path, shared_ptr<Document> doc, bool force){
+    // one writer at a time, the background thread and a forced flush could write the same file
+    std::unique_lock<std::mutex> writeLock(writeMutex);
+
+    string  data;
+    size_t  version;
+    {
+        std::unique_lock<std::mutex> lock(doc->mutex);
+        // documents built in memory are written on the first forced flush (copy, save as)
+        if(!doc->loaded || (doc->version == doc->flushedVersion && (doc->onDisk || !force))){
+            return false;
+        }
+        // debounce: wait for the edits to settle
+        if(!force && ofGetElapsedTimeMillis() - doc->lastEditTime < static_cast<uint64_t>(flushDelay)){
+            return false;
+        }
+        if(!doc->bufferValid){
+            doc->xml.copyXmlToString(doc->buffer);
+            doc->bufferValid = true;
+        }
+        data    = doc->buffer;
+        version = doc->version;
+    }
+
+    // write a temp file and rename it over the patch file
+    string tempPath = path+".tmp";
+    {
+        ofstream tempFile(tempPath.c_str(), ios::out | ios::trunc | ios::binary);
+        if(!tempFile.is_open()){
+            ofLog(OF_LOG_ERROR,"Patch document: can't write %s",tempPath.c_str());
+            return false;
+        }
+        tempFile << data;
+        tempFile.close();
+        if(tempFile.fail()){
+            ofLog(OF_LOG_ERROR,"Patch document: error writing %s",tempPath.c_str());
+            return false;
+        }
+    }
+#ifdef TARGET_WIN32
+    // rename doesn't replace existing files on windows
+    std::remove(path.c_str());
+#endif
+    if(std::rename(tempPath.c_str(),path.c_str()) != 0){
+        ofLog(OF_LOG_ERROR,"Patch document: can't replace %s",path.c_str());
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(doc->mutex);
+    doc->flushedVersion = version;
+    doc->onDisk         = true;
+
+    return true;
+}
+
+//--------------------------------------------------------------
+void PatchDocument::threadedFunction(){
+    while(isThreadRunning()){
+        map<string,shared_ptr<Document>> tempDocuments;
+        {
+            std::unique_lock<std::mutex> lock(documentsMutex);
+            tempDocuments = documents;
+        }
+        for(map<string,shared_ptr<Document>>::iterator it = tempDocuments.begin(); it != tempDocuments.end(); it++ ){
+            flushDocument(it->first,it->second,false);
+        }
+        sleep(50);
+    }
+}
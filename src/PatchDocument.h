@@ -0,0 +1,137 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxXmlSettings.h"
+
+class PatchBinary;
+
+// In memory patch documents: every patch XML file is parsed once and kept in memory,
+// edits are made in place and a background thread writes the edited documents back to disk,
+// once no edits happened for a while (temp file + rename, so a crash never leaves a half written patch).
+class PatchDocument : public ofThread {
+
+public:
+
+    struct Document{
+        Document() : loaded(false), bufferValid(false), onDisk(true), version(0), flushedVersion(0), lastEditTime(0) {}
+        std::mutex          mutex;
+        ofxXmlSettings      xml;
+        string              buffer;         // serialized xml, valid until the next edit
+        bool                loaded;
+        bool                bufferValid;
+        bool                onDisk;         // false for documents built in memory, never written yet
+        size_t              version;        // edits journal
+        size_t              flushedVersion;
+        uint64_t            lastEditTime;
+    };
+
+    // Scoped, locked access to the in memory document, for in place reads and edits.
+    // Not re-entrant: don't call code that opens the same document while an Access is alive.
+    class Access{
+    public:
+        Access(shared_ptr<Document> d) : doc(d), lock(d->mutex) { resetTags(); }
+        Access(Access &&other) = default;
+        ~Access(){ if(lock.owns_lock()){ resetTags(); } }
+
+        bool                isLoaded() const { return doc->loaded; }
+        ofxXmlSettings&     getXml() { return doc->xml; }
+        // journal the edit, the document will be flushed to disk after the debounce time
+        void                setDirty(){ doc->version++; doc->bufferValid = false; doc->lastEditTime = ofGetElapsedTimeMillis(); }
+
+    private:
+        void                resetTags(){ while(doc->xml.getPushLevel() > 0){ doc->xml.popTag(); } }
+
+        shared_ptr<Document>            doc;
+        std::unique_lock<std::mutex>    lock;
+    };
+
+    // Scoped, locked read of the patch <settings> block straight from the in memory document,
+    // for the objects setup (audio settings etc.), without copying and re-parsing the whole patch
+    class Settings : public Access{
+    public:
+        Settings(shared_ptr<Document> d) : Access(d) { valid = isLoaded() && getXml().pushTag("settings"); }
+        Settings(Settings &&other) = default;
+
+        bool                isValid() const { return valid; }
+
+    private:
+        bool                valid;
+    };
+
+    static PatchDocument& getInstance(){
+        static PatchDocument instance;
+        return instance;
+    }
+
+    ~PatchDocument(){
+        close();
+    }
+
+    Access      access(const string &file);
+    Settings    settings(const string &file);
+
+    // copy based api, for code needing its own ofxXmlSettings (patch loading, objects settings)
+    bool        load(const string &file, ofxXmlSettings &XML);
+    bool        save(const string &file, ofxXmlSettings &XML);
+    // build the document of file in memory from a binary patch node table, the XML file is written
+    // only when it's edited, flushed or copied
+    bool        load(const string &file, const PatchBinary &binary);
+
+    // write now the pending edits of a document (or of all of them), i.e. before copying the patch file
+    void        flush(const string &file);
+    void        flushAll();
+    // drop the in memory copy, next access will read the file from disk again
+    void        forget(const string &file);
+    // copy a patch file with its pending edits
+    bool        copyFile(const string &from, const string &to);
+    // flush everything and stop the background writer
+    void        close();
+
+    void        setFlushDelay(int ms) { flushDelay = ms; }
+
+protected:
+
+    PatchDocument();
+
+    void                    threadedFunction();
+    shared_ptr<Document>    getDocument(const string &file);
+    bool                    flushDocument(const string &path, shared_ptr<Document> doc, bool force);
+
+    std::mutex                          documentsMutex;
+    std::mutex                          writeMutex;
+    map<string,shared_ptr<Document>>    documents;
+    int                                 flushDelay;
+
+};
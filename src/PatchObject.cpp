@@ -31,6 +31,24 @@
 ==============================================================================*/
 
 #include "PatchObject.h"
+#include "AudioFeatureFrame.h"
+
+std::atomic<uint64_t> PatchObject::numEventsSent(0);
+
+//--------------------------------------------------------------
+static shared_ptr<void> adoptLinkBuffer(int type, void *data){
+    if(data == nullptr){
+        return shared_ptr<void>();
+    }
+    switch(type){
+        case VP_LINK_STRING:        return shared_ptr<void>(static_cast<string *>(data));
+        case VP_LINK_ARRAY:         return shared_ptr<void>(static_cast<vector<float> *>(data));
+        case VP_LINK_TEXTURE:       return shared_ptr<void>(static_cast<ofTexture *>(data));
+        case VP_LINK_AUDIO:         return shared_ptr<void>(static_cast<ofSoundBuffer *>(data));
+        case VP_LINK_AUDIOFEATURES: return shared_ptr<void>(static_cast<AudioFeatureFrame *>(data));
+        default:                    return shared_ptr<void>(data,[](void *){});   // SPECIAL, not ours
+    }
+}
 
 //--------------------------------------------------------------
 PatchObject::PatchObject(){
@@ -58,6 +76,13 @@ PatchObject::PatchObject(){
     isAudioINObject         = false;
     isAudioOUTObject        = false;
     isPDSPPatchableObject   = false;
+    capabilities            = VP_OBJECT_GUI;    // main thread only until the factory sets the registered ones
+    isTimeDrivenObject      = true;     // updated every frame, data driven objects recompute only on changes
+    isDirty                 = true;
+
+    lastNumInlets           = 0;
+    lastNumOutlets          = 0;
+    layoutVersion           = 1;
     willErase               = false;
 
     width       = OBJECT_WIDTH;
@@ -82,6 +107,21 @@ PatchObject::PatchObject(){
     output_width        = 320;
     output_height       = 240;
 
+    hasInletsEvents     = false;
+    computeRequested    = false;
+
+    for(int i=0;i<MAX_OUTLETS;i++){
+        _outletParams[i]    = nullptr;
+        outletsVersion[i]   = 0;
+        outletsLastValue[i] = 0.0f;
+    }
+    for(int i=0;i<MAX_INLETS;i++){
+        _inletParams[i]         = nullptr;
+        inletsVersion[i]        = 0;
+        inletsSeenVersion[i]    = 0;
+        inletsLinked[i]         = false;
+    }
+
 }
 
 //--------------------------------------------------------------
@@ -155,24 +195,218 @@ void PatchObject::setupDSP(pdsp::Engine &engine){
 }
 
 //--------------------------------------------------------------
-void PatchObject::update(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
+bool PatchObject::update(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd, bool inletsChanged){
+    bool outletsChanged = false;
 
-    // update links positions
     if(!willErase){
-        for(int out=0;out<getNumOutlets();out++){
-            for(int i=0;i<static_cast<int>(outPut.size());i++){
-                if(!outPut[i]->isDisabled && outPut[i]->fromOutletID == out && patchObjects[outPut[i]->toObjectID]!=nullptr && !patchObjects[outPut[i]->toObjectID]->getWillErase()){
-                    outPut[i]->posFrom = getOutletPosition(out);
-                    outPut[i]->posTo = patchObjects[outPut[i]->toObjectID]->getInletPosition(outPut[i]->toInletID);
-                    // send data through links
-                    patchObjects[outPut[i]->toObjectID]->_inletParams[outPut[i]->toInletID] = _outletParams[out];
+        if(getNeedsUpdate(inletsChanged)){
+            updateObjectContent(patchObjects,fd);
+
+            // bump outlets versions: numeric outlets only when the value changed,
+            // the others every time the object recomputes
+            for(int out=0;out<getNumOutlets();out++){
+                if(getOutletType(out) == VP_LINK_NUMERIC){
+                    if(*(float *)&_outletParams[out] != outletsLastValue[out]){
+                        outletsLastValue[out] = *(float *)&_outletParams[out];
+                        outletsVersion[out]++;
+                        outletsChanged = true;
+                    }
+                }else{
+                    outletsVersion[out]++;
+                    outletsChanged = true;
                 }
+            }
+            for(int in=0;in<getNumInlets();in++){
+                inletsSeenVersion[in] = inletsVersion[in];
+            }
+            isDirty = false;
 
+            // the object had its chance to drain its inlets events
+            if(hasInletsEvents){
+                std::unique_lock<std::mutex> lock(inletsEventsMutex);
+                for(int in=0;in<MAX_INLETS;in++){
+                    inletsEvents[in].clear();
+                }
+                hasInletsEvents = false;
+            }
+        }
+
+        // send data through links, after the object content update, so the objects scheduled
+        // next in the same frame receive the fresh outlets data
+        int numOut = std::min(static_cast<int>(outletsLinks.size()),getNumOutlets());
+        for(int out=0;out<numOut;out++){
+            if(outletsLinks[out].empty()){
+                continue;
+            }
+            const LinkData &data = bindOutletData(out);
+            for(size_t i=0;i<outletsLinks[out].size();i++){
+                PatchLink *link = outletsLinks[out][i];
+                PatchObject *to = link->toObject;
+                if(to->getWillErase()){
+                    continue;
+                }
+                // update links positions only if one of the two ends moved
+                if(link->fromLayoutVersion != layoutVersion || link->toLayoutVersion != to->layoutVersion){
+                    link->posFrom = getOutletPosition(out);
+                    link->posTo = to->getInletPosition(link->toInletID);
+                    link->fromLayoutVersion = layoutVersion;
+                    link->toLayoutVersion = to->layoutVersion;
+                }
+                to->linkInlet(link->toInletID,data,outletsVersion[out]);
+                if(!outletsEvents[out].empty()){
+                    to->receiveInletEvents(link->toInletID,outletsEvents[out]);
+                }
+            }
+        }
+        for(int out=0;out<getNumOutlets();out++){
+            if(!outletsEvents[out].empty()){
+                numEventsSent += outletsEvents[out].size();
+                outletsEvents[out].clear();
             }
         }
-        updateObjectContent(patchObjects,fd);
     }
 
+    return outletsChanged;
+}
+
+//--------------------------------------------------------------
+bool PatchObject::getNeedsUpdate(bool inletsChanged){
+    // time driven objects, changed GUI (or mouse over it), queued events or new data from upstream
+    return inletsChanged || isTimeDrivenObject || isDirty || bActive || hasInletsEvents;
+}
+
+//--------------------------------------------------------------
+const LinkData &PatchObject::bindOutletData(int oid){
+    LinkData &data = outletsData[oid];
+    if(getOutletType(oid) == VP_LINK_NUMERIC){
+        data.buffer.reset();
+        data.number = *(float *)&_outletParams[oid];
+    }else if(data.buffer.get() != _outletParams[oid]){
+        // first bind, or the object replaced its outlet storage: the old one goes with its last reader
+        data.buffer = adoptLinkBuffer(getOutletType(oid),_outletParams[oid]);
+    }
+    data.type = getOutletType(oid);
+    return data;
+}
+
+//--------------------------------------------------------------
+void PatchObject::bindInletOwnData(int iid){
+    LinkData &own = inletsOwnData[iid];
+    if(getInletType(iid) == VP_LINK_NUMERIC){
+        own.buffer.reset();
+        own.number = *(float *)&_inletParams[iid];
+    }else if(own.buffer.get() != _inletParams[iid]){
+        own.buffer = adoptLinkBuffer(getInletType(iid),_inletParams[iid]);
+    }
+    own.type = getInletType(iid);
+}
+
+//--------------------------------------------------------------
+void PatchObject::linkInlet(int iid, const LinkData &data, size_t version){
+    if(!inletsLinked[iid]){
+        // keep the inlet own data, to get it back on disconnect
+        bindInletOwnData(iid);
+        inletsLinked[iid] = true;
+    }
+    if(inletsData[iid].buffer != data.buffer){
+        inletsData[iid].buffer = data.buffer;
+    }
+    inletsData[iid].type = data.type;
+    inletsData[iid].number = data.number;
+    if(data.type == VP_LINK_NUMERIC){
+        *(float *)&_inletParams[iid] = data.number;
+    }else{
+        _inletParams[iid] = data.buffer.get();
+    }
+    inletsVersion[iid] = version;
+}
+
+//--------------------------------------------------------------
+void PatchObject::unlinkInlet(int iid){
+    if(iid < static_cast<int>(inletsConnected.size())){
+        inletsConnected[iid] = false;
+    }
+    if(inletsLinked[iid]){
+        inletsLinked[iid] = false;
+        inletsData[iid] = LinkData();
+        // numbers keep the last value received
+        if(inletsOwnData[iid].type != VP_LINK_NUMERIC){
+            _inletParams[iid] = inletsOwnData[iid].buffer.get();
+        }
+    }
+}
+
+//--------------------------------------------------------------
+void PatchObject::pushOutletEvent(int oid, float value){
+    pushOutletEvent(oid,value,PatchClock::getInstance().getElapsedTimeMicros());
+}
+
+//--------------------------------------------------------------
+void PatchObject::pushOutletEvent(int oid, float value, uint64_t time){
+    PatchEvent event;
+    event.time  = time;
+    event.value = value;
+    outletsEvents[oid].push_back(event);
+}
+
+//--------------------------------------------------------------
+bool PatchObject::getInletEvents(int iid, vector<PatchEvent> &events){
+    events.clear();
+    if(!hasInletsEvents){
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(inletsEventsMutex);
+    events.swap(inletsEvents[iid]);
+    // several producers on the same inlet, keep the events in time order
+    std::stable_sort(events.begin(),events.end(),[](const PatchEvent &a, const PatchEvent &b){ return a.time < b.time; });
+    return !events.empty();
+}
+
+//--------------------------------------------------------------
+bool PatchObject::processInletEvents(const std::function<void(int,uint64_t)> &process){
+    if(!hasInletsEvents){
+        return false;
+    }
+    mergedEvents.clear();
+    for(int in=0;in<getNumInlets();in++){
+        if(getInletType(in) == VP_LINK_NUMERIC && getInletEvents(in,drainedEvents)){
+            for(size_t i=0;i<drainedEvents.size();i++){
+                mergedEvents.push_back(make_pair(in,drainedEvents.at(i)));
+            }
+        }
+    }
+    std::stable_sort(mergedEvents.begin(),mergedEvents.end(),[](const pair<int,PatchEvent> &a, const pair<int,PatchEvent> &b){ return a.second.time < b.second.time; });
+
+    for(size_t i=0;i<mergedEvents.size();i++){
+        *(float *)&_inletParams[mergedEvents.at(i).first] = mergedEvents.at(i).second.value;
+        process(mergedEvents.at(i).first,mergedEvents.at(i).second.time);
+    }
+    return !mergedEvents.empty();
+}
+
+//--------------------------------------------------------------
+void PatchObject::runWithInletEvents(const std::function<void()> &compute, int oid){
+    runWithInletEvents(compute,[oid](int inlet){ return oid; });
+}
+
+//--------------------------------------------------------------
+void PatchObject::runWithInletEvents(const std::function<void()> &compute, const std::function<int(int)> &eventOutlet){
+    if(!processInletEvents([this,&compute,&eventOutlet](int inlet, uint64_t time){
+        compute();
+        int oid = eventOutlet(inlet);
+        if(oid >= 0){
+            pushOutletEvent(oid,*(float *)&_outletParams[oid],time);
+        }
+    })){
+        compute();
+    }
+}
+
+//--------------------------------------------------------------
+void PatchObject::receiveInletEvents(int iid, const vector<PatchEvent> &events){
+    std::unique_lock<std::mutex> lock(inletsEventsMutex);
+    inletsEvents[iid].insert(inletsEvents[iid].end(),events.begin(),events.end());
+    hasInletsEvents = true;
 }
 
 //--------------------------------------------------------------
@@ -198,6 +432,8 @@ void PatchObject::draw(ofxFontStash *font){
                     break;
                 case 5: ofSetColor(COLOR_SCRIPT); ofSetLineWidth(1);
                     break;
+                case 6: ofSetColor(COLOR_AUDIOFEATURES);
+                    break;
                 default: break;
                 }
                 ofPushMatrix();
@@ -241,6 +477,8 @@ void PatchObject::draw(ofxFontStash *font){
                     break;
                 case 5: ofSetColor(COLOR_SCRIPT); ofSetLineWidth(1);
                     break;
+                case 6: ofSetColor(COLOR_AUDIOFEATURES);
+                    break;
                 default: break;
                 }
                 ofPushMatrix();
@@ -274,6 +512,8 @@ void PatchObject::draw(ofxFontStash *font){
                         break;
                     case 5: ofSetColor(COLOR_SCRIPT_LINK);
                         break;
+                    case 6: ofSetColor(COLOR_AUDIOFEATURES_LINK);
+                        break;
                     default: break;
                     }
 
@@ -298,6 +538,8 @@ void PatchObject::draw(ofxFontStash *font){
                         break;
                     case 5: ofSetColor(COLOR_SCRIPT);
                         break;
+                    case 6: ofSetColor(COLOR_AUDIOFEATURES);
+                        break;
                     default: break;
                     }
                     for (int v=1;v<static_cast<int>(outPut[j]->linkVertices.size())-1;v++) {
@@ -473,6 +715,47 @@ ofVec2f PatchObject::getOutletPosition(int oid){
     return ofVec2f(x + width + 3,y + (headerHeight*2) + ((height-(headerHeight*2))/outlets.size()*oid));
 }
 
+//--------------------------------------------------------------
+void PatchObject::compileLinks(map<int,PatchObject*> &patchObjects){
+    outletsLinks.clear();
+    outletsLinks.resize(getNumOutlets());
+
+    for(int j=0;j<static_cast<int>(outPut.size());j++){
+        PatchLink *link = outPut[j];
+        link->toObject = nullptr;
+        link->fromLayoutVersion = 0;
+        link->toLayoutVersion = 0;
+        if(link->isDisabled || link->fromOutletID < 0 || link->fromOutletID >= getNumOutlets()){
+            continue;
+        }
+        map<int,PatchObject*>::iterator to = patchObjects.find(link->toObjectID);
+        if(to != patchObjects.end() && to->second != nullptr){
+            link->toObject = to->second;
+            outletsLinks.at(link->fromOutletID).push_back(link);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+void PatchObject::initProfiler(){
+    if(profilerEntry == nullptr || profilerEntry->objectID != nId || profilerEntry->objectName != name){
+        profilerEntry = PatchProfiler::getInstance().registerObject(nId,name);
+        for(int ph=0;ph<VP_PROFILE_NUM_PHASES;ph++){
+            profilerKeys[ph] = name+ofToString(nId)+"_"+PatchProfiler::getPhaseName(ph);
+        }
+    }
+}
+
+//--------------------------------------------------------------
+void PatchObject::checkLayout(){
+    if(x != lastLayout.x || y != lastLayout.y || width != lastLayout.width || height != lastLayout.height || inlets.size() != lastNumInlets || outlets.size() != lastNumOutlets){
+        lastLayout.set(x,y,width,height);
+        lastNumInlets = inlets.size();
+        lastNumOutlets = outlets.size();
+        layoutVersion++;
+    }
+}
+
 //--------------------------------------------------------------
 bool PatchObject::getIsOutletConnected(int oid){
     for(int j=0;j<static_cast<int>(outPut.size());j++){
@@ -489,14 +772,17 @@ bool PatchObject::getIsOutletConnected(int oid){
 //---------------------------------------------------------------------------------- LOAD/SAVE
 //--------------------------------------------------------------
 bool PatchObject::loadConfig(shared_ptr<ofAppGLFWWindow> &mainWindow, pdsp::Engine &engine,int oTag, string &configFile){
-    ofxXmlSettings XML;
     bool loaded = false;
+    bool found = false;
 
-    if (XML.loadFile(configFile)){
+    {
+        PatchDocument::Access doc = PatchDocument::getInstance().access(configFile);
+        ofxXmlSettings &XML = doc.getXml();
 
-        patchFile = configFile;
+        if(doc.isLoaded() && XML.pushTag("object", oTag)){
+            found = true;
 
-        if(XML.pushTag("object", oTag)){
+            patchFile = configFile;
 
             nId = XML.getValue("id", 0);
             name = XML.getValue("name","none");
@@ -526,10 +812,18 @@ bool PatchObject::loadConfig(shared_ptr<ofAppGLFWWindow> &mainWindow, pdsp::Engi
                 }
                 XML.popTag();
             }
+        }
+    }
 
-            setup(mainWindow);
-            setupDSP(engine);
+    // objects setup reads the patch document too, so it runs with the document unlocked
+    if(found){
+        setup(mainWindow);
+        setupDSP(engine);
 
+        PatchDocument::Access doc = PatchDocument::getInstance().access(configFile);
+        ofxXmlSettings &XML = doc.getXml();
+
+        if(XML.pushTag("object", oTag)){
             if(XML.pushTag("outlets")){
                 int totalOutlets = XML.getNumTags("link");
                 for (int i=0;i<totalOutlets;i++){
@@ -541,23 +835,65 @@ bool PatchObject::loadConfig(shared_ptr<ofAppGLFWWindow> &mainWindow, pdsp::Engi
                 }
                 XML.popTag();
             }
+        }
 
-            loaded = true;
+        upgradeLinkTypes();
 
-        }
+        loaded = true;
     }
 
     return loaded;
 
 }
 
+//--------------------------------------------------------------
+bool PatchObject::loadConfig(shared_ptr<ofAppGLFWWindow> &mainWindow, pdsp::Engine &engine,const PatchBinary &binary,uint32_t objectIndex, string &configFile){
+    if(objectIndex >= binary.getNumObjects()){
+        return false;
+    }
+    const PatchBinary::Object &object = binary.getObjects()[objectIndex];
+
+    patchFile = configFile;
+
+    nId = object.id;
+    name = binary.getString(object.name);
+    filepath = binary.getValue(object.node,"filepath","none");
+
+    move(static_cast<int>(object.x),static_cast<int>(object.y));
+
+    uint32_t vars = binary.findChild(object.node,"vars");
+    for(uint32_t var = binary.findChild(vars,"var"); var != PatchBinary::NO_NODE; var = binary.getNextSibling(var)){
+        customVars[binary.getValue(var,"name","")] = ofToFloat(binary.getValue(var,"value","0"));
+    }
+
+    uint32_t inletsNode = binary.findChild(object.node,"inlets");
+    for(uint32_t link = binary.findChild(inletsNode,"link"); link != PatchBinary::NO_NODE; link = binary.getNextSibling(link)){
+        inlets.push_back(ofToInt(binary.getValue(link,"type","0")));
+        inletsNames.push_back(binary.getValue(link,"name",""));
+    }
+
+    setup(mainWindow);
+    setupDSP(engine);
+
+    uint32_t outletsNode = binary.findChild(object.node,"outlets");
+    for(uint32_t link = binary.findChild(outletsNode,"link"); link != PatchBinary::NO_NODE; link = binary.getNextSibling(link)){
+        outlets.push_back(ofToInt(binary.getValue(link,"type","0")));
+        outletsNames.push_back(binary.getValue(link,"name",""));
+    }
+
+    upgradeLinkTypes();
+
+    return true;
+}
+
 //--------------------------------------------------------------
 bool PatchObject::saveConfig(bool newConnection,int objID){
-    ofxXmlSettings XML;
     bool saved = false;
 
     if(patchFile != ""){
-        if(XML.loadFile(patchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(patchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if(doc.isLoaded()){
             int totalObjects = XML.getNumTags("object");
             // first save of the object
             if(nId == -1){
@@ -706,7 +1042,8 @@ bool PatchObject::saveConfig(bool newConnection,int objID){
                     }
                 }
             }
-            saved = XML.saveFile();
+            doc.setDirty();
+            saved = true;
         }
     }
 
@@ -716,11 +1053,12 @@ bool PatchObject::saveConfig(bool newConnection,int objID){
 
 //--------------------------------------------------------------
 bool PatchObject::removeLinkFromConfig(int outlet){
-    ofxXmlSettings XML;
     bool saved = false;
 
     if(patchFile != ""){
-        if(XML.loadFile(patchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(patchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if(doc.isLoaded()){
             int totalObjects = XML.getNumTags("object");
             for(int i=0;i<totalObjects;i++){
                 if(XML.pushTag("object", i)){
@@ -739,9 +1077,9 @@ bool PatchObject::removeLinkFromConfig(int outlet){
                     XML.popTag();
                 }
             }
+            doc.setDirty();
+            saved = true;
         }
-
-        saved = XML.saveFile();
     }
 
     return saved;
@@ -749,11 +1087,12 @@ bool PatchObject::removeLinkFromConfig(int outlet){
 
 //--------------------------------------------------------------
 bool PatchObject::clearCustomVars(){
-    ofxXmlSettings XML;
     bool saved = false;
 
     if(patchFile != ""){
-        if(XML.loadFile(patchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(patchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if(doc.isLoaded()){
             int totalObjects = XML.getNumTags("object");
             for(int i=0;i<totalObjects;i++){
                 if(XML.pushTag("object", i)){
@@ -786,10 +1125,9 @@ bool PatchObject::clearCustomVars(){
                     XML.popTag();
                 }
             }
+            doc.setDirty();
+            saved = true;
         }
-
-        saved = XML.saveFile();
-
     }
 
     return saved;
@@ -799,10 +1137,10 @@ bool PatchObject::clearCustomVars(){
 map<string,float> PatchObject::loadCustomVars(){
     map<string,float> tempVars;
 
-    ofxXmlSettings XML;
-
     if(patchFile != ""){
-        if(XML.loadFile(patchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(patchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if(doc.isLoaded()){
             int totalObjects = XML.getNumTags("object");
             for(int i=0;i<totalObjects;i++){
                 if(XML.pushTag("object", i)){
@@ -908,6 +1246,7 @@ void PatchObject::mousePressed(float mx, float my){
         ofVec3f m = ofVec3f(mx, my,0);
         if(box->inside(m)){
             mousePressedObjectContent(m);
+            isDirty = true;
         }
         if(isMouseOver && headerBox->inside(m) && !isSystemObject){
             for (unsigned int i=0;i<headerButtons.size();i++){
@@ -936,6 +1275,7 @@ void PatchObject::mouseReleased(float mx, float my,map<int,PatchObject*> &patchO
 
         if (box->inside(m)){
             mouseReleasedObjectContent(m);
+            isDirty = true;
 
             x = box->getPosition().x;
             y = box->getPosition().y;
@@ -963,6 +1303,7 @@ void PatchObject::mouseReleased(float mx, float my,map<int,PatchObject*> &patchO
 void PatchObject::keyPressed(int key){
     if(!willErase && isMouseOver){
         keyPressedObjectContent(key);
+        isDirty = true;
     }
 }
 
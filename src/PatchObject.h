@@ -43,6 +43,15 @@
 #include "ofxThreadedFileDialog.h"
 
 #include "DraggableVertex.h"
+#include "ObjectFactory.h"
+#include "PatchDocument.h"
+#include "PatchBinary.h"
+#include "AssetLoader.h"
+#include "PatchClock.h"
+#include "ControlThread.h"
+#include "PatchProfiler.h"
+#include "ScopeRing.h"
+#include "TextureReadback.h"
 
 enum LINK_TYPE {
     VP_LINK_NUMERIC,
@@ -50,9 +59,12 @@ enum LINK_TYPE {
     VP_LINK_ARRAY,
     VP_LINK_TEXTURE,
     VP_LINK_AUDIO,
-    VP_LINK_SPECIAL
+    VP_LINK_SPECIAL,
+    VP_LINK_AUDIOFEATURES
 };
 
+class PatchObject;
+
 struct PatchLink{
     vector<DraggableVertex> linkVertices;
     ofVec2f                 posFrom;
@@ -62,6 +74,27 @@ struct PatchLink{
     int                     toObjectID;
     int                     toInletID;
     bool                    isDisabled;
+    // resolved on graph compile
+    PatchObject             *toObject;
+    size_t                  fromLayoutVersion;
+    size_t                  toLayoutVersion;
+};
+
+// timestamped message on a numeric link, queued so bursts within one frame are not lost
+struct PatchEvent{
+    uint64_t                time;   // patch clock, microseconds
+    float                   value;
+};
+
+// typed payload of a link: numbers travel by value, every other type is a ref counted buffer owned
+// by the outlet and shared by all the connected inlets (no copies, and a reader keeps the data alive
+// even if the outlet replaces it); the SPECIAL references (scripts, devices) are never owned
+struct LinkData{
+    int                     type;       // LINK_TYPE, -1 until bound
+    float                   number;
+    shared_ptr<void>        buffer;
+
+    LinkData() : type(-1), number(0.0f) {}
 };
 
 struct PushButton{
@@ -80,7 +113,8 @@ public:
 
     void                    setup(shared_ptr<ofAppGLFWWindow> &mainWindow);
     void                    setupDSP(pdsp::Engine &engine);
-    void                    update(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd);
+    // inletsChanged: some upstream object changed its outlets since the last run, true if ours changed
+    bool                    update(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd, bool inletsChanged);
     void                    draw(ofxFontStash *font);
 
     // Virtual Methods
@@ -93,6 +127,11 @@ public:
     virtual void            updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd) {}
     virtual void            drawObjectContent(ofxFontStash *font) {}
     virtual void            removeObjectContent() {}
+    // heavy work split off a main thread (GL/GUI) object: updateObjectContent publishes the last results,
+    // hands it the inputs (pixels, GUI values) and calls requestCompute(); this then runs on the update
+    // pool next to the rest of the update pass, done before the draw. GL, ofxDatGui and the links data
+    // (read by the other objects meanwhile) are off limits here, only the object own compute state
+    virtual void            computeObjectContent() {}
 
     virtual void            mouseMovedObjectContent(ofVec3f _m) {}
     virtual void            mousePressedObjectContent(ofVec3f _m) {}
@@ -107,6 +146,10 @@ public:
     virtual void            audioOutObject(ofSoundBuffer &outputBuffer) {}
 
     virtual void            resetSystemObject() {}
+    // patches saved before the inlets/outlets changed, called once both are loaded,
+    // and the outlet a saved link to an inlet of inletType now starts from
+    virtual void            upgradeLinkTypes() {}
+    virtual int             upgradeLinkOutlet(int oid, int inletType) { return oid; }
     virtual void            resetResolution(int fromID=-1, int newWidth=-1, int newHeight=-1) {}
 
     // Mouse Events
@@ -132,6 +175,8 @@ public:
 
     // LOAD/SAVE
     bool                    loadConfig(shared_ptr<ofAppGLFWWindow> &mainWindow,pdsp::Engine &engine,int oTag, string &configFile);
+    // binary patches: from the object table entry and its node subtree, no document lookup
+    bool                    loadConfig(shared_ptr<ofAppGLFWWindow> &mainWindow,pdsp::Engine &engine,const PatchBinary &binary,uint32_t objectIndex, string &configFile);
     bool                    saveConfig(bool newConnection,int objID);
     bool                    removeLinkFromConfig(int outlet);
 
@@ -139,7 +184,7 @@ public:
     void                    addInlet(int type,string name) { inlets.push_back(type);inletsNames.push_back(name); }
     void                    addOutlet(int type,string name = "") { outlets.push_back(type);outletsNames.push_back(name); }
     void                    initInletsState() { for(int i=0;i<numInlets;i++){ inletsConnected.push_back(false); } }
-    void                    setCustomVar(float value, string name){ customVars[name] = value; }
+    void                    setCustomVar(float value, string name){ customVars[name] = value; isDirty = true; }
     float                   getCustomVar(string name) { if ( customVars.find(name) != customVars.end() ) { return customVars[name]; }else{ return 0; } }
     void                    substituteCustomVar(string oldName, string newName) { if ( customVars.find(oldName) != customVars.end() ) { customVars[newName] = customVars[oldName]; customVars.erase(oldName); } }
     bool                    clearCustomVars();
@@ -154,12 +199,18 @@ public:
     bool                    getIsAudioINObject() const { return isAudioINObject; }
     bool                    getIsAudioOUTObject() const { return isAudioOUTObject; }
     bool                    getIsPDSPPatchableObject() const { return isPDSPPatchableObject; }
+    bool                    getIsGLObject() const { return (capabilities & (VP_OBJECT_GL | VP_OBJECT_GUI)) != 0; }
+    void                    setCapabilities(int _capabilities) { capabilities = _capabilities; }
+    bool                    getIsTimeDrivenObject() const { return isTimeDrivenObject; }
+    bool                    getNeedsUpdate(bool inletsChanged);
+    size_t                  getOutletVersion(int oid) const { return outletsVersion[oid]; }
     int                     getInletType(int iid) const { return inlets[iid]; }
     int                     getOutletType(int oid) const { return outlets[oid]; }
     string                  getOutletName(int oid) const { return outletsNames[oid]; }
     int                     getNumInlets() { return inlets.size(); }
     int                     getNumOutlets() { return outlets.size(); }
     bool                    getIsOutletConnected(int oid);
+    size_t                  getLayoutVersion() const { return layoutVersion; }
     bool                    getWillErase() { return willErase; }
 
     float                   getObjectWidth() { return width; }
@@ -176,9 +227,50 @@ public:
     void                    setWillErase(bool e) { willErase = e; }
     void                    setInletMouseNear(int oid,bool active) { inletsMouseNear.at(oid) = active; }
     void                    setIsObjectSelected(bool s) { isObjectSelected = s; }
+    void                    markDirty() { isDirty = true; }
+    void                    requestCompute() { computeRequested = true; }
+    bool                    takeComputeRequest() { bool requested = computeRequested; computeRequested = false; return requested; }
+
+    // LINK DATA
+    // the raw slots stay as aliases of the bound data for the objects code: an outlet buffer is adopted
+    // on its first bind, and again if the object replaced it; an inlet is always assigned from its outlet
+    // (a null outlet gives a null inlet, never a stale one) and gets its own data back when disconnected
+    const LinkData          &bindOutletData(int oid);
+    void                    linkInlet(int iid, const LinkData &data, size_t version);
+    void                    unlinkInlet(int iid);
+    float                   getInletFloat(int iid) const { return *(float *)&_inletParams[iid]; }
+    void                    setOutletFloat(int oid, float value) { *(float *)&_outletParams[oid] = value; }
+    // read only view holding a reference, safe to keep past the frame (in a worker job)
+    template<typename T> shared_ptr<const T> getInletData(int iid) const { return shared_ptr<const T>(inletsLinked[iid] ? inletsData[iid].buffer : inletsOwnData[iid].buffer,static_cast<const T *>(_inletParams[iid])); }
+    template<typename T> T  *getOutletData(int oid) const { return static_cast<T *>(_outletParams[oid]); }
+    size_t                  getInletVersion(int iid) const { return inletsVersion[iid]; }
+    bool                    getInletChanged(int iid) const { return inletsVersion[iid] != inletsSeenVersion[iid]; }
+
+    // EVENT QUEUES
+    // numeric outlets can also send events, delivered in order to the connected inlets in the same frame;
+    // the outlet float keeps working for the objects reading the link value only.
+    // Inlet events not drained during updateObjectContent are dropped after it.
+    void                    pushOutletEvent(int oid, float value);
+    void                    pushOutletEvent(int oid, float value, uint64_t time);
+    bool                    getInletEvents(int iid, vector<PatchEvent> &events);
+    // drain the numeric inlets events merged in time order: every event sets its inlet value, then
+    // process(inlet,time) runs and can push the outlets events; false if there were none (read the levels)
+    bool                    processInletEvents(const std::function<void(int,uint64_t)> &process);
+    // compute() once per inlet event, pushing the outlet eventOutlet(inlet) returns (-1 for none) at the
+    // event time, or once on the inlets levels if there were no events
+    void                    runWithInletEvents(const std::function<void()> &compute, int oid=0);
+    void                    runWithInletEvents(const std::function<void()> &compute, const std::function<int(int)> &eventOutlet);
+    void                    receiveInletEvents(int iid, const vector<PatchEvent> &events);
+    static uint64_t         getNumEventsSent() { return numEventsSent; }
 
     // UTILS
     void                    bezierLink(DraggableVertex from, DraggableVertex to, float _width);
+    void                    compileLinks(map<int,PatchObject*> &patchObjects);
+    // profiler entry and keys built once per object id, not every frame
+    void                    initProfiler();
+    PatchProfiler::Entry    *getProfilerEntry() const { return profilerEntry.get(); }
+    const string            &getProfilerKey(int phase) const { return profilerKeys[phase]; }
+    void                    checkLayout();
 
     // patch object connections
     vector<PatchLink*>      outPut;
@@ -187,6 +279,19 @@ public:
     void                    *_inletParams[MAX_INLETS];
     void                    *_outletParams[MAX_OUTLETS];
 
+    // change propagation: every outlet has a version, bumped when the outlet data changes,
+    // and every inlet keeps the version received from the link and the last one computed
+    size_t                  outletsVersion[MAX_OUTLETS];
+    float                   outletsLastValue[MAX_OUTLETS];
+    size_t                  inletsVersion[MAX_INLETS];
+    size_t                  inletsSeenVersion[MAX_INLETS];
+
+    // typed link data behind the raw slots: outlets, inlets linked data and inlets own data
+    LinkData                outletsData[MAX_OUTLETS];
+    LinkData                inletsData[MAX_INLETS];
+    LinkData                inletsOwnData[MAX_INLETS];
+    bool                    inletsLinked[MAX_INLETS];
+
     map<int,pdsp::PatchNode> pdspIn;
     map<int,pdsp::PatchNode> pdspOut;
 
@@ -245,7 +350,31 @@ protected:
     bool                    isAudioINObject;
     bool                    isAudioOUTObject;
     bool                    isPDSPPatchableObject;
+    int                     capabilities;           // OBJECT_CAPABILITY flags, from the factory registration
+    bool                    isTimeDrivenObject;
+    bool                    isDirty;
+    bool                    computeRequested;
     bool                    willErase;
     float                   retinaScale;
 
+    // per outlet adjacency, rebuilt on graph edits only
+    vector<vector<PatchLink*>> outletsLinks;
+    // events sent during the last update / received and not yet drained
+    vector<PatchEvent>      outletsEvents[MAX_OUTLETS];
+    vector<PatchEvent>      inletsEvents[MAX_INLETS];
+    vector<PatchEvent>      drainedEvents;
+    vector<pair<int,PatchEvent>> mergedEvents;      // inlet, event
+    std::mutex              inletsEventsMutex;      // fan in from producers updated in parallel
+    std::atomic<bool>       hasInletsEvents;
+    static std::atomic<uint64_t> numEventsSent;
+
+    shared_ptr<PatchProfiler::Entry> profilerEntry;
+    string                  profilerKeys[VP_PROFILE_NUM_PHASES];
+    // inlets/outlets positions change only when the object moves, resizes or changes its inlets/outlets
+    ofRectangle             lastLayout;
+    size_t                  lastNumInlets, lastNumOutlets;
+    size_t                  layoutVersion;
+
+    void                    bindInletOwnData(int iid);
+
 };
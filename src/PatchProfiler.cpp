@@ -0,0 +1,222 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "PatchProfiler.h"
+
+//--------------------------------------------------------------
+PatchProfiler::PatchProfiler(){
+    enabled     = true;
+    windowTime  = 0;
+}
+
+//--------------------------------------------------------------
+shared_ptr<PatchProfiler::Entry> PatchProfiler::registerObject(int objectID, const string &objectName){
+    shared_ptr<Entry> entry = make_shared<Entry>();
+    entry->objectID     = objectID;
+    entry->objectName   = objectName;
+
+    std::unique_lock<std::mutex> lock(entriesMutex);
+    entries[objectID] = entry;
+    return entry;
+}
+
+//--------------------------------------------------------------
+void PatchProfiler::removeObject(int objectID){
+    std::unique_lock<std::mutex> lock(entriesMutex);
+    entries.erase(objectID);
+}
+
+//--------------------------------------------------------------
+void PatchProfiler::clear(){
+    std::unique_lock<std::mutex> lock(entriesMutex);
+    entries.clear();
+}
+
+//--------------------------------------------------------------
+void PatchProfiler::record(Entry *entry, int phase, uint64_t micros){
+    Phase &p = entry->phases[phase];
+    p.count.fetch_add(1,std::memory_order_relaxed);
+    p.totalMicros.fetch_add(micros,std::memory_order_relaxed);
+    p.lastMicros.store(micros,std::memory_order_relaxed);
+    if(micros > p.maxMicros.load(std::memory_order_relaxed)){
+        p.maxMicros.store(micros,std::memory_order_relaxed);
+    }
+
+    // bucket b holds [2^(b-1), 2^b) microseconds
+    int bucket = 0;
+    while(micros > 0 && bucket < PROFILER_BUCKETS-1){
+        micros >>= 1;
+        bucket++;
+    }
+    p.histogram[bucket].fetch_add(1,std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+void PatchProfiler::update(bool force){
+    if(!force && ofGetElapsedTimeMillis()-windowTime < 1000){
+        return;
+    }
+    windowTime = ofGetElapsedTimeMillis();
+
+    std::unique_lock<std::mutex> lock(entriesMutex);
+    for(map<int,shared_ptr<Entry>>::iterator it = entries.begin(); it != entries.end(); it++ ){
+        for(int ph=0;ph<VP_PROFILE_NUM_PHASES;ph++){
+            Phase &p = it->second->phases[ph];
+            for(int b=0;b<PROFILER_BUCKETS;b++){
+                p.lastHistogram[b].store(p.histogram[b].exchange(0,std::memory_order_relaxed),std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+ProfilerSummary PatchProfiler::summarize(const Entry &entry, int phase){
+    const Phase &p = entry.phases[phase];
+
+    ProfilerSummary summary;
+    summary.objectID    = entry.objectID;
+    summary.objectName  = entry.objectName;
+    summary.phase       = phase;
+    summary.count       = p.count.load(std::memory_order_relaxed);
+    summary.lastMicros  = p.lastMicros.load(std::memory_order_relaxed);
+    summary.maxMicros   = p.maxMicros.load(std::memory_order_relaxed);
+    summary.meanMicros  = summary.count > 0 ? static_cast<float>(p.totalMicros.load(std::memory_order_relaxed))/static_cast<float>(summary.count) : 0.0f;
+
+    uint32_t histogram[PROFILER_BUCKETS];
+    uint64_t total = 0;
+    for(int b=0;b<PROFILER_BUCKETS;b++){
+        histogram[b] = p.lastHistogram[b].load(std::memory_order_relaxed);
+        total += histogram[b];
+    }
+
+    uint64_t *percentiles[3] = { &summary.p50Micros, &summary.p95Micros, &summary.p99Micros };
+    const float ranks[3] = { 0.5f, 0.95f, 0.99f };
+    for(int i=0;i<3;i++){
+        *percentiles[i] = 0;
+        uint64_t target = static_cast<uint64_t>(ceil(ranks[i]*static_cast<float>(total)));
+        uint64_t accum = 0;
+        for(int b=0;b<PROFILER_BUCKETS && total > 0;b++){
+            accum += histogram[b];
+            if(accum >= target){
+                *percentiles[i] = b == 0 ? 0 : (static_cast<uint64_t>(1) << b) - 1;
+                break;
+            }
+        }
+    }
+
+    return summary;
+}
+
+//--------------------------------------------------------------
+bool PatchProfiler::getSummary(int objectID, int phase, ProfilerSummary &summary){
+    std::unique_lock<std::mutex> lock(entriesMutex);
+    map<int,shared_ptr<Entry>>::iterator it = entries.find(objectID);
+    if(it == entries.end()){
+        return false;
+    }
+    summary = summarize(*it->second,phase);
+    return true;
+}
+
+//--------------------------------------------------------------
+vector<ProfilerSummary> PatchProfiler::getSummaries(int phase){
+    vector<ProfilerSummary> summaries;
+    std::unique_lock<std::mutex> lock(entriesMutex);
+    for(map<int,shared_ptr<Entry>>::iterator it = entries.begin(); it != entries.end(); it++ ){
+        if(it->second->phases[phase].count > 0){
+            summaries.push_back(summarize(*it->second,phase));
+        }
+    }
+    return summaries;
+}
+
+//--------------------------------------------------------------
+vector<ProfilerSummary> PatchProfiler::getTopObjects(int phase, size_t num){
+    vector<ProfilerSummary> summaries = getSummaries(phase);
+    std::sort(summaries.begin(),summaries.end(),[](const ProfilerSummary &a, const ProfilerSummary &b){ return a.meanMicros > b.meanMicros; });
+    if(summaries.size() > num){
+        summaries.resize(num);
+    }
+    return summaries;
+}
+
+//--------------------------------------------------------------
+string PatchProfiler::getPhaseName(int phase){
+    switch(phase){
+    case VP_PROFILE_UPDATE: return "update";
+    case VP_PROFILE_DRAW:   return "draw";
+    case VP_PROFILE_AUDIO:  return "audio";
+    default:                return "";
+    }
+}
+
+//--------------------------------------------------------------
+bool PatchProfiler::exportCSV(const string &path){
+    ofstream file(ofToDataPath(path,true).c_str(),ios::out|ios::trunc);
+    if(!file.is_open()){
+        ofLog(OF_LOG_ERROR,"Can't write the profiler report %s",path.c_str());
+        return false;
+    }
+    file << "id,name,phase,count,last_us,mean_us,max_us,p50_us,p95_us,p99_us\n";
+    for(int ph=0;ph<VP_PROFILE_NUM_PHASES;ph++){
+        vector<ProfilerSummary> summaries = getSummaries(ph);
+        for(size_t i=0;i<summaries.size();i++){
+            const ProfilerSummary &s = summaries.at(i);
+            file << s.objectID << ",\"" << s.objectName << "\"," << getPhaseName(ph) << "," << s.count << "," << s.lastMicros << "," << s.meanMicros << "," << s.maxMicros << "," << s.p50Micros << "," << s.p95Micros << "," << s.p99Micros << "\n";
+        }
+    }
+    return file.good();
+}
+
+//--------------------------------------------------------------
+bool PatchProfiler::exportJSON(const string &path){
+    ofstream file(ofToDataPath(path,true).c_str(),ios::out|ios::trunc);
+    if(!file.is_open()){
+        ofLog(OF_LOG_ERROR,"Can't write the profiler report %s",path.c_str());
+        return false;
+    }
+    file << "{\n  \"objects\": [";
+    bool first = true;
+    for(int ph=0;ph<VP_PROFILE_NUM_PHASES;ph++){
+        vector<ProfilerSummary> summaries = getSummaries(ph);
+        for(size_t i=0;i<summaries.size();i++){
+            const ProfilerSummary &s = summaries.at(i);
+            file << (first ? "\n" : ",\n");
+            first = false;
+            file << "    { \"id\": " << s.objectID << ", \"name\": \"" << s.objectName << "\", \"phase\": \"" << getPhaseName(ph) << "\""
+                 << ", \"count\": " << s.count << ", \"last_us\": " << s.lastMicros << ", \"mean_us\": " << s.meanMicros << ", \"max_us\": " << s.maxMicros
+                 << ", \"p50_us\": " << s.p50Micros << ", \"p95_us\": " << s.p95Micros << ", \"p99_us\": " << s.p99Micros << " }";
+        }
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
@@ -0,0 +1,139 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+#define PROFILER_BUCKETS    24      // log2 histogram of microseconds, up to ~8 seconds
+
+enum PROFILER_PHASE {
+    VP_PROFILE_UPDATE,
+    VP_PROFILE_DRAW,
+    VP_PROFILE_AUDIO,
+    VP_PROFILE_NUM_PHASES
+};
+
+struct ProfilerSummary{
+    int                 objectID;
+    string              objectName;
+    int                 phase;
+    uint64_t            count;
+    uint64_t            lastMicros;
+    uint64_t            maxMicros;
+    float               meanMicros;
+    // from the last complete histogram window, bucket upper bounds
+    uint64_t            p50Micros;
+    uint64_t            p95Micros;
+    uint64_t            p99Micros;
+};
+
+// Per object timings of the update, draw and audio phases.
+// Every object gets its entry once (interned, no per frame keys), recording is a clock read
+// and a few relaxed atomics, so the profiler can stay on in production.
+// Histograms roll every second: queries read the last complete window.
+class PatchProfiler{
+
+public:
+
+    struct Phase{
+        Phase(){ reset(); }
+        void reset(){
+            count = 0; totalMicros = 0; maxMicros = 0; lastMicros = 0;
+            for(int b=0;b<PROFILER_BUCKETS;b++){ histogram[b] = 0; lastHistogram[b] = 0; }
+        }
+        std::atomic<uint64_t>   count;
+        std::atomic<uint64_t>   totalMicros;
+        std::atomic<uint64_t>   maxMicros;
+        std::atomic<uint64_t>   lastMicros;
+        std::atomic<uint32_t>   histogram[PROFILER_BUCKETS];
+        std::atomic<uint32_t>   lastHistogram[PROFILER_BUCKETS];
+    };
+
+    struct Entry{
+        int                     objectID;
+        string                  objectName;
+        Phase                   phases[VP_PROFILE_NUM_PHASES];
+    };
+
+    // times the enclosing scope
+    class Scope{
+    public:
+        Scope(Entry *e, int p) : entry(e), phase(p) { if(entry != nullptr && PatchProfiler::getInstance().isEnabled()){ start = std::chrono::steady_clock::now(); }else{ entry = nullptr; } }
+        ~Scope(){ if(entry != nullptr){ PatchProfiler::record(entry,phase,static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-start).count())); } }
+    private:
+        Entry                                   *entry;
+        int                                     phase;
+        std::chrono::steady_clock::time_point   start;
+    };
+
+    static PatchProfiler& getInstance(){
+        static PatchProfiler instance;
+        return instance;
+    }
+
+    shared_ptr<Entry>       registerObject(int objectID, const string &objectName);
+    void                    removeObject(int objectID);
+    void                    clear();
+
+    static void             record(Entry *entry, int phase, uint64_t micros);
+
+    // main thread, once per frame: rolls the histograms windows
+    void                    update(bool force=false);
+
+    void                    setEnabled(bool e){ enabled = e; }
+    bool                    isEnabled() const { return enabled; }
+
+    // QUERY
+    bool                    getSummary(int objectID, int phase, ProfilerSummary &summary);
+    vector<ProfilerSummary> getSummaries(int phase);
+    // slowest objects of a phase, by mean time
+    vector<ProfilerSummary> getTopObjects(int phase, size_t num);
+
+    // EXPORT
+    bool                    exportCSV(const string &path);
+    bool                    exportJSON(const string &path);
+
+    static string           getPhaseName(int phase);
+
+protected:
+
+    PatchProfiler();
+
+    ProfilerSummary         summarize(const Entry &entry, int phase);
+
+    std::mutex              entriesMutex;
+    map<int,shared_ptr<Entry>> entries;
+    std::atomic<bool>       enabled;
+    uint64_t                windowTime;
+
+};
@@ -0,0 +1,139 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+// audio buffers held by a scope ring
+#define SCOPE_RING_BUFFERS  4
+
+// Single producer / single consumer sample ring for the objects displays and analysis.
+// The audio thread only copies samples in (no allocation, no lock), the GUI thread
+// reads the latest window at frame rate and builds its waveform from it, or a worker
+// reads sequential (overlapping) windows with readAt().
+class ScopeRing{
+
+public:
+
+    ScopeRing() : mask(0), writeIndex(0), lastRead(0) {}
+
+    // before the audio thread starts pushing
+    void allocate(size_t frames){
+        size_t size = 1;
+        while(size < frames*SCOPE_RING_BUFFERS){
+            size <<= 1;
+        }
+        ring.assign(frames > 0 ? size : 0,0.0f);
+        window.assign(frames,0.0f);
+        scratch.assign(frames,0.0f);
+        mask        = size-1;
+        writeIndex.store(0);
+        lastRead    = 0;
+    }
+
+    // audio thread, stride steps over interleaved channels
+    void push(const float *samples, size_t numFrames, size_t stride=1){
+        if(ring.empty() || samples == nullptr){
+            return;
+        }
+        uint64_t w = writeIndex.load(std::memory_order_relaxed);
+        for(size_t i=0;i<numFrames;i++){
+            ring[(w+i) & mask] = samples[i*stride];
+        }
+        writeIndex.store(w+numFrames,std::memory_order_release);
+    }
+
+    // GUI thread: fills samples with the latest samples.size() frames,
+    // false (samples untouched) if nothing new was pushed since the last read
+    bool read(vector<float> &samples){
+        uint64_t w = writeIndex.load(std::memory_order_acquire);
+        if(ring.empty() || samples.empty() || w == lastRead){
+            return false;
+        }
+        size_t n = std::min(samples.size(),ring.size()/2);
+        if(scratch.size() < n){
+            scratch.resize(n);
+        }
+        for(size_t i=0;i<n;i++){
+            scratch[i] = ring[(w-n+i) & mask];
+        }
+        // the producer lapped the window while copying, keep the previous samples and retry next frame
+        if(writeIndex.load(std::memory_order_acquire)-w > ring.size()-n){
+            return false;
+        }
+        std::copy(scratch.begin(),scratch.begin()+n,samples.end()-n);
+        lastRead = w;
+        return true;
+    }
+
+    // GUI thread: rebuilds the display waveform (width w, samples clipped to [-1,1] between top and bottom)
+    // from the latest allocated frames, the waveform keeps its vertices if nothing new was pushed
+    bool buildWaveform(ofPolyline &waveform, float w, float top, float bottom){
+        if(!read(window)){
+            return false;
+        }
+        waveform.clear();
+        for(size_t i=0;i<window.size();i++){
+            float x = ofMap(i, 0, window.size(), 0, w);
+            float y = ofMap(ofClamp(window[i],-1.0f,1.0f), -1, 1, top, bottom);
+            waveform.addVertex(x, y);
+        }
+        return true;
+    }
+
+    // sequential consumers (i.e. analysis windows): frames pushed so far
+    uint64_t getWriteIndex() const { return writeIndex.load(std::memory_order_acquire); }
+    size_t getSize() const { return ring.size(); }
+
+    // copies the frames [start, start+n), false if they are not (or no more) in the ring
+    bool readAt(uint64_t start, float *dst, size_t n) const{
+        uint64_t w = writeIndex.load(std::memory_order_acquire);
+        if(ring.empty() || start+n > w || w-start > ring.size()){
+            return false;
+        }
+        for(size_t i=0;i<n;i++){
+            dst[i] = ring[(start+i) & mask];
+        }
+        return writeIndex.load(std::memory_order_acquire)-start <= ring.size();
+    }
+
+private:
+
+    vector<float>           ring;
+    vector<float>           window;     // display window, buildWaveform
+    vector<float>           scratch;    // read copy, published only if not lapped
+    size_t                  mask;
+    std::atomic<uint64_t>   writeIndex;
+    uint64_t                lastRead;
+
+};
@@ -0,0 +1,459 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "SoundfileStream.h"
+
+//--------------------------------------------------------------
+SoundfileStream::SoundfileStream(){
+    streaming       = false;
+    length          = 0;
+    sampleRate      = 0;
+    dataOffset      = 0;
+    numChannels     = 0;
+    bitsPerSample   = 0;
+    blockAlign      = 0;
+    isFloat         = false;
+    readPosition    = 0;
+    readDirection   = 1;
+    readLoop        = false;
+    underruns       = 0;
+    overviewReady   = 0;
+    overviewFrame   = 0;
+}
+
+//--------------------------------------------------------------
+SoundfileStream::~SoundfileStream(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool SoundfileStream::open(const string &path){
+    close();
+
+    filepath = path;
+    overview.assign(STREAM_OVERVIEW_SIZE,0.0f);
+    overviewReady = 0;
+    overviewFrame = 0;
+    // largest source span of a render segment, plus the interpolation taps
+    scratch.assign(STREAM_BLOCK_FRAMES+STREAM_SINC_TAPS+4,0.0f);
+    getSincTable();
+
+    file.open(ofToDataPath(path,true).c_str(),std::ios::binary);
+    if(file.is_open() && parseWav(file)){
+        streaming = true;
+
+        fileBytes.resize(static_cast<size_t>(STREAM_BLOCK_FRAMES*blockAlign));
+        blocks = vector<Block>(STREAM_CACHE_BLOCKS);
+        for(size_t i=0;i<blocks.size();i++){
+            blocks.at(i).samples.assign(STREAM_BLOCK_FRAMES,0.0f);
+        }
+
+        overviewFile.open(ofToDataPath(path,true).c_str(),std::ios::binary);
+        overviewSamples.resize(STREAM_BLOCK_FRAMES);
+        overviewBytes.resize(fileBytes.size());
+
+        // the beginning of the file is ready when open returns
+        prefetch();
+        startThread();
+        return true;
+    }
+    file.close();
+
+    // compressed formats: decoded in memory, first channel only
+    ofxAudioFile audiofile;
+    audiofile.load(path);
+    if(!audiofile.loaded() || audiofile.length() < 2){
+        ofLog(OF_LOG_ERROR,"Can't open the sound file %s",path.c_str());
+        return false;
+    }
+
+    streaming   = false;
+    length      = audiofile.length();
+    sampleRate  = audiofile.samplerate();
+    memorySamples.resize(static_cast<size_t>(length));
+    for(uint64_t n=0;n<length;n++){
+        memorySamples[n] = audiofile.sample(static_cast<int>(n),0);
+    }
+    for(uint64_t n=0;n<length;n++){
+        size_t bin = static_cast<size_t>(n*STREAM_OVERVIEW_SIZE/length);
+        overview[bin] = std::max(overview[bin],fabsf(memorySamples[n]));
+    }
+    overviewReady = STREAM_OVERVIEW_SIZE;
+
+    return true;
+}
+
+//--------------------------------------------------------------
+void SoundfileStream::close(){
+    if(isThreadRunning()){
+        stopThread();
+        waitForThread(false);
+    }
+    if(file.is_open()){
+        file.close();
+    }
+    if(overviewFile.is_open()){
+        overviewFile.close();
+    }
+    blocks.clear();
+    memorySamples.clear();
+    length = 0;
+}
+
+//--------------------------------------------------------------
+bool SoundfileStream::parseWav(std::ifstream &wav){
+    char id[4];
+    uint32_t size = 0;
+
+    wav.read(id,4);
+    wav.read(reinterpret_cast<char*>(&size),4);
+    if(!wav || strncmp(id,"RIFF",4) != 0){
+        return false;
+    }
+    wav.read(id,4);
+    if(!wav || strncmp(id,"WAVE",4) != 0){
+        return false;
+    }
+
+    bool hasFormat = false;
+    int format = 0;
+    while(wav.read(id,4) && wav.read(reinterpret_cast<char*>(&size),4)){
+        if(strncmp(id,"fmt ",4) == 0){
+            uint16_t fmtTag, channels, align, bits;
+            uint32_t rate, byteRate;
+            wav.read(reinterpret_cast<char*>(&fmtTag),2);
+            wav.read(reinterpret_cast<char*>(&channels),2);
+            wav.read(reinterpret_cast<char*>(&rate),4);
+            wav.read(reinterpret_cast<char*>(&byteRate),4);
+            wav.read(reinterpret_cast<char*>(&align),2);
+            wav.read(reinterpret_cast<char*>(&bits),2);
+            format = fmtTag;
+            if(fmtTag == 0xFFFE && size >= 40){
+                // WAVE_FORMAT_EXTENSIBLE, the sub format GUID starts with the format tag
+                uint16_t subFormat;
+                wav.seekg(8,std::ios::cur);
+                wav.read(reinterpret_cast<char*>(&subFormat),2);
+                format = subFormat;
+                wav.seekg(static_cast<std::streamoff>(size)-26,std::ios::cur);
+            }else{
+                wav.seekg(static_cast<std::streamoff>(size)-16,std::ios::cur);
+            }
+            numChannels     = channels;
+            sampleRate      = static_cast<int>(rate);
+            blockAlign      = align;
+            bitsPerSample   = bits;
+            isFloat         = format == 3;
+            hasFormat       = true;
+        }else if(strncmp(id,"data",4) == 0){
+            if(!hasFormat || numChannels <= 0 || blockAlign <= 0){
+                return false;
+            }
+            bool pcm = format == 1 && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32);
+            bool flt = format == 3 && (bitsPerSample == 32 || bitsPerSample == 64);
+            if(!pcm && !flt){
+                return false;
+            }
+            dataOffset  = static_cast<uint64_t>(wav.tellg());
+            length      = size / static_cast<uint32_t>(blockAlign);
+            return length > 1;
+        }else{
+            // chunks are word aligned
+            wav.seekg(static_cast<std::streamoff>(size + (size & 1)),std::ios::cur);
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------
+void SoundfileStream::readFrames(std::ifstream &wav, uint64_t start, size_t count, float *dst, vector<char> &bytes){
+    size_t available = static_cast<size_t>(std::min<uint64_t>(count,length > start ? length-start : 0));
+    size_t numBytes = available*static_cast<size_t>(blockAlign);
+
+    wav.clear();
+    wav.seekg(static_cast<std::streamoff>(dataOffset+start*static_cast<uint64_t>(blockAlign)),std::ios::beg);
+    wav.read(bytes.data(),static_cast<std::streamsize>(numBytes));
+    size_t frames = static_cast<size_t>(wav.gcount())/static_cast<size_t>(blockAlign);
+
+    // first channel of every frame
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(bytes.data());
+    for(size_t i=0;i<frames;i++,p+=blockAlign){
+        if(isFloat){
+            if(bitsPerSample == 32){
+                float v;
+                memcpy(&v,p,4);
+                dst[i] = v;
+            }else{
+                double v;
+                memcpy(&v,p,8);
+                dst[i] = static_cast<float>(v);
+            }
+        }else if(bitsPerSample == 16){
+            dst[i] = static_cast<float>(static_cast<int16_t>(p[0] | (p[1] << 8))) / 32768.0f;
+        }else if(bitsPerSample == 24){
+            int32_t v = (p[0] << 8) | (p[1] << 16) | (p[2] << 24);
+            dst[i] = static_cast<float>(v >> 8) / 8388608.0f;
+        }else if(bitsPerSample == 32){
+            int32_t v;
+            memcpy(&v,p,4);
+            dst[i] = static_cast<float>(v) / 2147483648.0f;
+        }else{
+            dst[i] = (static_cast<float>(p[0]) - 128.0f) / 128.0f;
+        }
+    }
+    for(size_t i=frames;i<count;i++){
+        dst[i] = 0.0f;
+    }
+}
+
+//--------------------------------------------------------------
+void SoundfileStream::fetch(int64_t start, size_t count, float *dst){
+    int64_t fileLength = static_cast<int64_t>(length);
+    size_t written = 0;
+
+    while(written < count){
+        int64_t frame = start+static_cast<int64_t>(written);
+        size_t n;
+        if(frame < 0){
+            n = static_cast<size_t>(std::min<int64_t>(-frame,static_cast<int64_t>(count-written)));
+            std::fill(dst+written,dst+written+n,0.0f);
+        }else if(frame >= fileLength){
+            n = count-written;
+            std::fill(dst+written,dst+written+n,0.0f);
+        }else if(!streaming){
+            n = static_cast<size_t>(std::min<int64_t>(fileLength-frame,static_cast<int64_t>(count-written)));
+            std::copy(memorySamples.begin()+frame,memorySamples.begin()+frame+static_cast<int64_t>(n),dst+written);
+        }else{
+            int64_t blockIndex = frame / STREAM_BLOCK_FRAMES;
+            size_t offset = static_cast<size_t>(frame % STREAM_BLOCK_FRAMES);
+            n = std::min(static_cast<size_t>(STREAM_BLOCK_FRAMES)-offset,count-written);
+            n = static_cast<size_t>(std::min<int64_t>(fileLength-frame,static_cast<int64_t>(n)));
+
+            // seqlock read: the block must hold the same index before and after the copy
+            Block &block = blocks[static_cast<size_t>(blockIndex % STREAM_CACHE_BLOCKS)];
+            bool hit = block.index.load(std::memory_order_acquire) == blockIndex;
+            if(hit){
+                std::copy(block.samples.begin()+static_cast<int64_t>(offset),block.samples.begin()+static_cast<int64_t>(offset+n),dst+written);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                hit = block.index.load(std::memory_order_relaxed) == blockIndex;
+            }
+            if(!hit){
+                std::fill(dst+written,dst+written+n,0.0f);
+                underruns.fetch_add(1,std::memory_order_relaxed);
+            }
+        }
+        written += n;
+    }
+}
+
+//--------------------------------------------------------------
+void SoundfileStream::render(double &playhead, double increment, bool loop, int interpolation, float *out, size_t numFrames){
+    if(length < 2){
+        std::fill(out,out+numFrames,0.0f);
+        return;
+    }
+
+    const double last = static_cast<double>(length-1);
+    const int64_t half = interpolation == VP_INTERPOLATION_SINC ? STREAM_SINC_TAPS/2 : 0;
+    const double absIncrement = fabs(increment);
+    const size_t maxSpan = scratch.size()-static_cast<size_t>(2*half)-2;
+    const vector<float> &sinc = getSincTable();
+
+    size_t done = 0;
+    while(done < numFrames){
+        if(!(playhead >= 0.0 && playhead < last)){
+            if(loop && increment != 0.0){
+                playhead = increment > 0.0 ? 0.0 : last-1.0;
+                continue;
+            }
+            std::fill(out+done,out+numFrames,0.0f);
+            break;
+        }
+
+        // output samples before the playhead leaves the file, in one straight run
+        size_t segment = numFrames-done;
+        double room = static_cast<double>(segment);
+        if(increment > 0.0){
+            room = ceil((last-playhead)/increment);
+        }else if(increment < 0.0){
+            room = floor(playhead/absIncrement)+1.0;
+        }
+        if(room < static_cast<double>(segment)){
+            segment = static_cast<size_t>(room);
+        }
+        if(absIncrement > 0.0){
+            segment = std::min(segment,std::max<size_t>(static_cast<size_t>(static_cast<double>(maxSpan)/absIncrement),1));
+        }
+        segment = std::max<size_t>(segment,1);
+
+        // source frames of the whole segment, gathered once
+        double endPosition = playhead+increment*static_cast<double>(segment-1);
+        int64_t first = static_cast<int64_t>(floor(std::min(playhead,endPosition)))-half;
+        int64_t lastNeeded = static_cast<int64_t>(floor(std::max(playhead,endPosition)))+1+half;
+        fetch(first,static_cast<size_t>(lastNeeded-first+1),scratch.data());
+
+        // branch free loops over the segment, positions from the segment start so the iterations are independent
+        const float *src = scratch.data();
+        const double position = playhead-static_cast<double>(first);
+        float *dst = out+done;
+        if(interpolation == VP_INTERPOLATION_SINC){
+            for(size_t i=0;i<segment;i++){
+                double p = position+increment*static_cast<double>(i);
+                size_t n = static_cast<size_t>(p);
+                size_t phase = std::min(static_cast<size_t>((p-static_cast<double>(n))*STREAM_SINC_PHASES),static_cast<size_t>(STREAM_SINC_PHASES-1));
+                const float *kernel = &sinc[phase*STREAM_SINC_TAPS];
+                const float *s = src+n-static_cast<size_t>(half)+1;
+                float acc = 0.0f;
+                for(int t=0;t<STREAM_SINC_TAPS;t++){
+                    acc += s[t]*kernel[t];
+                }
+                dst[i] = acc;
+            }
+        }else{
+            for(size_t i=0;i<segment;i++){
+                double p = position+increment*static_cast<double>(i);
+                size_t n = static_cast<size_t>(p);
+                float fract = static_cast<float>(p-static_cast<double>(n));
+                dst[i] = src[n]+(src[n+1]-src[n])*fract;
+            }
+        }
+
+        playhead += increment*static_cast<double>(segment);
+        done += segment;
+    }
+
+    // prefetch hint
+    readPosition.store(static_cast<int64_t>(std::max(playhead,0.0)),std::memory_order_relaxed);
+    readDirection.store(increment < 0.0 ? -1 : 1,std::memory_order_relaxed);
+    readLoop.store(loop,std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+float SoundfileStream::getOverview(size_t bin) const{
+    if(bin < overviewReady.load(std::memory_order_acquire)){
+        return overview[bin];
+    }
+    return 0.0f;
+}
+
+//--------------------------------------------------------------
+bool SoundfileStream::prefetch(){
+    int64_t numBlocks = static_cast<int64_t>((length+STREAM_BLOCK_FRAMES-1)/STREAM_BLOCK_FRAMES);
+    int64_t current = std::min(readPosition.load(std::memory_order_relaxed) / STREAM_BLOCK_FRAMES,numBlocks-1);
+    int direction = readDirection.load(std::memory_order_relaxed);
+    bool loop = readLoop.load(std::memory_order_relaxed);
+    bool idle = true;
+
+    // the playhead block, the ones ahead in the play direction (across the loop point), one behind
+    for(int i=0;i<=STREAM_PREFETCH_BLOCKS+1;i++){
+        int64_t k = i <= STREAM_PREFETCH_BLOCKS ? current+direction*i : current-direction;
+        if(k < 0 || k >= numBlocks){
+            if(!loop){
+                continue;
+            }
+            k = ((k % numBlocks)+numBlocks) % numBlocks;
+        }
+        Block &block = blocks[static_cast<size_t>(k % STREAM_CACHE_BLOCKS)];
+        int64_t held = block.index.load(std::memory_order_relaxed);
+        if(held == k){
+            continue;
+        }
+        // never evict a block of the playhead window for a wrapped one
+        int64_t distance = (held-current)*direction;
+        if(held >= 0 && distance >= -1 && distance <= STREAM_PREFETCH_BLOCKS){
+            continue;
+        }
+
+        // seqlock write
+        block.index.store(-1,std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        readFrames(file,static_cast<uint64_t>(k)*STREAM_BLOCK_FRAMES,STREAM_BLOCK_FRAMES,block.samples.data(),fileBytes);
+        block.index.store(k,std::memory_order_release);
+        idle = false;
+    }
+    return idle;
+}
+
+//--------------------------------------------------------------
+void SoundfileStream::scanOverview(){
+    size_t count = static_cast<size_t>(std::min<uint64_t>(STREAM_BLOCK_FRAMES,length-overviewFrame));
+    readFrames(overviewFile,overviewFrame,count,overviewSamples.data(),overviewBytes);
+
+    size_t bin = 0;
+    for(size_t i=0;i<count;i++){
+        bin = static_cast<size_t>((overviewFrame+i)*STREAM_OVERVIEW_SIZE/length);
+        overview[bin] = std::max(overview[bin],fabsf(overviewSamples[i]));
+    }
+    overviewFrame += count;
+
+    // bins before the current one are complete
+    overviewReady.store(overviewFrame >= length ? STREAM_OVERVIEW_SIZE : bin,std::memory_order_release);
+}
+
+//--------------------------------------------------------------
+void SoundfileStream::threadedFunction(){
+    while(isThreadRunning()){
+        if(prefetch()){
+            if(overviewFrame < length){
+                scanOverview();
+            }else{
+                std::this_thread::sleep_for(std::chrono::microseconds(2000));
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------
+const vector<float>& SoundfileStream::getSincTable(){
+    // Blackman windowed sinc, one normalized kernel per fractional phase
+    static vector<float> table;
+    static std::once_flag initialized;
+    std::call_once(initialized,[](){
+        const int half = STREAM_SINC_TAPS/2;
+        table.resize(STREAM_SINC_PHASES*STREAM_SINC_TAPS);
+        for(int ph=0;ph<STREAM_SINC_PHASES;ph++){
+            double fract = static_cast<double>(ph)/STREAM_SINC_PHASES;
+            double sum = 0.0;
+            for(int t=0;t<STREAM_SINC_TAPS;t++){
+                double d = static_cast<double>(t-half+1)-fract;
+                double sinc = fabs(d) < 1e-9 ? 1.0 : sin(PI*d)/(PI*d);
+                double w = d/half;
+                double window = fabs(w) >= 1.0 ? 0.0 : 0.42+0.5*cos(PI*w)+0.08*cos(2.0*PI*w);
+                table[ph*STREAM_SINC_TAPS+t] = static_cast<float>(sinc*window);
+                sum += sinc*window;
+            }
+            for(int t=0;t<STREAM_SINC_TAPS;t++){
+                table[ph*STREAM_SINC_TAPS+t] = static_cast<float>(table[ph*STREAM_SINC_TAPS+t]/sum);
+            }
+        }
+    });
+    return table;
+}
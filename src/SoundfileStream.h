@@ -0,0 +1,130 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxAudioFile.h"
+
+#define STREAM_BLOCK_FRAMES     8192    // frames of a cache block
+#define STREAM_CACHE_BLOCKS     32      // cache slots, 1 MB of samples whatever the file length
+#define STREAM_PREFETCH_BLOCKS  8       // blocks read ahead of the playhead
+#define STREAM_OVERVIEW_SIZE    2048    // bins of the waveform overview
+#define STREAM_SINC_TAPS        16
+#define STREAM_SINC_PHASES      256
+
+enum SoundfileInterpolation{
+    VP_INTERPOLATION_LINEAR,
+    VP_INTERPOLATION_SINC
+};
+
+// First channel reader of a sound file, for the soundfile player.
+// WAV files are streamed from disk: a prefetch thread keeps a fixed size block cache filled
+// around the playhead (and builds the waveform overview when idle), so memory use does not
+// depend on the file length. Other formats are decoded in memory with ofxAudioFile.
+// render() runs on the audio thread: no lock, no allocation, a cache miss plays silence.
+class SoundfileStream : public ofThread {
+
+public:
+
+    SoundfileStream();
+    ~SoundfileStream();
+
+    // loader thread, blocks until the first blocks are cached
+    bool            open(const string &path);
+    void            close();
+
+    uint64_t        getLength() const { return length; }
+    int             getSampleRate() const { return sampleRate; }
+    bool            getIsStreaming() const { return streaming; }
+    uint64_t        getUnderruns() const { return underruns; }
+
+    // audio thread: numFrames samples from playhead, advancing increment file frames per sample.
+    // Out of the file it wraps if loop, plays silence otherwise
+    void            render(double &playhead, double increment, bool loop, int interpolation, float *out, size_t numFrames);
+
+    // GUI thread: peak of an overview bin, 0 until the prefetch thread got there
+    float           getOverview(size_t bin) const;
+
+protected:
+
+    struct Block{
+        Block() : index(-1) {}
+        std::atomic<int64_t>    index;      // file block held, -1 while empty or being written
+        vector<float>           samples;
+    };
+
+    void                    threadedFunction();
+    bool                    parseWav(std::ifstream &file);
+    void                    readFrames(std::ifstream &file, uint64_t start, size_t count, float *dst, vector<char> &bytes);
+    void                    fetch(int64_t start, size_t count, float *dst);
+    bool                    prefetch();
+    void                    scanOverview();
+
+    static const vector<float>& getSincTable();
+
+    bool                    streaming;
+    uint64_t                length;
+    int                     sampleRate;
+
+    // WAV format
+    string                  filepath;
+    std::ifstream           file;
+    uint64_t                dataOffset;
+    int                     numChannels;
+    int                     bitsPerSample;
+    int                     blockAlign;
+    bool                    isFloat;
+    vector<char>            fileBytes;
+
+    // block cache, written by the prefetch thread only
+    vector<Block>           blocks;
+    std::atomic<int64_t>    readPosition;
+    std::atomic<int>        readDirection;
+    std::atomic<bool>       readLoop;
+    std::atomic<uint64_t>   underruns;
+
+    // decoded formats
+    vector<float>           memorySamples;
+
+    // render scratch, source span of a block of output samples
+    vector<float>           scratch;
+
+    // waveform overview
+    vector<float>           overview;
+    std::atomic<size_t>     overviewReady;
+    std::ifstream           overviewFile;
+    uint64_t                overviewFrame;
+    vector<float>           overviewSamples;
+    vector<char>            overviewBytes;
+
+};
@@ -0,0 +1,132 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#include "TextureReadback.h"
+
+//--------------------------------------------------------------
+bool TextureReadback::readToPixels(const ofTexture &texture, ofPixels &pixels){
+    if(!texture.isAllocated()){
+        return false;
+    }
+
+    const ofTextureData &textureData = texture.getTextureData();
+    uint64_t frame = ofGetFrameNum();
+    Entry &entry = entries[textureData.textureID];
+
+    // new texture, or its id was reused by one of an other size/format
+    if(!entry.allocated || static_cast<int>(entry.pixels.getWidth()) != static_cast<int>(textureData.width) || static_cast<int>(entry.pixels.getHeight()) != static_cast<int>(textureData.height) || entry.glInternalFormat != textureData.glInternalFormat){
+        release(entry);
+        allocate(entry,textureData);
+    }
+
+    // first reader this frame downloads, the others get the same pixels
+    if(entry.frame != frame){
+        entry.frame = frame;
+
+        // queue this frame download
+        ofSetPixelStoreiAlignment(GL_PACK_ALIGNMENT,entry.pixels.getWidth(),entry.pixels.getBytesPerChannel(),entry.pixels.getNumChannels());
+        glBindBuffer(GL_PIXEL_PACK_BUFFER,entry.pbos[entry.index]);
+        glBindTexture(textureData.textureTarget,textureData.textureID);
+        glGetTexImage(textureData.textureTarget,0,entry.glFormat,ofGetGlType(entry.pixels),nullptr);
+        glBindTexture(textureData.textureTarget,0);
+        entry.index = (entry.index+1) % READBACK_BUFFERS;
+
+        if(entry.queued < READBACK_BUFFERS-1){
+            // ring not full yet, the first frames of a texture are read synchronously
+            entry.queued++;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER,0);
+            texture.readToPixels(entry.pixels);
+        }else{
+            // the oldest download, next one to be overwritten
+            glBindBuffer(GL_PIXEL_PACK_BUFFER,entry.pbos[entry.index]);
+            unsigned char *mem = static_cast<unsigned char *>(glMapBuffer(GL_PIXEL_PACK_BUFFER,GL_READ_ONLY));
+            if(mem != nullptr){
+                memcpy(entry.pixels.getData(),mem,entry.pixels.getTotalBytes());
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER,0);
+        }
+    }
+
+    entry.lastRead = frame;
+    pixels = entry.pixels;
+
+    return true;
+}
+
+//--------------------------------------------------------------
+void TextureReadback::update(){
+    uint64_t frame = ofGetFrameNum();
+    for(map<GLuint,Entry>::iterator it = entries.begin(); it != entries.end();){
+        if(frame - it->second.lastRead > READBACK_MAX_IDLE){
+            release(it->second);
+            it = entries.erase(it);
+        }else{
+            it++;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+void TextureReadback::clear(){
+    for(map<GLuint,Entry>::iterator it = entries.begin(); it != entries.end(); it++){
+        release(it->second);
+    }
+    entries.clear();
+}
+
+//--------------------------------------------------------------
+void TextureReadback::allocate(Entry &entry, const ofTextureData &textureData){
+    entry.pixels.allocate(static_cast<size_t>(textureData.width),static_cast<size_t>(textureData.height),ofGetImageTypeFromGLType(textureData.glInternalFormat));
+    entry.glInternalFormat  = textureData.glInternalFormat;
+    entry.glFormat          = ofGetGlFormat(entry.pixels);
+
+    glGenBuffers(READBACK_BUFFERS,entry.pbos);
+    for(int i=0;i<READBACK_BUFFERS;i++){
+        glBindBuffer(GL_PIXEL_PACK_BUFFER,entry.pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER,entry.pixels.getTotalBytes(),nullptr,GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER,0);
+
+    entry.index     = 0;
+    entry.queued    = 0;
+    entry.frame     = std::numeric_limits<uint64_t>::max();
+    entry.allocated = true;
+}
+
+//--------------------------------------------------------------
+void TextureReadback::release(Entry &entry){
+    if(entry.allocated){
+        glDeleteBuffers(READBACK_BUFFERS,entry.pbos);
+        entry.allocated = false;
+    }
+}
@@ -0,0 +1,85 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+#define READBACK_BUFFERS    3       // PBOs per texture, async pixels arrive READBACK_BUFFERS-1 frames late
+#define READBACK_MAX_IDLE   60      // frames without readers before a texture entry is freed
+
+// Shared GPU to CPU download of the texture inlets (computer vision, data and osc objects).
+// Entries are keyed by texture id: a texture is read back at most once per frame, whatever the
+// number of objects reading it. The download goes through a ring of pixel pack buffers, as in
+// ofxFastFboReader: this frame's download is queued and the oldest one is mapped, so the GL
+// pipeline does not stall. Main (GL) thread only.
+class TextureReadback{
+
+public:
+
+    static TextureReadback& getInstance(){
+        static TextureReadback instance;
+        return instance;
+    }
+
+    // same contract as ofTexture::readToPixels
+    bool                    readToPixels(const ofTexture &texture, ofPixels &pixels);
+
+    // once per frame: frees the textures nobody read for a while
+    void                    update();
+    // with the GL context still alive
+    void                    clear();
+
+protected:
+
+    struct Entry{
+        Entry() : index(0), queued(0), glInternalFormat(0), glFormat(0), frame(std::numeric_limits<uint64_t>::max()), lastRead(0), allocated(false) {}
+
+        GLuint              pbos[READBACK_BUFFERS];
+        int                 index;
+        int                 queued;
+        int                 glInternalFormat;
+        int                 glFormat;
+        uint64_t            frame;
+        uint64_t            lastRead;
+        bool                allocated;
+        ofPixels            pixels;
+    };
+
+    TextureReadback() {}
+
+    void                    allocate(Entry &entry, const ofTextureData &textureData);
+    void                    release(Entry &entry);
+
+    map<GLuint,Entry>       entries;
+
+};
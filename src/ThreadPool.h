@@ -0,0 +1,199 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool: every worker owns a task deque, pops work from its own back
+// and, when empty, steals from the front of the other workers deques.
+// The thread waiting on a job helps running it, so it never sits idle while work is pending.
+class ThreadPool{
+
+public:
+
+    // Counter of the pending tasks of a group of submitted tasks
+    struct Job{
+        Job() : pending(0) {}
+        std::atomic<size_t>     pending;
+    };
+
+    ThreadPool(){
+        running     = false;
+        queuedTasks = 0;
+        nextQueue   = 0;
+    }
+
+    ~ThreadPool(){
+        stop();
+    }
+
+    // numThreads <= 0 means one worker for every available core except the calling one
+    void setup(int numThreads = 0){
+        stop();
+
+        if(numThreads <= 0){
+            numThreads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        }
+        if(numThreads < 1){
+            numThreads = 1;
+        }
+
+        running = true;
+        // last queue is reserved to the calling (main) thread
+        for(int i=0;i<numThreads+1;i++){
+            queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+        }
+        for(int i=0;i<numThreads;i++){
+            workers.push_back(std::thread(&ThreadPool::workerLoop,this,static_cast<size_t>(i)));
+        }
+    }
+
+    void stop(){
+        {
+            std::unique_lock<std::mutex> lck(wakeMutex);
+            running = false;
+        }
+        wakeCondition.notify_all();
+        for(size_t i=0;i<workers.size();i++){
+            if(workers.at(i).joinable()){
+                workers.at(i).join();
+            }
+        }
+        workers.clear();
+        queues.clear();
+        queuedTasks = 0;
+    }
+
+    bool isRunning() const { return running; }
+    int  getNumThreads() const { return static_cast<int>(workers.size()); }
+
+    // queue a task, tracked by the job counter
+    void submit(Job &job, std::function<void()> task){
+        job.pending++;
+        {
+            std::unique_lock<std::mutex> lck(wakeMutex);
+            queuedTasks++;
+        }
+        size_t q = nextQueue.fetch_add(1) % workers.size();
+        {
+            std::unique_lock<std::mutex> lck(queues.at(q)->mutex);
+            queues.at(q)->tasks.push_back([&job,task](){
+                task();
+                job.pending--;
+            });
+        }
+        wakeCondition.notify_one();
+    }
+
+    // block until all the job tasks are done, running queued tasks meanwhile
+    void wait(Job &job){
+        std::function<void()> task;
+        while(job.pending.load() > 0){
+            if(takeTask(queues.size()-1,task)){
+                task();
+            }else{
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // run task(i) for i in [0,count) and wait for all of them
+    void parallelFor(size_t count, std::function<void(size_t)> task){
+        Job job;
+        for(size_t i=0;i<count;i++){
+            submit(job,[task,i](){ task(i); });
+        }
+        wait(job);
+    }
+
+protected:
+
+    struct TaskQueue{
+        std::mutex                          mutex;
+        std::deque<std::function<void()>>   tasks;
+    };
+
+    bool takeTask(size_t index, std::function<void()> &task){
+        // own queue first (LIFO, cache warm)
+        {
+            std::unique_lock<std::mutex> lck(queues.at(index)->mutex);
+            if(!queues.at(index)->tasks.empty()){
+                task = std::move(queues.at(index)->tasks.back());
+                queues.at(index)->tasks.pop_back();
+                queuedTasks--;
+                return true;
+            }
+        }
+        // then steal from the others (FIFO)
+        for(size_t i=1;i<queues.size();i++){
+            size_t victim = (index + i) % queues.size();
+            std::unique_lock<std::mutex> lck(queues.at(victim)->mutex);
+            if(!queues.at(victim)->tasks.empty()){
+                task = std::move(queues.at(victim)->tasks.front());
+                queues.at(victim)->tasks.pop_front();
+                queuedTasks--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t index){
+        std::function<void()> task;
+        while(running){
+            if(takeTask(index,task)){
+                task();
+                task = nullptr;
+            }else{
+                std::unique_lock<std::mutex> lck(wakeMutex);
+                wakeCondition.wait(lck,[this](){ return !running || queuedTasks.load() > 0; });
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread>                workers;
+    std::mutex                              wakeMutex;
+    std::condition_variable                 wakeCondition;
+    std::atomic<bool>                       running;
+    std::atomic<size_t>                     queuedTasks;
+    std::atomic<size_t>                     nextQueue;
+
+};
@@ -0,0 +1,74 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "ofMain.h"
+
+// Lock free latest value exchange between one producer and one consumer thread.
+// The producer fills getWriteBuffer() and publishes it, the consumer calls update()
+// and reads getReadBuffer(); nobody waits and the consumer always gets a complete value.
+template<typename T>
+class TripleBuffer{
+
+public:
+
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    // producer
+    T&          getWriteBuffer(){ return slots[back]; }
+    void        publish(){ back = middle.exchange(back | FRESH) & INDEX; }
+
+    // consumer: true if a new value was published since the last update
+    bool        update(){
+        if((middle.load() & FRESH) == 0){
+            return false;
+        }
+        front = middle.exchange(front) & INDEX;
+        return true;
+    }
+    const T&    getReadBuffer() const { return slots[front]; }
+
+    // before the threads start, i.e. to preallocate every slot
+    T&          getSlot(int i){ return slots[i]; }
+
+protected:
+
+    static const int    INDEX = 3;
+    static const int    FRESH = 4;
+
+    T                   slots[3];
+    std::atomic<int>    middle;
+    int                 back;
+    int                 front;
+
+};
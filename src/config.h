@@ -72,6 +72,7 @@
 #define COLOR_TEXTURE_LINK      ofColor(120,255,255,255)
 #define COLOR_AUDIO_LINK        ofColor(255,255,120,255)
 #define COLOR_SCRIPT_LINK       ofColor(255,128,128,255)
+#define COLOR_AUDIOFEATURES_LINK ofColor(255,190,90,255)
 
 #define COLOR_NUMERIC           ofColor(210,210,210,255)
 #define COLOR_STRING            ofColor(200,180,255,255)
@@ -79,6 +80,7 @@
 #define COLOR_TEXTURE           ofColor(120,255,255,255)
 #define COLOR_AUDIO             ofColor(255,255,120,255)
 #define COLOR_SCRIPT            ofColor(255,128,128,255)
+#define COLOR_AUDIOFEATURES     ofColor(255,190,90,255)
 
 #define MAIN_FONT               "ofxbraitsch/fonts/Verdana.ttf"
 #define LIVECODING_FONT         "fonts/IBMPlexSans-Text.otf"
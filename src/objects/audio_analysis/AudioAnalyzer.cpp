@@ -40,7 +40,8 @@ AudioAnalyzer::AudioAnalyzer() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer();  // Audio stream
 
-    _outletParams[0] = new vector<float>();  // Analysis Data
+    _outletParams[0] = new AudioFeatureFrame();  // Analysis Data
+    _outletParams[1] = new vector<float>();     // Analysis Data, plain array for the non extractor objects
 
     this->initInletsState();
 
@@ -59,13 +60,29 @@ AudioAnalyzer::AudioAnalyzer() : PatchObject(){
     newConnection                   = false;
 
     isLoaded                        = false;
+
+    analysisReady                   = false;
+    analysisFrame                   = 0;
+    beatFrame                       = 0;
+    hopSize                         = 0;
+    beatTrack                       = nullptr;
+
+    demandedFeatures                = AA_FEATURE_ALL;
+    activeFeatures                  = AA_FEATURE_ALL;
+    appliedFeatures                 = -1;
+    sharedAnalyzerID                = -1;
+    isShared                        = false;
+    lastScanTime                    = 0;
+    publishedFrames                 = 0;
+    leaderFrames                    = 0;
 }
 
 //--------------------------------------------------------------
 void AudioAnalyzer::newObject(){
     this->setName("audio analyzer");
     this->addInlet(VP_LINK_AUDIO,"signal");
-    this->addOutlet(VP_LINK_ARRAY,"analysisData");
+    this->addOutlet(VP_LINK_AUDIOFEATURES,"analysisData");
+    this->addOutlet(VP_LINK_ARRAY,"analysisArray");
 
     this->setCustomVar(static_cast<float>(audioInputLevel),"INPUT_LEVEL");
     this->setCustomVar(static_cast<float>(smoothingValue),"SMOOTHING");
@@ -117,88 +134,44 @@ void AudioAnalyzer::updateObjectContent(map<int,PatchObject*> &patchObjects, ofx
             loadAudioSettings();
         }
 
-        if(isConnected && ofGetElapsedTimeMillis()-startTime > waitTime){
-            // Get analysis data
-            rms = audioAnalyzer.getValue(RMS, 0, smoothingValue);
-            power   = audioAnalyzer.getValue(POWER, 0, smoothingValue);
-            pitchFreq = audioAnalyzer.getValue(PITCH_FREQ, 0, smoothingValue);
-            if(pitchFreq > 4186){
-                pitchFreq = 0;
-            }
-            hfc = audioAnalyzer.getValue(HFC, 0, smoothingValue);
-            centroid = audioAnalyzer.getValue(CENTROID, 0, smoothingValue);
-            centroidNorm = audioAnalyzer.getValue(CENTROID, 0, smoothingValue, TRUE);
-            inharmonicity   = audioAnalyzer.getValue(INHARMONICITY, 0, smoothingValue);
-            dissonance = audioAnalyzer.getValue(DISSONANCE, 0, smoothingValue);
-            rollOff = audioAnalyzer.getValue(ROLL_OFF, 0, smoothingValue);
-            rollOffNorm  = audioAnalyzer.getValue(ROLL_OFF, 0, smoothingValue, TRUE);
-
-            spectrum = audioAnalyzer.getValues(SPECTRUM, 0, smoothingValue);
-            melBands = audioAnalyzer.getValues(MEL_BANDS, 0, smoothingValue);
-            mfcc = audioAnalyzer.getValues(MFCC, 0, smoothingValue);
-            hpcp = audioAnalyzer.getValues(HPCP, 0, smoothingValue);
-            tristimulus = audioAnalyzer.getValues(TRISTIMULUS, 0, smoothingValue);
-
-            isOnset = audioAnalyzer.getOnsetValue(0);
-
-            bpm     = beatTrack->getEstimatedBPM();
-            beat    = beatTrack->hasBeat();
-
-
-            unique_lock<mutex> lock(audioMutex);
-
-            int index = 0;
-
-            waveform.clear();
-            for(size_t i = 0; i < lastBuffer.getNumFrames(); i++) {
-                float sample = lastBuffer.getSample(i,0);
-                float x = ofMap(i, 0, lastBuffer.getNumFrames(), 0, this->width);
-                float y = ofMap(hardClip(sample), -1, 1, headerHeight, this->height);
-                waveform.addVertex(x, y);
+        if(ofGetElapsedTimeMillis()-lastScanTime > ANALYSIS_SCAN_TIME){
+            lastScanTime = ofGetElapsedTimeMillis();
+            scanConnections(patchObjects);
+        }
 
-                // SIGNAL BUFFER
-                static_cast<vector<float> *>(_outletParams[0])->at(i+index) = sample;
+        AudioFeatureFrame *outlet = static_cast<AudioFeatureFrame *>(_outletParams[0]);
+        bool newFrame = false;
+        if(isShared){
+            // same input and level as an other analyzer, take its analysis: both are updated
+            // in the same level, so the leader frame is only read under its frame mutex
+            map<int,PatchObject*>::iterator leader = patchObjects.find(sharedAnalyzerID);
+            AudioAnalyzer *leaderAnalyzer = leader != patchObjects.end() ? dynamic_cast<AudioAnalyzer *>(leader->second) : nullptr;
+            if(leaderAnalyzer != nullptr && !leaderAnalyzer->getWillErase()){
+                std::lock_guard<std::mutex> lock(leaderAnalyzer->frameMutex);
+                if(leaderAnalyzer->publishedFrames != leaderFrames){
+                    leaderFrames    = leaderAnalyzer->publishedFrames;
+                    rawFrame        = leaderAnalyzer->rawFrame;
+                    newFrame        = true;
+                }
+            }else{
+                isShared            = false;
+                sharedAnalyzerID    = -1;
+                lastScanTime        = 0;
             }
+        }else if(isConnected && analysisData.update()){
+            // latest analysis window from the worker thread, unsmoothed for the analyzers sharing it
+            std::lock_guard<std::mutex> lock(frameMutex);
+            rawFrame        = analysisData.getReadBuffer();
+            publishedFrames++;
+            newFrame        = true;
+        }
 
-            index += lastBuffer.getNumFrames();
-            // SPECTRUM
-            for(int i=0;i<static_cast<int>(spectrum.size());i++){
-                static_cast<vector<float> *>(_outletParams[0])->at(i+index) = ofMap(spectrum[i],DB_MIN,DB_MAX,0.0,1.0,true);
+        if(newFrame){
+            outlet->smoothFrom(rawFrame,smoothingValue.load());
+            updateWaveform(outlet->getSignal());
+            if(this->getIsOutletConnected(1)){
+                *static_cast<vector<float> *>(_outletParams[1]) = outlet->getData();
             }
-            index += spectrum.size();
-            // MELBANDS
-            for(int i=0;i<static_cast<int>(melBands.size());i++){
-                static_cast<vector<float> *>(_outletParams[0])->at(i+index) = ofMap(melBands[i], DB_MIN, DB_MAX, 0.0, 1.0, true);
-            }
-            index += melBands.size();
-            // MFCC
-            for(int i=0;i<static_cast<int>(mfcc.size());i++){
-                static_cast<vector<float> *>(_outletParams[0])->at(i+index) = ofMap(mfcc[i], 0, MFCC_MAX_ESTIMATED_VALUE, 0.0, 1.0, true);
-            }
-            index += mfcc.size();
-            // HPCP
-            for(int i=0;i<static_cast<int>(hpcp.size());i++){
-                static_cast<vector<float> *>(_outletParams[0])->at(i+index) = hpcp[i];
-            }
-            index += hpcp.size();
-            // TRISTIMULUS
-            for(int i=0;i<static_cast<int>(tristimulus.size());i++){
-                static_cast<vector<float> *>(_outletParams[0])->at(i+index) = tristimulus[i];
-            }
-            index += tristimulus.size();
-            // SINGLE VALUES (RMS, POWER, PITCH, HFC, CENTROID, INHARMONICITY, DISSONANCE, ROLLOFF, ONSET, BPM, BEAT)
-            static_cast<vector<float> *>(_outletParams[0])->at(index) = rms;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+1) = power;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+2) = pitchFreq;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+3) = hfc;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+4) = centroidNorm;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+5) = inharmonicity;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+6) = dissonance;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+7) = rollOffNorm;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+8) = static_cast<float>(isOnset);
-            static_cast<vector<float> *>(_outletParams[0])->at(index+9) = bpm;
-            static_cast<vector<float> *>(_outletParams[0])->at(index+10) = static_cast<float>(beat);
-
         }
     }else{
         isConnected     = false;
@@ -212,6 +185,16 @@ void AudioAnalyzer::updateObjectContent(map<int,PatchObject*> &patchObjects, ofx
 
 }
 
+//--------------------------------------------------------------
+void AudioAnalyzer::updateWaveform(const AudioFeatureView &signal){
+    waveform.clear();
+    for(int i = 0; i < static_cast<int>(signal.size()); i++) {
+        float x = ofMap(i, 0, signal.size(), 0, this->width);
+        float y = ofMap(hardClip(signal[i]), -1, 1, headerHeight, this->height);
+        waveform.addVertex(x, y);
+    }
+}
+
 //--------------------------------------------------------------
 void AudioAnalyzer::drawObjectContent(ofxFontStash *font){
     ofSetColor(255);
@@ -223,40 +206,279 @@ void AudioAnalyzer::drawObjectContent(ofxFontStash *font){
 
 //--------------------------------------------------------------
 void AudioAnalyzer::removeObjectContent(){
+    analysisReady = false;
+    if(isThreadRunning()){
+        stopThread();
+        waitForThread(false);
+    }
     audioAnalyzer.exit();
+    // the worker is joined, nobody reads the tracker anymore
+    if(beatTrack != nullptr){
+        delete beatTrack;
+        beatTrack = nullptr;
+    }
 }
 
 //--------------------------------------------------------------
 void AudioAnalyzer::audioInObject(ofSoundBuffer &inputBuffer){
-    if(this->inletsConnected[0] && isConnected && ofGetElapsedTimeMillis()-startTime > waitTime){
+    // first channel to the analysis ring, whatever the callback size; analysis runs on the worker
+    if(this->inletsConnected[0] && analysisReady.load(std::memory_order_acquire) && !isShared.load(std::memory_order_relaxed)){
+        ofSoundBuffer *input = static_cast<ofSoundBuffer *>(_inletParams[0]);
+        if(input->getNumFrames() > 0){
+            sampleRing.push(input->getBuffer().data(),input->getNumFrames(),input->getNumChannels());
+        }
+    }
+}
 
-        lastBuffer = *static_cast<ofSoundBuffer *>(_inletParams[0]);
+//--------------------------------------------------------------
+void AudioAnalyzer::threadedFunction(){
+    vector<float> window(static_cast<size_t>(bufferSize),0.0f);
+
+    while(isThreadRunning()){
+        int features = activeFeatures.load(std::memory_order_relaxed);
+        if(features != appliedFeatures){
+            applyFeatures(features);
+            appliedFeatures = features;
+        }
 
-        lastBuffer *= audioInputLevel;
+        uint64_t pushed = sampleRing.getWriteIndex();
 
-        // ESSENTIA Analyze Audio
-        lastBuffer.copyTo(monoBuffer, lastBuffer.getNumFrames(), 1, 0);
-        audioAnalyzer.analyze(monoBuffer);
+        // too far behind (the ring was lapped), jump to the latest window
+        if(pushed > analysisFrame+sampleRing.getSize()-window.size()){
+            analysisFrame   = pushed-window.size();
+            beatFrame       = analysisFrame;
+        }
+
+        if(analysisFrame+window.size() <= pushed && sampleRing.readAt(analysisFrame,window.data(),window.size())){
+            float level = audioInputLevel.load(std::memory_order_relaxed);
+            for(size_t i=0;i<window.size();i++){
+                monoBuffer.getSample(i,0) = window[i]*level;
+            }
+
+            // ESSENTIA Analyze Audio, overlapping windows
+            audioAnalyzer.analyze(monoBuffer);
+
+            // BTrack wants consecutive frames, one every window length
+            if((features & (AA_FEATURE_BPM | AA_FEATURE_BEAT)) && analysisFrame >= beatFrame){
+                beatTrack->audioIn(&monoBuffer.getBuffer()[0], bufferSize, 1);
+                beatFrame = analysisFrame+window.size();
+            }
 
-        // BTrack
-        beatTrack->audioIn(&monoBuffer.getBuffer()[0], bufferSize, 1);
+            analyzeWindow(analysisData.getWriteBuffer(),features);
+            analysisData.publish();
 
-        unique_lock<mutex> lock(audioMutex);
-        lastBuffer = monoBuffer;
+            analysisFrame += static_cast<uint64_t>(hopSize);
+        }else{
+            std::this_thread::sleep_for(std::chrono::microseconds(1000));
+        }
     }
 }
 
+//--------------------------------------------------------------
+void AudioAnalyzer::analyzeWindow(AudioFeatureFrame &frame, int features){
+    // unsmoothed, every analyzer sharing this analysis smooths it with its own setting
+    // Get analysis data, features nobody asked for stay at zero
+    rms             = (features & AA_FEATURE_RMS) ? audioAnalyzer.getValue(RMS, 0, 0.0f) : 0.0f;
+    power           = (features & AA_FEATURE_POWER) ? audioAnalyzer.getValue(POWER, 0, 0.0f) : 0.0f;
+    pitchFreq       = (features & AA_FEATURE_PITCH) ? audioAnalyzer.getValue(PITCH_FREQ, 0, 0.0f) : 0.0f;
+    if(pitchFreq > 4186){
+        pitchFreq = 0;
+    }
+    hfc             = (features & AA_FEATURE_HFC) ? audioAnalyzer.getValue(HFC, 0, 0.0f) : 0.0f;
+    centroidNorm    = (features & AA_FEATURE_CENTROID) ? audioAnalyzer.getValue(CENTROID, 0, 0.0f, TRUE) : 0.0f;
+    inharmonicity   = (features & AA_FEATURE_INHARMONICITY) ? audioAnalyzer.getValue(INHARMONICITY, 0, 0.0f) : 0.0f;
+    dissonance      = (features & AA_FEATURE_DISSONANCE) ? audioAnalyzer.getValue(DISSONANCE, 0, 0.0f) : 0.0f;
+    rollOffNorm     = (features & AA_FEATURE_ROLLOFF) ? audioAnalyzer.getValue(ROLL_OFF, 0, 0.0f, TRUE) : 0.0f;
+
+    if(features & AA_FEATURE_SPECTRUM) spectrum = audioAnalyzer.getValues(SPECTRUM, 0, 0.0f);
+    if(features & AA_FEATURE_MELBANDS) melBands = audioAnalyzer.getValues(MEL_BANDS, 0, 0.0f);
+    if(features & AA_FEATURE_MFCC) mfcc = audioAnalyzer.getValues(MFCC, 0, 0.0f);
+    if(features & AA_FEATURE_HPCP) hpcp = audioAnalyzer.getValues(HPCP, 0, 0.0f);
+    if(features & AA_FEATURE_TRISTIMULUS) tristimulus = audioAnalyzer.getValues(TRISTIMULUS, 0, 0.0f);
+
+    isOnset = (features & AA_FEATURE_ONSET) ? audioAnalyzer.getOnsetValue(0) : false;
+
+    bpm     = (features & AA_FEATURE_BPM) ? beatTrack->getEstimatedBPM() : 0.0f;
+    beat    = (features & AA_FEATURE_BEAT) ? beatTrack->hasBeat() : false;
+
+    vector<float> &data = frame.getData();
+    int index = 0;
+
+    // SIGNAL BUFFER
+    for(int i = 0; i < bufferSize; i++) {
+        data.at(i) = monoBuffer.getSample(i,0);
+    }
+    index += bufferSize;
+    // SPECTRUM
+    int spectrumSize = (bufferSize/2) + 1;
+    for(int i=0;i<spectrumSize;i++){
+        data.at(i+index) = (features & AA_FEATURE_SPECTRUM) && i < static_cast<int>(spectrum.size()) ? ofMap(spectrum[i],DB_MIN,DB_MAX,0.0,1.0,true) : 0.0f;
+    }
+    index += spectrumSize;
+    // MELBANDS
+    for(int i=0;i<MELBANDS_BANDS_NUM;i++){
+        data.at(i+index) = (features & AA_FEATURE_MELBANDS) && i < static_cast<int>(melBands.size()) ? ofMap(melBands[i], DB_MIN, DB_MAX, 0.0, 1.0, true) : 0.0f;
+    }
+    index += MELBANDS_BANDS_NUM;
+    // MFCC
+    for(int i=0;i<DCT_COEFF_NUM;i++){
+        data.at(i+index) = (features & AA_FEATURE_MFCC) && i < static_cast<int>(mfcc.size()) ? ofMap(mfcc[i], 0, MFCC_MAX_ESTIMATED_VALUE, 0.0, 1.0, true) : 0.0f;
+    }
+    index += DCT_COEFF_NUM;
+    // HPCP
+    for(int i=0;i<HPCP_SIZE;i++){
+        data.at(i+index) = (features & AA_FEATURE_HPCP) && i < static_cast<int>(hpcp.size()) ? hpcp[i] : 0.0f;
+    }
+    index += HPCP_SIZE;
+    // TRISTIMULUS
+    for(int i=0;i<TRISTIMULUS_BANDS_NUM;i++){
+        data.at(i+index) = (features & AA_FEATURE_TRISTIMULUS) && i < static_cast<int>(tristimulus.size()) ? tristimulus[i] : 0.0f;
+    }
+    index += TRISTIMULUS_BANDS_NUM;
+    // SINGLE VALUES (RMS, POWER, PITCH, HFC, CENTROID, INHARMONICITY, DISSONANCE, ROLLOFF, ONSET, BPM, BEAT)
+    data.at(index) = rms;
+    data.at(index+1) = power;
+    data.at(index+2) = pitchFreq;
+    data.at(index+3) = hfc;
+    data.at(index+4) = centroidNorm;
+    data.at(index+5) = inharmonicity;
+    data.at(index+6) = dissonance;
+    data.at(index+7) = rollOffNorm;
+    data.at(index+8) = static_cast<float>(isOnset);
+    data.at(index+9) = bpm;
+    data.at(index+10) = static_cast<float>(beat);
+}
+
+//--------------------------------------------------------------
+void AudioAnalyzer::upgradeLinkTypes(){
+    // patches saved with the single plain array outlet
+    if(outlets.size() == 1){
+        outlets[0] = VP_LINK_AUDIOFEATURES;
+        outlets.push_back(VP_LINK_ARRAY);
+        outletsNames.push_back("analysisArray");
+    }
+}
+
+//--------------------------------------------------------------
+int AudioAnalyzer::upgradeLinkOutlet(int oid, int inletType){
+    // the non extractor readers of the old array outlet get the plain array one
+    return oid == 0 && inletType == VP_LINK_ARRAY && outlets.size() > 1 ? 1 : oid;
+}
+
+//--------------------------------------------------------------
+void AudioAnalyzer::applyFeatures(int features){
+    // worker thread, between two analyze() calls
+    bool spectral = (features & ~(AA_FEATURE_RMS | AA_FEATURE_POWER | AA_FEATURE_BPM | AA_FEATURE_BEAT)) != 0;
+
+    audioAnalyzer.setActive(0, RMS, (features & AA_FEATURE_RMS) != 0);
+    audioAnalyzer.setActive(0, POWER, (features & AA_FEATURE_POWER) != 0);
+    // inharmonicity works on the harmonics of the detected pitch
+    audioAnalyzer.setActive(0, PITCH_FREQ, (features & (AA_FEATURE_PITCH | AA_FEATURE_INHARMONICITY)) != 0);
+    audioAnalyzer.setActive(0, PITCH_CONFIDENCE, (features & (AA_FEATURE_PITCH | AA_FEATURE_INHARMONICITY)) != 0);
+    audioAnalyzer.setActive(0, HFC, (features & (AA_FEATURE_HFC | AA_FEATURE_ONSET)) != 0);
+    audioAnalyzer.setActive(0, CENTROID, (features & AA_FEATURE_CENTROID) != 0);
+    audioAnalyzer.setActive(0, INHARMONICITY, (features & AA_FEATURE_INHARMONICITY) != 0);
+    audioAnalyzer.setActive(0, DISSONANCE, (features & AA_FEATURE_DISSONANCE) != 0);
+    audioAnalyzer.setActive(0, ROLL_OFF, (features & AA_FEATURE_ROLLOFF) != 0);
+    // one spectrum for every spectral feature
+    audioAnalyzer.setActive(0, SPECTRUM, spectral);
+    audioAnalyzer.setActive(0, MEL_BANDS, (features & (AA_FEATURE_MELBANDS | AA_FEATURE_MFCC)) != 0);
+    audioAnalyzer.setActive(0, MFCC, (features & AA_FEATURE_MFCC) != 0);
+    audioAnalyzer.setActive(0, HPCP, (features & AA_FEATURE_HPCP) != 0);
+    audioAnalyzer.setActive(0, TRISTIMULUS, (features & AA_FEATURE_TRISTIMULUS) != 0);
+    audioAnalyzer.setActive(0, ONSETS, (features & AA_FEATURE_ONSET) != 0);
+
+    // never read by any extractor
+    audioAnalyzer.setActive(0, ENERGY, false);
+    audioAnalyzer.setActive(0, PITCH_SALIENCE, false);
+    audioAnalyzer.setActive(0, SPECTRAL_COMPLEXITY, false);
+    audioAnalyzer.setActive(0, ODD_TO_EVEN, false);
+    audioAnalyzer.setActive(0, STRONG_PEAK, false);
+    audioAnalyzer.setActive(0, STRONG_DECAY, false);
+    audioAnalyzer.setActive(0, MULTI_PITCHES, false);
+    audioAnalyzer.setActive(0, PITCH_SALIENCE_FUNC_PEAKS, false);
+}
+
+//--------------------------------------------------------------
+int AudioAnalyzer::getLinkFeatures(PatchObject *reader, int oid){
+    // the extractors declare the features they read, the array outlet readers get every feature
+    AudioFeatureExtractor *extractor = dynamic_cast<AudioFeatureExtractor *>(reader);
+    return oid == 0 && extractor != nullptr ? extractor->getAudioFeatures() : AA_FEATURE_ALL;
+}
+
+//--------------------------------------------------------------
+void AudioAnalyzer::scanConnections(map<int,PatchObject*> &patchObjects){
+    // features asked for by our own links
+    demandedFeatures = 0;
+    for(int o=0;o<static_cast<int>(this->outPut.size());o++){
+        if(this->outPut[o]->isDisabled){
+            continue;
+        }
+        map<int,PatchObject*>::iterator to = patchObjects.find(this->outPut[o]->toObjectID);
+        if(to != patchObjects.end() && to->second != nullptr && !to->second->getWillErase()){
+            demandedFeatures |= getLinkFeatures(to->second,this->outPut[o]->fromOutletID);
+        }
+    }
+
+    // the outlet feeding this analyzer
+    PatchObject *source = nullptr;
+    int sourceOutlet = -1;
+    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end() && source == nullptr; it++ ){
+        if(it->second == nullptr || it->first == this->getId() || it->second->getWillErase()){
+            continue;
+        }
+        for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
+            PatchLink *link = it->second->outPut[o];
+            if(!link->isDisabled && link->toObjectID == this->getId() && link->toInletID == 0){
+                source          = it->second;
+                sourceOutlet    = link->fromOutletID;
+                break;
+            }
+        }
+    }
+
+    // analyzers on the same outlet with the same level run one analysis (the lowest id),
+    // the smoothing comes after it and every analyzer applies its own
+    int leaderID = this->getId();
+    int features = demandedFeatures;
+    if(source != nullptr){
+        for(int o=0;o<static_cast<int>(source->outPut.size());o++){
+            PatchLink *link = source->outPut[o];
+            if(link->isDisabled || link->fromOutletID != sourceOutlet || link->toInletID != 0 || link->toObjectID == this->getId()){
+                continue;
+            }
+            map<int,PatchObject*>::iterator to = patchObjects.find(link->toObjectID);
+            if(to == patchObjects.end() || to->second == nullptr || to->second->getWillErase()){
+                continue;
+            }
+            AudioAnalyzer *other = dynamic_cast<AudioAnalyzer *>(to->second);
+            if(other != nullptr && other->getCustomVar("INPUT_LEVEL") == this->getCustomVar("INPUT_LEVEL")){
+                leaderID = std::min(leaderID,other->getId());
+                features |= other->demandedFeatures;
+            }
+        }
+    }
+
+    sharedAnalyzerID = leaderID != this->getId() ? leaderID : -1;
+    activeFeatures.store(features,std::memory_order_relaxed);
+    isShared.store(sharedAnalyzerID != -1,std::memory_order_relaxed);
+}
+
 //--------------------------------------------------------------
 void AudioAnalyzer::loadAudioSettings(){
-    ofxXmlSettings XML;
+    bool loaded = false;
+    {
+        PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+        ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
+        loaded = settings.isLoaded();
+        if (settings.isValid()){
             sampleRate = XML.getValue("sample_rate_in",0);
             bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
         }
+    }
 
+    if (loaded){
         // Beat Tracking
         beatTrack = new ofxBTrack();
         beatTrack->setup(bufferSize);
@@ -268,34 +490,22 @@ void AudioAnalyzer::loadAudioSettings(){
         audioInputLevel = this->getCustomVar("INPUT_LEVEL");
         smoothingValue = this->getCustomVar("SMOOTHING");
 
-        _outletParams[0] = new vector<float>();
-        // SIGNAL BUFFER
-        for(int i=0;i<bufferSize;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
-        }
-        // SPECTRUM
-        for(int i=0;i<(bufferSize/2)+1;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
+        // outlet frame and the worker frames share the layout
+        static_cast<AudioFeatureFrame *>(_outletParams[0])->allocate(bufferSize,(bufferSize/2)+1,MELBANDS_BANDS_NUM,DCT_COEFF_NUM,HPCP_SIZE,TRISTIMULUS_BANDS_NUM);
+        for(int i=0;i<3;i++){
+            analysisData.getSlot(i) = *static_cast<AudioFeatureFrame *>(_outletParams[0]);
         }
-        // MELBANDS
-        for(int i=0;i<MELBANDS_BANDS_NUM;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
-        }
-        // MFCC
-        for(int i=0;i<DCT_COEFF_NUM;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
-        }
-        // HPCP
-        for(int i=0;i<HPCP_SIZE;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
-        }
-        // TRISTIMULUS
-        for(int i=0;i<TRISTIMULUS_BANDS_NUM;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
-        }
-        // SINGLE VALUES (RMS, POWER, PITCH, HFC, CENTROID, INHARMONICITY, DISSONANCE, ROLLOFF, ONSET, BPM, BEAT)
-        for(int i=0;i<11;i++){
-            static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
+        rawFrame = *static_cast<AudioFeatureFrame *>(_outletParams[0]);
+
+        // analysis worker: windows of buffer_size frames every hop, fed by the sample ring
+        monoBuffer.allocate(static_cast<size_t>(bufferSize),1);
+        hopSize = std::max(bufferSize/ANALYSIS_OVERLAP,1);
+        sampleRing.allocate(static_cast<size_t>(bufferSize*ANALYSIS_OVERLAP));
+        analysisFrame = 0;
+        beatFrame = 0;
+        if(bufferSize > 0){
+            startThread();
+            analysisReady = true;
         }
     }
 }
@@ -350,3 +560,5 @@ void AudioAnalyzer::onSliderEvent(ofxDatGuiSliderEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( AudioAnalyzer, "audio analyzer", "audio_analysis", VP_OBJECT_AUDIO_IN|VP_OBJECT_GUI )
@@ -38,7 +38,15 @@
 #include "ofxBTrack.h"
 #include "ofxHistoryPlot.h"
 
-class AudioAnalyzer : public PatchObject {
+#include "TripleBuffer.h"
+#include "AudioFeatureExtractor.h"
+
+// analysis windows per window length, 2 = 50% overlap
+#define ANALYSIS_OVERLAP    2
+// how often (ms) the analyzer looks at its connections for the features to compute
+#define ANALYSIS_SCAN_TIME  250
+
+class AudioAnalyzer : public ofThread, public PatchObject {
 
 public:
 
@@ -52,6 +60,16 @@ public:
     void            audioInObject(ofSoundBuffer &inputBuffer);
 
     void            loadAudioSettings();
+    void            upgradeLinkTypes();
+    int             upgradeLinkOutlet(int oid, int inletType);
+
+    void            threadedFunction();
+    void            analyzeWindow(AudioFeatureFrame &frame, int features);
+    void            applyFeatures(int features);
+
+    static int      getLinkFeatures(PatchObject *reader, int oid);
+    void            scanConnections(map<int,PatchObject*> &patchObjects);
+    void            updateWaveform(const AudioFeatureView &signal);
 
     void            mouseMovedObjectContent(ofVec3f _m);
     void            dragGUIObject(ofVec3f _m);
@@ -63,16 +81,20 @@ public:
     ofxDatGuiHeader*                        header;
     ofxDatGuiSlider*                        inputLevel;
     ofxDatGuiSlider*                        smoothing;
-    float                                   smoothingValue;
-    float                                   audioInputLevel;
+    // written from the GUI, the level is read by the analysis worker once per window
+    std::atomic<float>                      smoothingValue;
+    std::atomic<float>                      audioInputLevel;
 
-    // Audio Input Signal variables
-    ofSoundBuffer                           lastBuffer;
-    ofSoundBuffer                           monoBuffer;
+    // Audio Input Signal variables (the audio thread only pushes to the ring)
+    ScopeRing                               sampleRing;
+    std::atomic<bool>                       analysisReady;
     ofPolyline                              waveform;
-    std::mutex                              audioMutex;
 
-    // Analysis variables
+    // Analysis variables (worker thread)
+    ofSoundBuffer                           monoBuffer;
+    uint64_t                                analysisFrame;
+    uint64_t                                beatFrame;
+    int                                     hopSize;
     ofxAudioAnalyzer                        audioAnalyzer;
     ofxBTrack                               *beatTrack;
     vector<float>                           spectrum;
@@ -84,16 +106,32 @@ public:
     float                                   power;
     float                                   pitchFreq;
     float                                   hfc;
-    float                                   centroid;
     float                                   centroidNorm;
     float                                   inharmonicity;
     float                                   dissonance;
-    float                                   rollOff;
     float                                   rollOffNorm;
     float                                   bpm;
     bool                                    beat;
     bool                                    isOnset;
 
+    // outlet layout of every analysis window, published to the update thread
+    TripleBuffer<AudioFeatureFrame>         analysisData;
+    // unsmoothed frame and its count, read by the analyzers sharing this analysis (same update level)
+    std::mutex                              frameMutex;
+    AudioFeatureFrame                       rawFrame;
+    uint64_t                                publishedFrames;
+    uint64_t                                leaderFrames;
+
+    // demand driven analysis: features wanted by this analyzer links (update thread),
+    // the ones the worker computes (ours plus the analyzers sharing it) and the ones applied to essentia
+    int                                     demandedFeatures;
+    std::atomic<int>                        activeFeatures;
+    int                                     appliedFeatures;
+    // analyzers on the same input with the same settings share the analysis of the first one
+    int                                     sharedAnalyzerID;
+    std::atomic<bool>                       isShared;
+    size_t                                  lastScanTime;
+
     size_t                                  startTime;
     bool                                    isConnected;
     bool                                    isLoaded;
@@ -0,0 +1,80 @@
+/*==============================================================================
+
+    ofxVisualProgramming: A visual programming patching environment for OF
+
+    Copyright (c) 2018 Emanuele Mazza aka n3m3da <emanuelemazza@d3cod3.org>
+
+    ofxVisualProgramming is distributed under the MIT License.
+    This gives everyone the freedoms to use ofxVisualProgramming in any context:
+    commercial or non-commercial, public or private, open or closed source.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+
+    See https://github.com/d3cod3/ofxVisualProgramming for documentation
+
+==============================================================================*/
+
+#pragma once
+
+#include "PatchObject.h"
+
+#include "AudioFeatureFrame.h"
+
+// features the extractors read, the analyzers compute only the ones asked for by their links
+enum AudioAnalyzerFeature{
+    AA_FEATURE_RMS              = 1 << 0,
+    AA_FEATURE_POWER            = 1 << 1,
+    AA_FEATURE_PITCH            = 1 << 2,
+    AA_FEATURE_HFC              = 1 << 3,
+    AA_FEATURE_CENTROID         = 1 << 4,
+    AA_FEATURE_INHARMONICITY    = 1 << 5,
+    AA_FEATURE_DISSONANCE       = 1 << 6,
+    AA_FEATURE_ROLLOFF          = 1 << 7,
+    AA_FEATURE_SPECTRUM         = 1 << 8,
+    AA_FEATURE_MELBANDS         = 1 << 9,
+    AA_FEATURE_MFCC             = 1 << 10,
+    AA_FEATURE_HPCP             = 1 << 11,
+    AA_FEATURE_TRISTIMULUS      = 1 << 12,
+    AA_FEATURE_ONSET            = 1 << 13,
+    AA_FEATURE_BPM              = 1 << 14,
+    AA_FEATURE_BEAT             = 1 << 15,
+    AA_FEATURE_ALL              = (1 << 16) - 1
+};
+
+// Base of the objects reading an audio analyzer frame: each one declares the features it reads.
+class AudioFeatureExtractor : public PatchObject {
+
+public:
+
+    AudioFeatureExtractor(int _features) : PatchObject(), features(_features) {}
+
+    int             getAudioFeatures() const { return features; }
+
+    // the analysis data was a plain vector<float> inlet
+    void            upgradeLinkTypes(){
+        if(!inlets.empty() && inlets[0] == VP_LINK_ARRAY){
+            inlets[0] = VP_LINK_AUDIOFEATURES;
+        }
+    }
+
+protected:
+
+    int             features;
+
+};
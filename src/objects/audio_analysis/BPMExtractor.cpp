@@ -33,50 +33,30 @@
 #include "BPMExtractor.h"
 
 //--------------------------------------------------------------
-BPMExtractor::BPMExtractor() : PatchObject(){
+BPMExtractor::BPMExtractor() : AudioFeatureExtractor(AA_FEATURE_BPM){
 
     this->numInlets  = 1;
     this->numOutlets = 2;
 
-    _inletParams[0] = new vector<float>();  // RAW Data
+    _inletParams[0] = new AudioFeatureFrame();  // Analysis Data
 
-    _outletParams[0] = new float(); // BPM
-    *(float *)&_outletParams[0] = 0.0f;
-    _outletParams[1] = new float(); // MS
-    *(float *)&_outletParams[1] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // BPM
+    *(float *)&_outletParams[1] = 0.0f; // MS
 
     this->initInletsState();
 
-    bufferSize = MOSAIC_DEFAULT_BUFFER_SIZE;
-    spectrumSize = (bufferSize/2) + 1;
-
-    arrayPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM + HPCP_SIZE + TRISTIMULUS_BANDS_NUM + 9;
-
-    isNewConnection   = false;
-    isConnectionRight = false;
 }
 
 //--------------------------------------------------------------
 void BPMExtractor::newObject(){
     this->setName("bpm extractor");
-    this->addInlet(VP_LINK_ARRAY,"data");
+    this->addInlet(VP_LINK_AUDIOFEATURES,"data");
     this->addOutlet(VP_LINK_NUMERIC,"bpm");
     this->addOutlet(VP_LINK_NUMERIC,"millis");
 }
 
 //--------------------------------------------------------------
 void BPMExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
-    ofxXmlSettings XML;
-
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            bufferSize = XML.getValue("buffer_size",0);
-            spectrumSize = (bufferSize/2) + 1;
-            arrayPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM + HPCP_SIZE + TRISTIMULUS_BANDS_NUM + 9;
-            XML.popTag();
-        }
-    }
-
     bpmPlot = new ofxHistoryPlot(NULL, "BPM", this->width, false);
     bpmPlot->setRange(0,200);
     bpmPlot->setColor(ofColor(255,255,255));
@@ -91,33 +71,10 @@ void BPMExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 //--------------------------------------------------------------
 void BPMExtractor::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
 
-    if(this->inletsConnected[0]){
-        if(!isNewConnection){
-            isNewConnection = true;
-            for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                if(patchObjects[it->first] != nullptr && it->first != this->getId() && !patchObjects[it->first]->getWillErase()){
-                    for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
-                        if(!it->second->outPut[o]->isDisabled && it->second->outPut[o]->toObjectID == this->getId()){
-                            if(it->second->getName() == "audio analyzer"){
-                                isConnectionRight = true;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        isNewConnection = false;
-        isConnectionRight = false;
-    }
-
-    if(this->inletsConnected[0] && !static_cast<vector<float> *>(_inletParams[0])->empty() && isConnectionRight){
-        *(float *)&_outletParams[0] = static_cast<vector<float> *>(_inletParams[0])->at(arrayPosition);
+    if(this->inletsConnected[0] && !static_cast<AudioFeatureFrame *>(_inletParams[0])->empty()){
+        *(float *)&_outletParams[0] = static_cast<AudioFeatureFrame *>(_inletParams[0])->getValue(AUDIO_FEATURE_BPM);
         bpmPlot->update(*(float *)&_outletParams[0]);
         *(float *)&_outletParams[1] = 60000.0f / *(float *)&_outletParams[0];
-    }else if(this->inletsConnected[0] && !isConnectionRight){
-        ofLog(OF_LOG_ERROR,"%s --> This object can receive data from audio analyzer object ONLY! Just reconnect it right!",this->getName().c_str());
     }
 
 }
@@ -135,3 +92,5 @@ void BPMExtractor::drawObjectContent(ofxFontStash *font){
 void BPMExtractor::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( BPMExtractor, "bpm extractor", "audio_analysis", 0 )
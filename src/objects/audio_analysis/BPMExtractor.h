@@ -32,12 +32,12 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
 #include "ofxAudioAnalyzer.h"
 #include "ofxHistoryPlot.h"
 
-class BPMExtractor : public PatchObject {
+class BPMExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -51,12 +51,4 @@ public:
 
     ofxHistoryPlot  *bpmPlot;
 
-    int             bufferSize;
-    int             spectrumSize;
-
-    int             arrayPosition;
-
-    bool            isNewConnection;
-    bool            isConnectionRight;
-
 };
@@ -33,27 +33,23 @@
 #include "BeatExtractor.h"
 
 //--------------------------------------------------------------
-BeatExtractor::BeatExtractor() : PatchObject(){
+BeatExtractor::BeatExtractor() : AudioFeatureExtractor(AA_FEATURE_BEAT){
 
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new vector<float>();  // RAW Data
+    _inletParams[0] = new AudioFeatureFrame();  // Analysis Data
 
-    _outletParams[0] = new float(); // beat
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // beat
 
     this->initInletsState();
 
-    isNewConnection   = false;
-    isConnectionRight = false;
-
 }
 
 //--------------------------------------------------------------
 void BeatExtractor::newObject(){
     this->setName("beat extractor");
-    this->addInlet(VP_LINK_ARRAY,"data");
+    this->addInlet(VP_LINK_AUDIOFEATURES,"data");
     this->addOutlet(VP_LINK_NUMERIC,"beat");
 }
 
@@ -65,31 +61,8 @@ void BeatExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 //--------------------------------------------------------------
 void BeatExtractor::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
 
-    if(this->inletsConnected[0]){
-        if(!isNewConnection){
-            isNewConnection = true;
-            for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                if(patchObjects[it->first] != nullptr && it->first != this->getId() && !patchObjects[it->first]->getWillErase()){
-                    for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
-                        if(!it->second->outPut[o]->isDisabled && it->second->outPut[o]->toObjectID == this->getId()){
-                            if(it->second->getName() == "audio analyzer"){
-                                isConnectionRight = true;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        isNewConnection = false;
-        isConnectionRight = false;
-    }
-
-    if(this->inletsConnected[0] && !static_cast<vector<float> *>(_inletParams[0])->empty() && isConnectionRight){
-        *(float *)&_outletParams[0] = static_cast<vector<float> *>(_inletParams[0])->back();
-    }else if(this->inletsConnected[0] && !isConnectionRight){
-        ofLog(OF_LOG_ERROR,"%s --> This object can receive data from audio analyzer object ONLY! Just reconnect it right!",this->getName().c_str());
+    if(this->inletsConnected[0] && !static_cast<AudioFeatureFrame *>(_inletParams[0])->empty()){
+        *(float *)&_outletParams[0] = static_cast<AudioFeatureFrame *>(_inletParams[0])->getValue(AUDIO_FEATURE_BEAT);
     }
 
 }
@@ -109,3 +82,5 @@ void BeatExtractor::drawObjectContent(ofxFontStash *font){
 void BeatExtractor::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( BeatExtractor, "beat extractor", "audio_analysis", 0 )
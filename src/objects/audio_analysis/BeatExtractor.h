@@ -32,9 +32,9 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
-class BeatExtractor : public PatchObject {
+class BeatExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -48,7 +48,4 @@ public:
 
     bool            beat;
 
-    bool            isNewConnection;
-    bool            isConnectionRight;
-
 };
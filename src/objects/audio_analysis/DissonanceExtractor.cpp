@@ -33,47 +33,28 @@
 #include "DissonanceExtractor.h"
 
 //--------------------------------------------------------------
-DissonanceExtractor::DissonanceExtractor() : PatchObject(){
+DissonanceExtractor::DissonanceExtractor() : AudioFeatureExtractor(AA_FEATURE_DISSONANCE){
 
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new vector<float>();  // RAW Data
+    _inletParams[0] = new AudioFeatureFrame();  // Analysis Data
 
-    _outletParams[0] = new float(); // Dissonance
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // Dissonance
 
     this->initInletsState();
 
-    bufferSize = MOSAIC_DEFAULT_BUFFER_SIZE;
-    spectrumSize = (bufferSize/2) + 1;
-
-    arrayPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM + HPCP_SIZE + TRISTIMULUS_BANDS_NUM + 6;
-
-    isNewConnection   = false;
-    isConnectionRight = false;
 }
 
 //--------------------------------------------------------------
 void DissonanceExtractor::newObject(){
     this->setName("dissonance extractor");
-    this->addInlet(VP_LINK_ARRAY,"data");
+    this->addInlet(VP_LINK_AUDIOFEATURES,"data");
     this->addOutlet(VP_LINK_NUMERIC,"dissonance");
 }
 
 //--------------------------------------------------------------
 void DissonanceExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
-    ofxXmlSettings XML;
-
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            bufferSize = XML.getValue("buffer_size",0);
-            spectrumSize = (bufferSize/2) + 1;
-            arrayPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM + HPCP_SIZE + TRISTIMULUS_BANDS_NUM + 6;
-            XML.popTag();
-        }
-    }
-
     gui = new ofxDatGui( ofxDatGuiAnchor::TOP_RIGHT );
     gui->setAutoDraw(false);
     gui->setWidth(this->width);
@@ -91,31 +72,8 @@ void DissonanceExtractor::updateObjectContent(map<int,PatchObject*> &patchObject
     gui->update();
     rPlotter->setValue(*(float *)&_outletParams[0]);
 
-    if(this->inletsConnected[0]){
-        if(!isNewConnection){
-            isNewConnection = true;
-            for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                if(patchObjects[it->first] != nullptr && it->first != this->getId() && !patchObjects[it->first]->getWillErase()){
-                    for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
-                        if(!it->second->outPut[o]->isDisabled && it->second->outPut[o]->toObjectID == this->getId()){
-                            if(it->second->getName() == "audio analyzer"){
-                                isConnectionRight = true;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        isNewConnection = false;
-        isConnectionRight = false;
-    }
-
-    if(this->inletsConnected[0] && !static_cast<vector<float> *>(_inletParams[0])->empty() && isConnectionRight){
-        *(float *)&_outletParams[0] = static_cast<vector<float> *>(_inletParams[0])->at(arrayPosition);
-    }else if(this->inletsConnected[0] && !isConnectionRight){
-        ofLog(OF_LOG_ERROR,"%s --> This object can receive data from audio analyzer object ONLY! Just reconnect it right!",this->getName().c_str());
+    if(this->inletsConnected[0] && !static_cast<AudioFeatureFrame *>(_inletParams[0])->empty()){
+        *(float *)&_outletParams[0] = static_cast<AudioFeatureFrame *>(_inletParams[0])->getValue(AUDIO_FEATURE_DISSONANCE);
     }
 
 }
@@ -133,3 +91,5 @@ void DissonanceExtractor::drawObjectContent(ofxFontStash *font){
 void DissonanceExtractor::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( DissonanceExtractor, "dissonance extractor", "audio_analysis", VP_OBJECT_GUI )
@@ -33,40 +33,38 @@
 #include "FftExtractor.h"
 
 //--------------------------------------------------------------
-FftExtractor::FftExtractor() : PatchObject(){
+FftExtractor::FftExtractor() : AudioFeatureExtractor(AA_FEATURE_SPECTRUM){
 
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new vector<float>();  // RAW Data
+    _inletParams[0] = new AudioFeatureFrame();  // Analysis Data
 
     _outletParams[0] = new vector<float>();  // FFT Data
 
     this->initInletsState();
+
     
     bufferSize = MOSAIC_DEFAULT_BUFFER_SIZE;
     spectrumSize = (bufferSize/2) + 1;
-
-    isNewConnection   = false;
-    isConnectionRight = false;
 }
 
 //--------------------------------------------------------------
 void FftExtractor::newObject(){
     this->setName("fft extractor");
-    this->addInlet(VP_LINK_ARRAY,"data");
+    this->addInlet(VP_LINK_AUDIOFEATURES,"data");
     this->addOutlet(VP_LINK_ARRAY,"fft");
 }
 
 //--------------------------------------------------------------
 void FftExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
-    ofxXmlSettings XML;
+    {
+        PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+        ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
+        if (settings.isValid()){
             bufferSize = XML.getValue("buffer_size",0);
             spectrumSize = (bufferSize/2) + 1;
-            XML.popTag();
         }
     }
 
@@ -80,35 +78,9 @@ void FftExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 //--------------------------------------------------------------
 void FftExtractor::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
 
-    if(this->inletsConnected[0]){
-        if(!isNewConnection){
-            isNewConnection = true;
-            for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                if(patchObjects[it->first] != nullptr && it->first != this->getId() && !patchObjects[it->first]->getWillErase()){
-                    for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
-                        if(!it->second->outPut[o]->isDisabled && it->second->outPut[o]->toObjectID == this->getId()){
-                            if(it->second->getName() == "audio analyzer"){
-                                isConnectionRight = true;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        isNewConnection = false;
-        isConnectionRight = false;
-    }
-
-    if(this->inletsConnected[0] && !static_cast<vector<float> *>(_inletParams[0])->empty() && isConnectionRight){
-        int index = 0;
-        for(int i=bufferSize;i<bufferSize + spectrumSize;i++){
-            static_cast<vector<float> *>(_outletParams[0])->at(index) = static_cast<vector<float> *>(_inletParams[0])->at(i);
-            index++;
-        }
-    }else if(this->inletsConnected[0] && !isConnectionRight){
-        ofLog(OF_LOG_ERROR,"%s --> This object can receive data from audio analyzer object ONLY! Just reconnect it right!",this->getName().c_str());
+    if(this->inletsConnected[0] && !static_cast<AudioFeatureFrame *>(_inletParams[0])->empty()){
+        AudioFeatureView spectrum = static_cast<AudioFeatureFrame *>(_inletParams[0])->getSpectrum();
+        static_cast<vector<float> *>(_outletParams[0])->assign(spectrum.begin(),spectrum.end());
     }
 
 }
@@ -132,3 +104,5 @@ void FftExtractor::drawObjectContent(ofxFontStash *font){
 void FftExtractor::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( FftExtractor, "fft extractor", "audio_analysis", 0 )
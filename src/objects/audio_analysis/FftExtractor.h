@@ -32,9 +32,9 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
-class FftExtractor : public PatchObject {
+class FftExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -50,7 +50,4 @@ public:
     int             bufferSize;
     int             spectrumSize;
 
-    bool            isNewConnection;
-    bool            isConnectionRight;
-
 };
@@ -32,11 +32,11 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
 #include "ofxAudioAnalyzer.h"
 
-class HFCExtractor : public PatchObject {
+class HFCExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -51,12 +51,4 @@ public:
     ofxDatGui*              gui;
     ofxDatGuiValuePlotter*  rPlotter;
 
-    int             bufferSize;
-    int             spectrumSize;
-
-    int             arrayPosition;
-
-    bool            isNewConnection;
-    bool            isConnectionRight;
-
 };
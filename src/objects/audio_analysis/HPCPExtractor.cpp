@@ -33,48 +33,28 @@
 #include "HPCPExtractor.h"
 
 //--------------------------------------------------------------
-HPCPExtractor::HPCPExtractor() : PatchObject(){
+HPCPExtractor::HPCPExtractor() : AudioFeatureExtractor(AA_FEATURE_HPCP){
 
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new vector<float>();  // RAW Data
+    _inletParams[0] = new AudioFeatureFrame();  // Analysis Data
 
     _outletParams[0] = new vector<float>();  // HPCP Data
 
     this->initInletsState();
 
-    bufferSize = MOSAIC_DEFAULT_BUFFER_SIZE;
-    spectrumSize = (bufferSize/2) + 1;
-
-    startPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM;
-    endPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM + HPCP_SIZE;
-
-    isNewConnection   = false;
-    isConnectionRight = false;
 }
 
 //--------------------------------------------------------------
 void HPCPExtractor::newObject(){
     this->setName("hpcp extractor");
-    this->addInlet(VP_LINK_ARRAY,"data");
+    this->addInlet(VP_LINK_AUDIOFEATURES,"data");
     this->addOutlet(VP_LINK_ARRAY,"harmonicPitchClassProfile");
 }
 
 //--------------------------------------------------------------
 void HPCPExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
-    ofxXmlSettings XML;
-
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            bufferSize = XML.getValue("buffer_size",0);
-            spectrumSize = (bufferSize/2) + 1;
-            startPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM;
-            endPosition = bufferSize + spectrumSize + MELBANDS_BANDS_NUM + DCT_COEFF_NUM + HPCP_SIZE;
-            XML.popTag();
-        }
-    }
-
     // INIT FFT BUFFER
     for(int i=0;i<HPCP_SIZE;i++){
         static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
@@ -85,35 +65,9 @@ void HPCPExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 //--------------------------------------------------------------
 void HPCPExtractor::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
 
-    if(this->inletsConnected[0]){
-        if(!isNewConnection){
-            isNewConnection = true;
-            for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                if(patchObjects[it->first] != nullptr && it->first != this->getId() && !patchObjects[it->first]->getWillErase()){
-                    for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
-                        if(!it->second->outPut[o]->isDisabled && it->second->outPut[o]->toObjectID == this->getId()){
-                            if(it->second->getName() == "audio analyzer"){
-                                isConnectionRight = true;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        isNewConnection = false;
-        isConnectionRight = false;
-    }
-
-    if(this->inletsConnected[0] && !static_cast<vector<float> *>(_inletParams[0])->empty() && isConnectionRight){
-        int index = 0;
-        for(int i=startPosition;i<endPosition;i++){
-            static_cast<vector<float> *>(_outletParams[0])->at(index) = static_cast<vector<float> *>(_inletParams[0])->at(i);
-            index++;
-        }
-    }else if(this->inletsConnected[0] && !isConnectionRight){
-        ofLog(OF_LOG_ERROR,"%s --> This object can receive data from audio analyzer object ONLY! Just reconnect it right!",this->getName().c_str());
+    if(this->inletsConnected[0] && !static_cast<AudioFeatureFrame *>(_inletParams[0])->empty()){
+        AudioFeatureView hpcp = static_cast<AudioFeatureFrame *>(_inletParams[0])->getHPCP();
+        static_cast<vector<float> *>(_outletParams[0])->assign(hpcp.begin(),hpcp.end());
     }
 
 }
@@ -137,3 +91,5 @@ void HPCPExtractor::drawObjectContent(ofxFontStash *font){
 void HPCPExtractor::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( HPCPExtractor, "hpcp extractor", "audio_analysis", 0 )
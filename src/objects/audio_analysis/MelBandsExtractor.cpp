@@ -33,43 +33,30 @@
 #include "MelBandsExtractor.h"
 
 //--------------------------------------------------------------
-MelBandsExtractor::MelBandsExtractor() : PatchObject(){
+MelBandsExtractor::MelBandsExtractor() : AudioFeatureExtractor(AA_FEATURE_MELBANDS){
 
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new vector<float>();  // RAW Data
+    _inletParams[0] = new AudioFeatureFrame();  // Analysis Data
 
     _outletParams[0] = new vector<float>();  // MEL bands Data
 
     this->initInletsState();
+
     
-    bufferSize = MOSAIC_DEFAULT_BUFFER_SIZE;
-    spectrumSize = (bufferSize/2) + 1;
 
-    isNewConnection   = false;
-    isConnectionRight = false;
 }
 
 //--------------------------------------------------------------
 void MelBandsExtractor::newObject(){
     this->setName("mel bands extractor");
-    this->addInlet(VP_LINK_ARRAY,"data");
+    this->addInlet(VP_LINK_AUDIOFEATURES,"data");
     this->addOutlet(VP_LINK_ARRAY,"melBandsSpectralEnergy");
 }
 
 //--------------------------------------------------------------
 void MelBandsExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
-    ofxXmlSettings XML;
-
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            bufferSize = XML.getValue("buffer_size",0);
-            spectrumSize = (bufferSize/2) + 1;
-            XML.popTag();
-        }
-    }
-
     // INIT FFT BUFFER
     for(int i=0;i<MELBANDS_BANDS_NUM;i++){
         static_cast<vector<float> *>(_outletParams[0])->push_back(0.0f);
@@ -80,35 +67,9 @@ void MelBandsExtractor::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWind
 //--------------------------------------------------------------
 void MelBandsExtractor::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
 
-    if(this->inletsConnected[0]){
-        if(!isNewConnection){
-            isNewConnection = true;
-            for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                if(patchObjects[it->first] != nullptr && it->first != this->getId() && !patchObjects[it->first]->getWillErase()){
-                    for(int o=0;o<static_cast<int>(it->second->outPut.size());o++){
-                        if(!it->second->outPut[o]->isDisabled && it->second->outPut[o]->toObjectID == this->getId()){
-                            if(it->second->getName() == "audio analyzer"){
-                                isConnectionRight = true;
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-    }else{
-        isNewConnection = false;
-        isConnectionRight = false;
-    }
-
-    if(this->inletsConnected[0] && !static_cast<vector<float> *>(_inletParams[0])->empty() && isConnectionRight){
-        int index = 0;
-        for(int i=bufferSize + spectrumSize;i<bufferSize + spectrumSize + MELBANDS_BANDS_NUM;i++){
-            static_cast<vector<float> *>(_outletParams[0])->at(index) = static_cast<vector<float> *>(_inletParams[0])->at(i);
-            index++;
-        }
-    }else if(this->inletsConnected[0] && !isConnectionRight){
-        ofLog(OF_LOG_ERROR,"%s --> This object can receive data from audio analyzer object ONLY! Just reconnect it right!",this->getName().c_str());
+    if(this->inletsConnected[0] && !static_cast<AudioFeatureFrame *>(_inletParams[0])->empty()){
+        AudioFeatureView melBands = static_cast<AudioFeatureFrame *>(_inletParams[0])->getMelBands();
+        static_cast<vector<float> *>(_outletParams[0])->assign(melBands.begin(),melBands.end());
     }
 
 }
@@ -132,3 +93,5 @@ void MelBandsExtractor::drawObjectContent(ofxFontStash *font){
 void MelBandsExtractor::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( MelBandsExtractor, "mel bands extractor", "audio_analysis", 0 )
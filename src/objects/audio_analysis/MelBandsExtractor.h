@@ -32,11 +32,11 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
 #include "ofxAudioAnalyzer.h"
 
-class MelBandsExtractor : public PatchObject {
+class MelBandsExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -49,10 +49,5 @@ public:
     void            removeObjectContent();
 
     
-    int             bufferSize;
-    int             spectrumSize;
-
-    bool            isNewConnection;
-    bool            isConnectionRight;
 
 };
@@ -32,11 +32,11 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
 #include "ofxAudioAnalyzer.h"
 
-class OnsetExtractor : public PatchObject {
+class OnsetExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -50,12 +50,4 @@ public:
 
     bool            onset;
 
-    int             bufferSize;
-    int             spectrumSize;
-
-    int             arrayPosition;
-
-    bool            isNewConnection;
-    bool            isConnectionRight;
-
 };
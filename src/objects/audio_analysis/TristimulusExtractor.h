@@ -32,11 +32,11 @@
 
 #pragma once
 
-#include "PatchObject.h"
+#include "AudioFeatureExtractor.h"
 
 #include "ofxAudioAnalyzer.h"
 
-class TristimulusExtractor : public PatchObject {
+class TristimulusExtractor : public AudioFeatureExtractor {
 
 public:
 
@@ -48,14 +48,4 @@ public:
     void            drawObjectContent(ofxFontStash *font);
     void            removeObjectContent();
 
-
-    int             bufferSize;
-    int             spectrumSize;
-
-    int             startPosition;
-    int             endPosition;
-
-    bool            isNewConnection;
-    bool            isConnectionRight;
-
 };
@@ -319,3 +319,5 @@ void ArduinoSerial::onDropdownEvent(ofxDatGuiDropdownEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( ArduinoSerial, "arduino serial", "communications", VP_OBJECT_GL )
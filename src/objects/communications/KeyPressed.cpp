@@ -38,8 +38,7 @@ KeyPressed::KeyPressed() : PatchObject(){
     this->numInlets  = 0;
     this->numOutlets = 1;
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -150,3 +149,5 @@ void KeyPressed::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( KeyPressed, "key pressed", "communications", VP_OBJECT_GL )
@@ -38,15 +38,11 @@ MidiKey::MidiKey() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // pitch (index)
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // velocity
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // pitch (index)
+    *(float *)&_inletParams[1] = 0.0f;  // velocity
 
-    _outletParams[0] = new float(); // pitch
-    *(float *)&_outletParams[0] = 0.0f;
-    _outletParams[1] = new float(); // velocity
-    *(float *)&_outletParams[1] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // pitch
+    *(float *)&_outletParams[1] = 0.0f; // velocity
 
     this->initInletsState();
 
@@ -161,3 +157,5 @@ void MidiKey::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( MidiKey, "midi key", "communications", VP_OBJECT_GL )
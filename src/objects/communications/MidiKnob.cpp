@@ -38,13 +38,10 @@ MidiKnob::MidiKnob() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // control
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // value
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // control
+    *(float *)&_inletParams[1] = 0.0f;  // value
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -201,3 +198,5 @@ void MidiKnob::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( MidiKnob, "midi knob", "communications", VP_OBJECT_GL )
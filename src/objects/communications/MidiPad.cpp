@@ -38,17 +38,12 @@ MidiPad::MidiPad() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // pitch (index)
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // value
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();  // velocity
-    *(float *)&_inletParams[2] = 0.0f;
-
-    _outletParams[0] = new float(); // value
-    *(float *)&_outletParams[0] = 0.0f;
-    _outletParams[1] = new float(); // velocity
-    *(float *)&_outletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // pitch (index)
+    *(float *)&_inletParams[1] = 0.0f;  // value
+    *(float *)&_inletParams[2] = 0.0f;  // velocity
+
+    *(float *)&_outletParams[0] = 0.0f; // value
+    *(float *)&_outletParams[1] = 0.0f; // velocity
 
     this->initInletsState();
 
@@ -171,3 +166,5 @@ void MidiPad::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( MidiPad, "midi pad", "communications", VP_OBJECT_GL )
@@ -38,16 +38,11 @@ MidiReceiver::MidiReceiver() : PatchObject(){
     this->numInlets  = 0;
     this->numOutlets = 5;
 
-    _outletParams[0] = new float();         // channel
-    *(float *)&_outletParams[0] = 0.0f;
-    _outletParams[1] = new float();         // control
-    *(float *)&_outletParams[1] = 0.0f;
-    _outletParams[2] = new float();         // value
-    *(float *)&_outletParams[2] = 0.0f;
-    _outletParams[3] = new float();         // pitch
-    *(float *)&_outletParams[3] = 0.0f;
-    _outletParams[4] = new float();         // velocity
-    *(float *)&_outletParams[4] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f;         // channel
+    *(float *)&_outletParams[1] = 0.0f;         // control
+    *(float *)&_outletParams[2] = 0.0f;         // value
+    *(float *)&_outletParams[3] = 0.0f;         // pitch
+    *(float *)&_outletParams[4] = 0.0f;         // velocity
 
     this->initInletsState();
 
@@ -134,6 +129,22 @@ void MidiReceiver::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxT
 
     if(midiDevicesList.size() > 0){
         if(midiIn.isOpen()){
+            tempMidiQueue.clear();
+            {
+                std::unique_lock<std::mutex> lock(midiMutex);
+                tempMidiQueue.swap(midiQueue);
+            }
+            // every message as events, in order, the outlets values keep the last one
+            for(size_t i=0;i<tempMidiQueue.size();i++){
+                const ofxMidiMessage &msg = tempMidiQueue.at(i).second;
+                uint64_t time = tempMidiQueue.at(i).first;
+                this->pushOutletEvent(0,msg.channel,time);
+                this->pushOutletEvent(1,msg.control,time);
+                this->pushOutletEvent(2,msg.value,time);
+                this->pushOutletEvent(3,msg.pitch,time);
+                this->pushOutletEvent(4,msg.velocity,time);
+                lastMessage = msg;
+            }
             *(float *)&_outletParams[0] = lastMessage.channel;
             *(float *)&_outletParams[1] = lastMessage.control;
             *(float *)&_outletParams[2] = lastMessage.value;
@@ -263,5 +274,8 @@ void MidiReceiver::onMatrixEvent(ofxDatGuiMatrixEvent e){
 //--------------------------------------------------------------
 void MidiReceiver::newMidiMessage(ofxMidiMessage& msg){
     //ofLog(OF_LOG_NOTICE,"%s",msg.toString().c_str());
-    lastMessage = msg;
+    std::unique_lock<std::mutex> lock(midiMutex);
+    midiQueue.push_back(make_pair(PatchClock::getInstance().getElapsedTimeMicros(),msg));
 }
+
+OBJECT_REGISTER( MidiReceiver, "midi receiver", "communications", VP_OBJECT_GL )
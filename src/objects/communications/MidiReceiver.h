@@ -60,6 +60,10 @@ public:
 
     ofxMidiIn               midiIn;
     ofxMidiMessage          lastMessage;
+    // messages received on the midi thread since the last update, timestamped with the patch clock
+    vector<pair<uint64_t,ofxMidiMessage>>   midiQueue;
+    vector<pair<uint64_t,ofxMidiMessage>>   tempMidiQueue;
+    std::mutex              midiMutex;
     vector<string>          midiDevicesList;
     int                     midiDeviceID;
 
@@ -40,10 +40,8 @@ MidiScore::MidiScore() : PatchObject(){
 
     _inletParams[0] = new vector<float>();  // midi notes vector
 
-    _outletParams[0] = new float(); // trigger
-    *(float *)&_outletParams[0] = 0.0f;
-    _outletParams[1] = new float(); // note
-    *(float *)&_outletParams[1] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // trigger
+    *(float *)&_outletParams[1] = 0.0f; // note
 
     this->initInletsState();
 
@@ -107,3 +105,5 @@ void MidiScore::drawObjectContent(ofxFontStash *font){
 void MidiScore::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( MidiScore, "midi score", "communications", VP_OBJECT_GL )
@@ -38,14 +38,10 @@ MidiSender::MidiSender() : PatchObject(){
     this->numInlets  = 4;
     this->numOutlets = 0;
 
-    _inletParams[0] = new float();         // trigger
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();         // channel
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();         // note
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();         // velocity
-    *(float *)&_inletParams[3] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;         // trigger
+    *(float *)&_inletParams[1] = 0.0f;         // channel
+    *(float *)&_inletParams[2] = 0.0f;         // note
+    *(float *)&_inletParams[3] = 0.0f;         // velocity
 
     this->initInletsState();
 
@@ -103,6 +99,7 @@ void MidiSender::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
     // open port by number
     if(midiDevicesList.size() > 0){
         midiOut.openPort(midiDeviceID);
+        midiQueue.start();
         midiDeviceName->setLabel(midiOut.getOutPortName(midiDeviceID));
 
         deviceSelector = gui->addMatrix("DEVICE",midiDevicesList.size(),true);
@@ -135,17 +132,14 @@ void MidiSender::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThr
                     trigger = false;
                 }
 
-                if(*(float *)&_inletParams[0] != 0.0f && !trigger){
-                    trigger = true;
-                    midiOut.sendNoteOn(static_cast<int>(floor(*(float *)&_inletParams[1])),static_cast<int>(floor(*(float *)&_inletParams[2])),static_cast<int>(floor(*(float *)&_inletParams[3])));
-                }
-
-                if(*(float *)&_inletParams[0] == 0.0f && trigger){
-                    trigger = false;
-                    for(int i=0;i<128;i++){
-                        midiOut.sendNoteOff(static_cast<int>(floor(*(float *)&_inletParams[1])),i,0);
+                // every trigger event (bangs) is a note, sent at its own time,
+                // without events the trigger inlet is read as a gate level
+                if(this->getInletEvents(0,triggerEvents)){
+                    for(size_t i=0;i<triggerEvents.size();i++){
+                        sendTrigger(triggerEvents.at(i).value,triggerEvents.at(i).time,true);
                     }
-
+                }else{
+                    sendTrigger(*(float *)&_inletParams[0],PatchClock::getInstance().getElapsedTimeMicros(),false);
                 }
 
                 lastNote = *(float *)&_inletParams[2];
@@ -155,6 +149,26 @@ void MidiSender::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThr
 
 }
 
+//--------------------------------------------------------------
+void MidiSender::sendTrigger(float value, uint64_t time, bool retrigger){
+    int channel     = static_cast<int>(floor(*(float *)&_inletParams[1]));
+    int note        = static_cast<int>(floor(*(float *)&_inletParams[2]));
+    int velocity    = static_cast<int>(floor(*(float *)&_inletParams[3]));
+
+    // midi goes out from the control thread, at the event time plus the output latency
+    if(value != 0.0f && (!trigger || retrigger)){
+        trigger = true;
+        midiQueue.push(time,[this,channel,note,velocity](){ midiOut.sendNoteOn(channel,note,velocity); });
+    }else if(value == 0.0f && trigger){
+        trigger = false;
+        midiQueue.push(time,[this,channel](){
+            for(int i=0;i<128;i++){
+                midiOut.sendNoteOff(channel,i,0);
+            }
+        });
+    }
+}
+
 //--------------------------------------------------------------
 void MidiSender::drawObjectContent(ofxFontStash *font){
     ofSetColor(30,31,36);
@@ -178,6 +192,7 @@ void MidiSender::drawObjectContent(ofxFontStash *font){
 
 //--------------------------------------------------------------
 void MidiSender::removeObjectContent(){
+    midiQueue.stop();
     if(midiDevicesList.size() > 0){
         if(midiOut.isOpen()){
             midiOut.closePort();
@@ -242,8 +257,11 @@ void MidiSender::resetMIDISettings(int devID){
         }
         this->setCustomVar(static_cast<float>(midiDeviceID),"DEVICE_ID");
 
-        midiOut.closePort();
-        midiOut.openPort(midiDeviceID);
+        {
+            std::unique_lock<std::mutex> lock(midiQueue.getMutex());
+            midiOut.closePort();
+            midiOut.openPort(midiDeviceID);
+        }
 
         if(midiOut.isOpen()){
             ofLog(OF_LOG_NOTICE,"MIDI device %s connected!", midiOut.getOutPortName(devID).c_str());
@@ -263,3 +281,5 @@ void MidiSender::onMatrixEvent(ofxDatGuiMatrixEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( MidiSender, "midi sender", "communications", VP_OBJECT_GL )
@@ -52,6 +52,7 @@ public:
     void            dragGUIObject(ofVec3f _m);
 
     void            resetMIDISettings(int devID);
+    void            sendTrigger(float value, uint64_t time, bool retrigger);
 
     void            onMatrixEvent(ofxDatGuiMatrixEvent e);
     
@@ -68,4 +69,7 @@ public:
     bool                    trigger;
     float                   lastNote;
 
+    ControlOutputQueue      midiQueue;
+    vector<PatchEvent>      triggerEvents;
+
 };
@@ -239,7 +239,6 @@ void OscReceiver::dragGUIObject(ofVec3f _m){
 void OscReceiver::onButtonEvent(ofxDatGuiButtonEvent e){
     if(!header->getIsCollapsed()){
         if(e.target == addOSCNumber){
-            _outletParams[this->numOutlets] = new float();
             *(float *)&_outletParams[this->numOutlets] = 0.0f;
             this->addOutlet(VP_LINK_NUMERIC,"number");
 
@@ -335,7 +334,7 @@ void OscReceiver::onTextInputEvent(ofxDatGuiTextInputEvent e){
 //--------------------------------------------------------------
 void OscReceiver::initOutlets(){
     ofxXmlSettings XML;
-    if(XML.loadFile(this->patchFile)){
+    if(PatchDocument::getInstance().load(this->patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
 
         // Load object outlet config
@@ -362,7 +361,6 @@ void OscReceiver::initOutlets(){
                             if(XML.pushTag("var",t)){
                                 if(XML.getValue("name","") != "PORT"){
                                     if(tempTypes.at(tempCounter) == 0){
-                                        _outletParams[tempCounter] = new float();
                                         *(float *)&_outletParams[tempCounter] = 0.0f;
                                         ofxDatGuiTextInput* temp;
                                         temp = gui->addTextInput("N",XML.getValue("name",""));
@@ -427,7 +425,7 @@ void OscReceiver::resetOutlets(){
     gui->setPosition(0,this->height - header->getHeight());
 
     ofxXmlSettings XML;
-    if(XML.loadFile(this->patchFile)){
+    if(PatchDocument::getInstance().load(this->patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
 
         // Save new object outlet config
@@ -452,7 +450,7 @@ void OscReceiver::resetOutlets(){
             }
         }
 
-        XML.saveFile();
+        PatchDocument::getInstance().save(patchFile,XML);
     }
 
     this->saveConfig(false,this->nId);
@@ -502,3 +500,5 @@ string OscReceiver::getLocalIP(){
 
     return IP;
 }
+
+OBJECT_REGISTER( OscReceiver, "osc receiver", "communications", VP_OBJECT_GL )
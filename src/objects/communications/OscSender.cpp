@@ -110,6 +110,7 @@ void OscSender::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
     osc_host = filepath;
     osc_port = static_cast<int>(floor(this->getCustomVar("PORT")));
     osc_sender.setup(osc_host.c_str(),osc_port);
+    oscQueue.start();
 
 }
 
@@ -129,12 +130,21 @@ void OscSender::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
         labels.at(l)->update();
     }
 
+    uint64_t now = PatchClock::getInstance().getElapsedTimeMicros();
     for(int i=0;i<this->getNumInlets();i++){
         if(this->inletsConnected[i]){
             ofxOscMessage m;
             bool messageOK = false;
             m.setAddress(osc_labels.at(i));
-            if(this->getInletType(i) == VP_LINK_NUMERIC){
+            if(this->getInletType(i) == VP_LINK_NUMERIC && this->getInletEvents(i,inletEvents)){
+                // one message for every event, at its own time
+                for(size_t e=0;e<inletEvents.size();e++){
+                    ofxOscMessage em;
+                    em.setAddress(osc_labels.at(i));
+                    em.addFloatArg(inletEvents.at(e).value);
+                    sendMessage(em,inletEvents.at(e).time);
+                }
+            }else if(this->getInletType(i) == VP_LINK_NUMERIC){
                 m.addFloatArg(*(float *)&_inletParams[i]);
                 messageOK = true;
             }else if(this->getInletType(i) == VP_LINK_STRING){
@@ -157,7 +167,7 @@ void OscSender::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
                     depth = 4;
                 }
                 if(static_cast<ofTexture *>(_inletParams[i])->getWidth()*static_cast<ofTexture *>(_inletParams[i])->getHeight()*depth < 327680){
-                    static_cast<ofTexture *>(_inletParams[i])->readToPixels(*_tempPixels);
+                    TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[i]),*_tempPixels);
                     m.addFloatArg(static_cast<ofTexture *>(_inletParams[i])->getWidth());
                     m.addFloatArg(static_cast<ofTexture *>(_inletParams[i])->getHeight());
                     if(static_cast<ofTexture *>(_inletParams[i])->getTextureData().glInternalFormat == GL_LUMINANCE || static_cast<ofTexture *>(_inletParams[i])->getTextureData().glInternalFormat == GL_LUMINANCE8 || static_cast<ofTexture *>(_inletParams[i])->getTextureData().glInternalFormat == GL_LUMINANCE16 || static_cast<ofTexture *>(_inletParams[i])->getTextureData().glInternalFormat == GL_LUMINANCE32F_ARB){
@@ -179,13 +189,19 @@ void OscSender::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
                 }
             }
             if(messageOK){
-                osc_sender.sendMessage(m,false);
+                sendMessage(m,now);
             }
         }
     }
 
 }
 
+//--------------------------------------------------------------
+void OscSender::sendMessage(const ofxOscMessage &m, uint64_t time){
+    // sent from the control thread, at the event time plus the output latency
+    oscQueue.push(time,[this,m](){ osc_sender.sendMessage(m,false); });
+}
+
 //--------------------------------------------------------------
 void OscSender::drawObjectContent(ofxFontStash *font){
     ofSetColor(255);
@@ -196,6 +212,7 @@ void OscSender::drawObjectContent(ofxFontStash *font){
 
 //--------------------------------------------------------------
 void OscSender::removeObjectContent(){
+    oscQueue.stop();
 
 }
 
@@ -260,7 +277,7 @@ void OscSender::dragGUIObject(ofVec3f _m){
 //--------------------------------------------------------------
 void OscSender::initInlets(){
     ofxXmlSettings XML;
-    if(XML.loadFile(this->patchFile)){
+    if(PatchDocument::getInstance().load(this->patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
 
         // Get object inlets config
@@ -287,7 +304,6 @@ void OscSender::initInlets(){
                             if(XML.pushTag("var",t)){
                                 if(XML.getValue("name","") != "PORT"){
                                     if(tempTypes.at(tempCounter) == 0){ // float
-                                        _inletParams[tempCounter] = new float();
                                         *(float *)&_inletParams[tempCounter] = 0.0f;
                                         ofxDatGuiTextInput* temp;
                                         temp = gui->addTextInput("N",XML.getValue("name",""));
@@ -344,7 +360,6 @@ void OscSender::initInlets(){
 void OscSender::onButtonEvent(ofxDatGuiButtonEvent e){
     if(!header->getIsCollapsed()){
         if(e.target == addOSCNumber){
-            _inletParams[this->numInlets] = new float();
             *(float *)&_inletParams[this->numInlets] = 0.0f;
             this->addInlet(VP_LINK_NUMERIC,"number");
             this->inletsConnected.push_back(false);
@@ -423,11 +438,13 @@ void OscSender::onTextInputEvent(ofxDatGuiTextInputEvent e){
         if(e.target == host){
             osc_host = e.text;
             filepath = osc_host;
+            std::unique_lock<std::mutex> lock(oscQueue.getMutex());
             osc_sender.setup(osc_host.c_str(),osc_port);
         }else if(e.target == port){
             if(isInteger(e.text)){
                 this->setCustomVar(static_cast<float>(ofToInt(e.text)),"PORT");
                 osc_port = ofToInt(e.text);
+                std::unique_lock<std::mutex> lock(oscQueue.getMutex());
                 osc_sender.setup(osc_host.c_str(),osc_port);
             }else{
                 port->setText(ofToString(osc_port));
@@ -444,3 +461,5 @@ void OscSender::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( OscSender, "osc sender", "communications", VP_OBJECT_GL )
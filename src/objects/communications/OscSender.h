@@ -52,11 +52,14 @@ public:
     void            dragGUIObject(ofVec3f _m);
 
     void            initInlets();
+    void            sendMessage(const ofxOscMessage &m, uint64_t time);
 
     void            onButtonEvent(ofxDatGuiButtonEvent e);
     void            onTextInputEvent(ofxDatGuiTextInputEvent e);
 
     ofxOscSender            osc_sender;
+    ControlOutputQueue      oscQueue;
+    vector<PatchEvent>      inletEvents;
     string                  osc_host;
     int                     osc_port;
     vector<string>          osc_labels;
@@ -42,8 +42,7 @@ BackgroundSubtraction::BackgroundSubtraction() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofTexture();  // input
-    _inletParams[1] = new float();  // bang
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // bang
 
     _outletParams[0] = new ofTexture(); // output
 
@@ -161,7 +160,7 @@ void BackgroundSubtraction::updateObjectContent(map<int,PatchObject*> &patchObje
             resetTextures(static_cast<int>(floor(static_cast<ofTexture *>(_inletParams[0])->getWidth())),static_cast<int>(floor(static_cast<ofTexture *>(_inletParams[0])->getHeight())));
         }
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
         colorImg->setFromPixels(*pix);
         colorImg->updateTexture();
@@ -370,3 +369,5 @@ void BackgroundSubtraction::onMatrixEvent(ofxDatGuiMatrixEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( BackgroundSubtraction, "background subtraction", "computer vision", VP_OBJECT_GL )
@@ -329,3 +329,5 @@ void ChromaKey::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( ChromaKey, "chroma key", "computer vision", VP_OBJECT_GL )
@@ -166,7 +166,7 @@ void ColorTracking::updateObjectContent(map<int,PatchObject*> &patchObjects, ofx
             outputFBO->allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight(),GL_RGB,1);
         }
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
         blur(*pix, 10);
         contourFinder->findContours(*pix);
@@ -424,3 +424,5 @@ void ColorTracking::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( ColorTracking, "color tracking", "computer vision", VP_OBJECT_GL )
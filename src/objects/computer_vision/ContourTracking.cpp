@@ -59,6 +59,7 @@ ContourTracking::ContourTracking() : PatchObject(){
     posX = posY = drawW = drawH = 0.0f;
 
     isFBOAllocated      = false;
+    isContoursComputed  = false;
 
 }
 
@@ -138,6 +139,14 @@ void ContourTracking::updateObjectContent(map<int,PatchObject*> &patchObjects, o
             contourFinder->setInvert(true);
         }
 
+        // last frame contours data, computed on the update pool
+        if(isContoursComputed){
+            isContoursComputed = false;
+            static_cast<vector<float> *>(_outletParams[1])->swap(blobsData);
+            static_cast<vector<float> *>(_outletParams[2])->swap(contoursData);
+            static_cast<vector<float> *>(_outletParams[3])->swap(convexHullsData);
+        }
+
         contourFinder->setMinAreaRadius(minAreaRadius->getValue());
         contourFinder->setMaxAreaRadius(maxAreaRadius->getValue());
         contourFinder->setThreshold(thresholdValue->getValue());
@@ -148,107 +157,113 @@ void ContourTracking::updateObjectContent(map<int,PatchObject*> &patchObjects, o
             outputFBO->allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight(),GL_RGB,1);
         }
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
-
-        blur(*pix, 10);
-        contourFinder->findContours(*pix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
         if(outputFBO->isAllocated()){
             *static_cast<ofTexture *>(_outletParams[0]) = outputFBO->getTexture();
-
-            static_cast<vector<float> *>(_outletParams[1])->clear();
-            static_cast<vector<float> *>(_outletParams[2])->clear();
-            static_cast<vector<float> *>(_outletParams[3])->clear();
-
-            static_cast<vector<float> *>(_outletParams[1])->push_back(contourFinder->size());
-            static_cast<vector<float> *>(_outletParams[2])->push_back(contourFinder->size());
-            static_cast<vector<float> *>(_outletParams[3])->push_back(contourFinder->size());
-
-            for(int i = 0; i < contourFinder->size(); i++) {
-                // blob id
-                int label = contourFinder->getLabel(i);
-
-                // some different styles of contour centers
-                ofVec2f centroid = toOf(contourFinder->getCentroid(i));
-                ofVec2f average = toOf(contourFinder->getAverage(i));
-                ofVec2f center = toOf(contourFinder->getCenter(i));
-
-                // velocity
-                ofVec2f velocity = toOf(contourFinder->getVelocity(i));
-
-                // area and perimeter
-                double area = contourFinder->getContourArea(i);
-                double perimeter = contourFinder->getArcLength(i);
-
-                // bounding rect
-                cv::Rect boundingRect = contourFinder->getBoundingRect(i);
-
-                // contour
-                ofPolyline contour = toOf(contourFinder->getContour(i));
-                ofPolyline convexHull = toOf(contourFinder->getConvexHull(i));
-
-                // 2
-                static_cast<vector<float> *>(_outletParams[1])->push_back(static_cast<float>(label));
-                static_cast<vector<float> *>(_outletParams[1])->push_back(contourFinder->getTracker().getAge(label));
-
-                // 6
-                static_cast<vector<float> *>(_outletParams[1])->push_back(centroid.x);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(centroid.y);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(average.x);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(average.y);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(center.x);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(center.y);
-
-                // 2
-                static_cast<vector<float> *>(_outletParams[1])->push_back(velocity.x);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(velocity.y);
-
-                // 2
-                static_cast<vector<float> *>(_outletParams[1])->push_back(area);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(perimeter);
-
-                // 4
-                static_cast<vector<float> *>(_outletParams[1])->push_back(boundingRect.x);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(boundingRect.y);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(boundingRect.width);
-                static_cast<vector<float> *>(_outletParams[1])->push_back(boundingRect.height);
-
-                // 1
-                static_cast<vector<float> *>(_outletParams[2])->push_back(contour.getVertices().size());
-
-                // 2
-                static_cast<vector<float> *>(_outletParams[2])->push_back(static_cast<float>(label));
-                static_cast<vector<float> *>(_outletParams[2])->push_back(contourFinder->getTracker().getAge(label));
-
-                // contour.getVertices().size() * 2
-                for(int c=0;c<contour.getVertices().size();c++){
-                    static_cast<vector<float> *>(_outletParams[2])->push_back(contour.getVertices().at(c).x);
-                    static_cast<vector<float> *>(_outletParams[2])->push_back(contour.getVertices().at(c).y);
-                }
-
-                // 1
-                static_cast<vector<float> *>(_outletParams[3])->push_back(convexHull.getVertices().size());
-
-                // 2
-                static_cast<vector<float> *>(_outletParams[3])->push_back(static_cast<float>(label));
-                static_cast<vector<float> *>(_outletParams[3])->push_back(contourFinder->getTracker().getAge(label));
-
-                // convexHull.getVertices().size() * 2
-                for(int c=0;c<convexHull.getVertices().size();c++){
-                    static_cast<vector<float> *>(_outletParams[3])->push_back(convexHull.getVertices().at(c).x);
-                    static_cast<vector<float> *>(_outletParams[3])->push_back(convexHull.getVertices().at(c).y);
-                }
-
-            }
-
         }
 
+        this->requestCompute();
+
     }else{
         isFBOAllocated = false;
     }
     
 }
 
+//--------------------------------------------------------------
+void ContourTracking::computeObjectContent(){
+    blur(*pix, 10);
+    contourFinder->findContours(*pix);
+
+    blobsData.clear();
+    contoursData.clear();
+    convexHullsData.clear();
+
+    blobsData.push_back(contourFinder->size());
+    contoursData.push_back(contourFinder->size());
+    convexHullsData.push_back(contourFinder->size());
+
+    for(int i = 0; i < contourFinder->size(); i++) {
+        // blob id
+        int label = contourFinder->getLabel(i);
+
+        // some different styles of contour centers
+        ofVec2f centroid = toOf(contourFinder->getCentroid(i));
+        ofVec2f average = toOf(contourFinder->getAverage(i));
+        ofVec2f center = toOf(contourFinder->getCenter(i));
+
+        // velocity
+        ofVec2f velocity = toOf(contourFinder->getVelocity(i));
+
+        // area and perimeter
+        double area = contourFinder->getContourArea(i);
+        double perimeter = contourFinder->getArcLength(i);
+
+        // bounding rect
+        cv::Rect boundingRect = contourFinder->getBoundingRect(i);
+
+        // contour
+        ofPolyline contour = toOf(contourFinder->getContour(i));
+        ofPolyline convexHull = toOf(contourFinder->getConvexHull(i));
+
+        // 2
+        blobsData.push_back(static_cast<float>(label));
+        blobsData.push_back(contourFinder->getTracker().getAge(label));
+
+        // 6
+        blobsData.push_back(centroid.x);
+        blobsData.push_back(centroid.y);
+        blobsData.push_back(average.x);
+        blobsData.push_back(average.y);
+        blobsData.push_back(center.x);
+        blobsData.push_back(center.y);
+
+        // 2
+        blobsData.push_back(velocity.x);
+        blobsData.push_back(velocity.y);
+
+        // 2
+        blobsData.push_back(area);
+        blobsData.push_back(perimeter);
+
+        // 4
+        blobsData.push_back(boundingRect.x);
+        blobsData.push_back(boundingRect.y);
+        blobsData.push_back(boundingRect.width);
+        blobsData.push_back(boundingRect.height);
+
+        // 1
+        contoursData.push_back(contour.getVertices().size());
+
+        // 2
+        contoursData.push_back(static_cast<float>(label));
+        contoursData.push_back(contourFinder->getTracker().getAge(label));
+
+        // contour.getVertices().size() * 2
+        for(int c=0;c<contour.getVertices().size();c++){
+            contoursData.push_back(contour.getVertices().at(c).x);
+            contoursData.push_back(contour.getVertices().at(c).y);
+        }
+
+        // 1
+        convexHullsData.push_back(convexHull.getVertices().size());
+
+        // 2
+        convexHullsData.push_back(static_cast<float>(label));
+        convexHullsData.push_back(contourFinder->getTracker().getAge(label));
+
+        // convexHull.getVertices().size() * 2
+        for(int c=0;c<convexHull.getVertices().size();c++){
+            convexHullsData.push_back(convexHull.getVertices().at(c).x);
+            convexHullsData.push_back(convexHull.getVertices().at(c).y);
+        }
+
+    }
+
+    isContoursComputed = true;
+}
+
 //--------------------------------------------------------------
 void ContourTracking::drawObjectContent(ofxFontStash *font){
     ofSetColor(255);
@@ -385,3 +400,5 @@ void ContourTracking::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( ContourTracking, "contour tracking", "computer vision", VP_OBJECT_GL )
@@ -45,6 +45,7 @@ public:
     void            newObject();
     void            setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow);
     void            updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd);
+    void            computeObjectContent();
     void            drawObjectContent(ofxFontStash *font);
     void            removeObjectContent();
     void            mouseMovedObjectContent(ofVec3f _m);
@@ -59,6 +60,12 @@ public:
     ofFbo                       *outputFBO;
     bool                        isFBOAllocated;
 
+    // compute step: pix in, blobs/contours/convex hulls data out (published on the next update)
+    vector<float>               blobsData;
+    vector<float>               contoursData;
+    vector<float>               convexHullsData;
+    bool                        isContoursComputed;
+
     float                       posX, posY, drawW, drawH;
 
     ofxDatGui*                  gui;
@@ -86,7 +86,7 @@ void FaceTracker::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxTh
             outputFBO->allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight(),GL_RGB,1);
         }
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
         tracker.update(toCv(*pix));
 
@@ -177,3 +177,7 @@ void FaceTracker::removeObjectContent(){
     tracker.stopThread();
     tracker.waitForThread();
 }
+
+#if defined(TARGET_LINUX) || defined(TARGET_OSX)
+OBJECT_REGISTER( FaceTracker, "face tracker", "computer vision", VP_OBJECT_GL )
+#endif
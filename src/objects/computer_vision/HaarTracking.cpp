@@ -61,6 +61,9 @@ HaarTracking::HaarTracking() : PatchObject(){
     haarToLoad          = "";
     loadHaarConfigFlag  = false;
     haarConfigLoaded    = false;
+    isHaarLoaded        = false;
+    haarLoadRequest     = 0;
+    haarFinderChanged   = false;
 
 }
 
@@ -100,9 +103,7 @@ void HaarTracking::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
     }else{
         filepath = forceCheckMosaicDataPath(filepath);
     }
-    haarFinder->setup(filepath);
-    haarFinder->setPreset(ObjectFinder::Fast);
-    haarFinder->getTracker().setSmoothingRate(.1);
+    loadHaarCascade(filepath);
 
 }
 
@@ -130,7 +131,7 @@ void HaarTracking::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxT
                 string fileExtension = ofToUpper(file.getExtension());
                 if(fileExtension == "XML") {
                     filepath = file.getAbsolutePath();
-                    haarFinder->setup(filepath);
+                    loadHaarCascade(filepath);
 
                     size_t start = file.getFileName().find_first_of("_");
                     string tempName = file.getFileName().substr(start+1,file.getFileName().size()-start-5);
@@ -144,15 +145,23 @@ void HaarTracking::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxT
     // HAAR Tracking
     if(this->inletsConnected[0] && static_cast<ofTexture *>(_inletParams[0])->isAllocated()){
 
+        // same input frame as the last run (upstream not recomputed) and same cascade: nothing new to detect
+        bool newFrame = this->getInletChanged(0) || haarFinderChanged || !isFBOAllocated;
+        haarFinderChanged = false;
+
         if(!isFBOAllocated){
             isFBOAllocated  = true;
             pix             = new ofPixels();
             outputFBO->allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight(),GL_RGB,1);
         }
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
+        if(newFrame){
+            TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
-        haarFinder->update(*pix);
+            if(isHaarLoaded){
+                haarFinder->update(*pix);
+            }
+        }
 
         if(outputFBO->isAllocated()){
             *static_cast<ofTexture *>(_outletParams[0]) = outputFBO->getTexture();
@@ -301,6 +310,28 @@ void HaarTracking::fileDialogResponse(ofxThreadedFileDialogResponse &response){
     }
 }
 
+//--------------------------------------------------------------
+void HaarTracking::loadHaarCascade(string cascadePath){
+    // parse the cascade xml on the asset loader, swap the finder on the main thread
+    // (only the latest request, an older cascade finishing last is dropped)
+    int request = ++haarLoadRequest;
+    ofxCv::ObjectFinder *tempFinder = new ofxCv::ObjectFinder();
+    AssetLoader::getInstance().load([tempFinder,cascadePath](){
+        tempFinder->setup(cascadePath);
+        tempFinder->setPreset(ObjectFinder::Fast);
+        tempFinder->getTracker().setSmoothingRate(.1);
+    },[this,tempFinder,request](){
+        if(this->getWillErase() || request != haarLoadRequest){
+            delete tempFinder;
+            return;
+        }
+        delete haarFinder;
+        haarFinder = tempFinder;
+        isHaarLoaded = true;
+        haarFinderChanged = true;
+    });
+}
+
 //--------------------------------------------------------------
 void HaarTracking::onButtonEvent(ofxDatGuiButtonEvent e){
     if(!header->getIsCollapsed()){
@@ -309,3 +340,5 @@ void HaarTracking::onButtonEvent(ofxDatGuiButtonEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( HaarTracking, "haar tracking", "computer vision", VP_OBJECT_GL )
@@ -52,6 +52,7 @@ public:
     void            fileDialogResponse(ofxThreadedFileDialogResponse &response);
 
     void            onButtonEvent(ofxDatGuiButtonEvent e);
+    void            loadHaarCascade(string cascadePath);
 
 
     ofxCv::ObjectFinder         *haarFinder;
@@ -69,5 +70,8 @@ public:
     string                      haarToLoad;
     bool                        loadHaarConfigFlag;
     bool                        haarConfigLoaded;
+    bool                        isHaarLoaded;
+    int                         haarLoadRequest;
+    bool                        haarFinderChanged;
 
 };
@@ -43,8 +43,7 @@ MotionDetection::MotionDetection() : PatchObject(){
 
     _inletParams[0] = new ofTexture();  // input
 
-    _outletParams[0] = new float(); // MOTION QUANTITY
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // MOTION QUANTITY
 
     this->initInletsState();
 
@@ -125,7 +124,7 @@ void MotionDetection::updateObjectContent(map<int,PatchObject*> &patchObjects, o
             resetTextures(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight());
         }
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
         colorImg->setFromPixels(*pix);
         colorImg->updateTexture();
@@ -249,3 +248,5 @@ void MotionDetection::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( MotionDetection, "motion detection", "computer vision", VP_OBJECT_GL )
@@ -58,6 +58,7 @@ OpticalFlow::OpticalFlow() : PatchObject(){
     outputFBO           = new ofFbo();
 
     isFBOAllocated      = false;
+    isFlowComputed      = false;
 
 }
 
@@ -145,6 +146,12 @@ void OpticalFlow::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxTh
             outputFBO->allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight(),GL_RGB,1);
         }
 
+        // last frame flow data, computed on the update pool
+        if(isFlowComputed){
+            isFlowComputed = false;
+            static_cast<vector<float> *>(_outletParams[1])->swap(flowData);
+        }
+
         fb.setPyramidScale(fbPyrScale->getValue());
         fb.setNumLevels(static_cast<int>(floor(fbLevels->getValue())));
         fb.setWindowSize(static_cast<int>(floor(fbWinSize->getValue())));
@@ -153,36 +160,43 @@ void OpticalFlow::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxTh
         fb.setPolySigma(fbPolySigma->getValue());
         fb.setUseGaussian(fbUseGaussian->getChecked());
 
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
-
-        pix->resizeTo(*scaledPix);
-
-        fb.calcOpticalFlow(*scaledPix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
 
         if(outputFBO->isAllocated()){
             *static_cast<ofTexture *>(_outletParams[0]) = outputFBO->getTexture();
-
-            static_cast<vector<float> *>(_outletParams[1])->clear();
-
-            static_cast<vector<float> *>(_outletParams[1])->push_back(fb.getFlow().rows);
-            static_cast<vector<float> *>(_outletParams[1])->push_back(fb.getFlow().cols);
-
-            for(int y = 0; y < fb.getFlow().rows; y += 10) {
-                for(int x = 0; x < fb.getFlow().cols; x += 10) {
-                    static_cast<vector<float> *>(_outletParams[1])->push_back(x);
-                    static_cast<vector<float> *>(_outletParams[1])->push_back(y);
-                    static_cast<vector<float> *>(_outletParams[1])->push_back(fb.getFlowPosition(x, y).x);
-                    static_cast<vector<float> *>(_outletParams[1])->push_back(fb.getFlowPosition(x, y).y);
-                }
-            }
         }
 
+        this->requestCompute();
+
     }else{
         isFBOAllocated = false;
     }
 
 }
 
+//--------------------------------------------------------------
+void OpticalFlow::computeObjectContent(){
+    pix->resizeTo(*scaledPix);
+
+    fb.calcOpticalFlow(*scaledPix);
+
+    flowData.clear();
+
+    flowData.push_back(fb.getFlow().rows);
+    flowData.push_back(fb.getFlow().cols);
+
+    for(int y = 0; y < fb.getFlow().rows; y += 10) {
+        for(int x = 0; x < fb.getFlow().cols; x += 10) {
+            flowData.push_back(x);
+            flowData.push_back(y);
+            flowData.push_back(fb.getFlowPosition(x, y).x);
+            flowData.push_back(fb.getFlowPosition(x, y).y);
+        }
+    }
+
+    isFlowComputed = true;
+}
+
 //--------------------------------------------------------------
 void OpticalFlow::drawObjectContent(ofxFontStash *font){
     ofSetColor(255);
@@ -310,3 +324,5 @@ void OpticalFlow::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( OpticalFlow, "optical flow", "computer vision", VP_OBJECT_GL )
@@ -46,6 +46,7 @@ public:
     void            newObject();
     void            setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow);
     void            updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd);
+    void            computeObjectContent();
     void            drawObjectContent(ofxFontStash *font);
     void            removeObjectContent();
     
@@ -62,6 +63,10 @@ public:
     ofFbo                       *outputFBO;
     bool                        isFBOAllocated;
 
+    // compute step: pix in, flow data out (published on the next update)
+    vector<float>               flowData;
+    bool                        isFlowComputed;
+
     float                       posX, posY, drawW, drawH;
 
     ofxDatGui*                  gui;
@@ -38,14 +38,11 @@ BangToFloat::BangToFloat() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _inletParams[1] = new float();  // number
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // number
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -170,3 +167,4 @@ void BangToFloat::onTextInputEvent(ofxDatGuiTextInputEvent e){
     }
 }
 
+OBJECT_REGISTER( BangToFloat, "bang to float", "data", VP_OBJECT_GUI )
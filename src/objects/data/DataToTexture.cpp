@@ -46,6 +46,8 @@ DataToTexture::DataToTexture() : PatchObject(){
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     pix                 = new ofPixels();
     scaledPix           = new ofPixels();
 
@@ -300,3 +302,5 @@ void DataToTexture::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( DataToTexture, "data to texture", "data", VP_OBJECT_GL )
@@ -38,12 +38,12 @@ FloatsToVector::FloatsToVector() : PatchObject(){
     this->numInlets  = 6;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // float1
-    _inletParams[1] = new float();  // float2
-    _inletParams[2] = new float();  // float3
-    _inletParams[3] = new float();  // float4
-    _inletParams[4] = new float();  // float5
-    _inletParams[5] = new float();  // float6
+    *(float *)&_inletParams[0] = 0.0f;  // float1
+    *(float *)&_inletParams[1] = 0.0f;  // float2
+    *(float *)&_inletParams[2] = 0.0f;  // float3
+    *(float *)&_inletParams[3] = 0.0f;  // float4
+    *(float *)&_inletParams[4] = 0.0f;  // float5
+    *(float *)&_inletParams[5] = 0.0f;  // float6
     *(float *)&_inletParams[0] = 0.0f;
     *(float *)&_inletParams[1] = 0.0f;
     *(float *)&_inletParams[2] = 0.0f;
@@ -55,6 +55,8 @@ FloatsToVector::FloatsToVector() : PatchObject(){
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
 }
 
 //--------------------------------------------------------------
@@ -99,3 +101,5 @@ void FloatsToVector::drawObjectContent(ofxFontStash *font){
 void FloatsToVector::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( FloatsToVector, "floats to vector", "data", 0 )
@@ -71,7 +71,7 @@ void TextureToData::updateObjectContent(map<int,PatchObject*> &patchObjects, ofx
             pix->allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(),static_cast<ofTexture *>(_inletParams[0])->getHeight(),OF_PIXELS_RGB);
             col = static_cast<int>(static_cast<ofTexture *>(_inletParams[0])->getWidth()/2);
         }
-        static_cast<ofTexture *>(_inletParams[0])->readToPixels(*pix);
+        TextureReadback::getInstance().readToPixels(*static_cast<ofTexture *>(_inletParams[0]),*pix);
         for(int n=0; n<static_cast<ofTexture *>(_inletParams[0])->getHeight(); ++n){
             float sampleR = ofMap(pix->getColor(col, n).r, 0, 255, -0.5f, 0.5f);        // RED CHANNEL
             float sampleG = ofMap(pix->getColor(col, n).g, 0, 255, -0.5f, 0.5f);        // GREEN CHANNEL
@@ -116,3 +116,5 @@ void TextureToData::drawObjectContent(ofxFontStash *font){
 void TextureToData::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( TextureToData, "texture to data", "data", VP_OBJECT_GL )
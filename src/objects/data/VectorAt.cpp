@@ -39,14 +39,14 @@ VectorAt::VectorAt() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new vector<float>();  // input vector
-    _inletParams[1] = new float();          // at
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // at
 
-    _outletParams[0] = new float();         // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f;         // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     isGUIObject         = true;
     this->isOverGUI     = true;
 
@@ -183,3 +183,5 @@ void VectorAt::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VectorAt, "vector at", "data", VP_OBJECT_GUI )
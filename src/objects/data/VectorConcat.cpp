@@ -49,6 +49,8 @@ VectorConcat::VectorConcat() : PatchObject(){
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
 }
 
 //--------------------------------------------------------------
@@ -92,3 +94,5 @@ void VectorConcat::drawObjectContent(ofxFontStash *font){
 void VectorConcat::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( VectorConcat, "vector concat", "data", 0 )
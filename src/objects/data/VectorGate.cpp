@@ -38,8 +38,7 @@ VectorGate::VectorGate() : PatchObject(){
     this->numInlets  = 6;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // open
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // open
 
     _inletParams[1] = new vector<float>();  // vector1
     _inletParams[2] = new vector<float>();  // vector2
@@ -51,6 +50,7 @@ VectorGate::VectorGate() : PatchObject(){
 
     this->initInletsState();
 
+
     isOpen      = false;
     openInlet   = 0;
 
@@ -107,3 +107,5 @@ void VectorGate::drawObjectContent(ofxFontStash *font){
 void VectorGate::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( VectorGate, "vector gate", "data", 0 )
@@ -39,13 +39,14 @@ VectorMultiply::VectorMultiply() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new vector<float>();  // input data
-    _inletParams[1] = new float();  // multiplier
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // multiplier
 
     _outletParams[0] = new vector<float>(); // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     isGUIObject         = true;
     this->isOverGUI     = true;
 
@@ -176,3 +177,5 @@ void VectorMultiply::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VectorMultiply, "vector multiply", "data", VP_OBJECT_GUI )
@@ -39,8 +39,7 @@ ImageExporter::ImageExporter() : PatchObject(){
     this->numOutlets = 0;
 
     _inletParams[0] = new ofTexture(); // input
-    _inletParams[1] = new float();      // bang
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;      // bang
 
     this->initInletsState();
 
@@ -210,3 +209,5 @@ void ImageExporter::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( ImageExporter, "image exporter", "graphics", VP_OBJECT_GL )
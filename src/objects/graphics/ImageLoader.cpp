@@ -239,7 +239,23 @@ void ImageLoader::loadImageFile(){
     if(filepath != "none"){
         filepath = forceCheckMosaicDataPath(filepath);
         isNewObject = false;
-        img->load(filepath);
+
+        // decode the image on the asset loader, upload the texture on the main thread
+        string path = filepath;
+        shared_ptr<ofPixels> loadedPixels = make_shared<ofPixels>();
+        AssetLoader::getInstance().load([loadedPixels,path](){
+            ofLoadImage(*loadedPixels,path);
+        },[this,loadedPixels,path](){
+            if(this->getWillErase()){
+                return;
+            }
+            if(loadedPixels->isAllocated()){
+                img->setFromPixels(*loadedPixels);
+                isFileLoaded = false;
+            }else{
+                ofLog(OF_LOG_ERROR,"image file: %s NOT FOUND!",path.c_str());
+            }
+        });
 
         ofFile tempFile(filepath);
         if(tempFile.getFileName().size() > 22){
@@ -260,3 +276,5 @@ void ImageLoader::onButtonEvent(ofxDatGuiButtonEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( ImageLoader, "image loader", "graphics", VP_OBJECT_GL )
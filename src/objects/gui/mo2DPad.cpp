@@ -38,13 +38,13 @@ mo2DPad::mo2DPad() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // X
-    _inletParams[1] = new float();  // Y
+    *(float *)&_inletParams[0] = 0.0f;  // X
+    *(float *)&_inletParams[1] = 0.0f;  // Y
     *(float *)&_inletParams[0] = 0.0f;
     *(float *)&_inletParams[1] = 0.0f;
 
-    _outletParams[0] = new float(); // output X
-    _outletParams[1] = new float(); // output Y
+    *(float *)&_outletParams[0] = 0.0f; // output X
+    *(float *)&_outletParams[1] = 0.0f; // output Y
     *(float *)&_outletParams[0] = 0.0f;
     *(float *)&_outletParams[1] = 0.0f;
 
@@ -166,3 +166,5 @@ void mo2DPad::on2dPadEvent(ofxDatGui2dPadEvent e){
     this->setCustomVar(static_cast<float>(e.x),"XPOS");
     this->setCustomVar(static_cast<float>(e.y),"YPOS");
 }
+
+OBJECT_REGISTER( mo2DPad, "2d pad", "gui", VP_OBJECT_GL )
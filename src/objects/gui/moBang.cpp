@@ -38,11 +38,9 @@ moBang::moBang() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     _outletParams[1] = new string(); // output string
     *static_cast<string *>(_outletParams[1]) = "";
@@ -79,9 +77,23 @@ void moBang::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreade
         }
     }
 
+    // relay every incoming bang event
+    bool relayed = false;
+    if(this->getInletEvents(0,bangEvents)){
+        for(size_t i=0;i<bangEvents.size();i++){
+            if(bangEvents.at(i).value >= 1.0f){
+                this->pushOutletEvent(0,1.0f,bangEvents.at(i).time);
+                relayed = true;
+            }
+        }
+    }
+
     if(bang && isBangFinished){
         isBangFinished = false;
 
+        if(!relayed){
+            this->pushOutletEvent(0,1.0f);
+        }
         *(float *)&_outletParams[0] = static_cast<float>(bang);
         *static_cast<string *>(_outletParams[1]) = "bang";
 
@@ -122,3 +134,5 @@ void moBang::mouseReleasedObjectContent(ofVec3f _m){
         isBangFinished = true;
     }
 }
+
+OBJECT_REGISTER( moBang, "bang", "gui", VP_OBJECT_GL )
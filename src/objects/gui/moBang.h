@@ -50,5 +50,6 @@ public:
 
     bool            bang;
     bool            isBangFinished;
+    vector<PatchEvent>  bangEvents;
 
 };
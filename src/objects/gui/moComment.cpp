@@ -38,8 +38,7 @@ moComment::moComment() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
     _inletParams[1] = new string();  // comment
     *static_cast<string *>(_inletParams[1]) = "";
 
@@ -171,7 +170,7 @@ void moComment::keyReleasedObjectContent(int key){
 void moComment::loadCommentSetting(){
     ofxXmlSettings XML;
 
-    if (XML.loadFile(patchFile)){
+    if (PatchDocument::getInstance().load(patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
         for(int i=0;i<totalObjects;i++){
             if(XML.pushTag("object", i)){
@@ -188,7 +187,7 @@ void moComment::loadCommentSetting(){
 void moComment::saveCommentSetting(){
     ofxXmlSettings XML;
 
-    if (XML.loadFile(patchFile)){
+    if (PatchDocument::getInstance().load(patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
         for(int i=0;i<totalObjects;i++){
             if(XML.pushTag("object", i)){
@@ -198,6 +197,8 @@ void moComment::saveCommentSetting(){
                 XML.popTag();
             }
         }
-        XML.saveFile();
+        PatchDocument::getInstance().save(patchFile,XML);
     }
 }
+
+OBJECT_REGISTER( moComment, "comment", "gui", VP_OBJECT_GL )
@@ -38,8 +38,7 @@ moMessage::moMessage() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
     _inletParams[1] = new string();  // message
     *static_cast<string *>(_inletParams[1]) = "";
@@ -160,3 +159,5 @@ void moMessage::onButtonEvent(ofxDatGuiButtonEvent e){
 void moMessage::onTextInputEvent(ofxDatGuiTextInputEvent e){
     // cout << "From Event Object: " << e.text << endl;
 }
+
+OBJECT_REGISTER( moMessage, "message", "gui", VP_OBJECT_GL )
@@ -38,11 +38,9 @@ moPlayerControls::moPlayerControls() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _inletParams[1] = new float();  // select
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // select
 
     _outletParams[0] = new string(); // output
     *static_cast<string *>(_outletParams[0]) = "";
@@ -236,3 +234,5 @@ void moPlayerControls::onToggleEvent(ofxDatGuiToggleEvent e){
     }
 
 }
+
+OBJECT_REGISTER( moPlayerControls, "player controls", "gui", VP_OBJECT_GL )
@@ -98,18 +98,15 @@ void moSignalViewer::removeObjectContent(){
 
 //--------------------------------------------------------------
 void moSignalViewer::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
 
-            for(int i=0;i<bufferSize;i++){
-                static_cast<vector<float> *>(_outletParams[2])->push_back(0.0f);
-            }
-
-            XML.popTag();
+        for(int i=0;i<bufferSize;i++){
+            static_cast<vector<float> *>(_outletParams[2])->push_back(0.0f);
         }
     }
 }
@@ -141,3 +138,5 @@ void moSignalViewer::audioOutObject(ofSoundBuffer &outBuffer){
     }
 
 }
+
+OBJECT_REGISTER( moSignalViewer, "signal viewer", "gui", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
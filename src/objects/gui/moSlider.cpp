@@ -38,12 +38,10 @@ moSlider::moSlider() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // value
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // value
 
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -146,3 +144,5 @@ void moSlider::onSliderEvent(ofxDatGuiSliderEvent e){
     //*(float *)&_outletParams[0] = static_cast<float>(e.value);
     this->setCustomVar(static_cast<float>(e.value),"VALUE");
 }
+
+OBJECT_REGISTER( moSlider, "slider", "gui", VP_OBJECT_GL )
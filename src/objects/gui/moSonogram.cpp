@@ -52,7 +52,7 @@ moSonogram::moSonogram() : PatchObject(){
     this->isOverGUI         = false;
 
     timePosition            = 0;
-    resetTime               = ofGetElapsedTimeMillis();
+    resetTime               = PatchClock::getInstance().getElapsedTimeMillis();
     wait                    = 40;
 
     resizeQuad.set(this->width-20,this->height-20,20,20);
@@ -98,8 +98,8 @@ void moSonogram::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 //--------------------------------------------------------------
 void moSonogram::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
     if(this->inletsConnected[0]){
-        if(ofGetElapsedTimeMillis()-resetTime > wait){
-            resetTime = ofGetElapsedTimeMillis();
+        if(PatchClock::getInstance().getElapsedTimeMillis()-resetTime > wait){
+            resetTime = PatchClock::getInstance().getElapsedTimeMillis();
             if(timePosition >= this->width){
                 timePosition = 0;
             }else{
@@ -195,3 +195,5 @@ void moSonogram::dragGUIObject(ofVec3f _m){
         }
     }
 }
+
+OBJECT_REGISTER( moSonogram, "sonogram", "gui", VP_OBJECT_GL )
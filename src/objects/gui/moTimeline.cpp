@@ -42,8 +42,7 @@ moTimeline::moTimeline() : PatchObject(){
 
     _inletParams[0] = new string();  // control
     *static_cast<string *>(_inletParams[0]) = "";
-    _inletParams[1] = new float();  // playhead
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // playhead
 
     this->initInletsState();
 
@@ -264,7 +263,7 @@ void moTimeline::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThr
     if(resetTimelineOutlets){
         resetTimelineOutlets = false;
         for(int j=0;j<static_cast<int>(this->outPut.size());j++){
-            patchObjects[this->outPut[j]->toObjectID]->inletsConnected[this->outPut[j]->toInletID] = false;
+            patchObjects[this->outPut[j]->toObjectID]->unlinkInlet(this->outPut[j]->toInletID);
         }
         resetOutlets();
     }
@@ -670,7 +669,7 @@ void moTimeline::updateOutletsConfig(){
 //--------------------------------------------------------------
 void moTimeline::saveOutletConfig(){
     ofxXmlSettings XML;
-    if(XML.loadFile(this->patchFile)){
+    if(PatchDocument::getInstance().load(this->patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
 
         // Load Links
@@ -736,7 +735,7 @@ void moTimeline::saveOutletConfig(){
             }
         }
 
-        XML.saveFile();
+        PatchDocument::getInstance().save(patchFile,XML);
     }
 
     ofNotifyEvent(this->reconnectOutletsEvent, this->nId);
@@ -761,7 +760,6 @@ void moTimeline::resetOutlets(){
             static_cast<vector<float> *>(_outletParams[i])->assign(128,0.0f);
             this->addOutlet(VP_LINK_ARRAY,"midiTrackNotes");
         }else{
-            _outletParams[i] = new float();
             *(float *)&_outletParams[i] = 0.0f;
             this->addOutlet(VP_LINK_NUMERIC,"trackData");
         }
@@ -972,3 +970,5 @@ void moTimeline::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( moTimeline, "timeline", "gui", VP_OBJECT_GL )
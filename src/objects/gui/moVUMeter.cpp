@@ -40,8 +40,7 @@ moVUMeter::moVUMeter() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer();  // signal
 
-    _outletParams[0] = new float(); // RMS
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // RMS
 
     this->initInletsState();
 
@@ -99,3 +98,5 @@ void moVUMeter::drawObjectContent(ofxFontStash *font){
 void moVUMeter::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( moVUMeter, "vu meter", "gui", VP_OBJECT_GL )
@@ -165,3 +165,5 @@ void moVideoViewer::dragGUIObject(ofVec3f _m){
         }
     }
 }
+
+OBJECT_REGISTER( moVideoViewer, "video viewer", "gui", VP_OBJECT_GL )
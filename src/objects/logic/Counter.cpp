@@ -38,17 +38,13 @@ Counter::Counter() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _inletParams[1] = new float();  // start
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // start
 
-    _inletParams[2] = new float();  // end
-    *(float *)&_inletParams[2] = 1.0f;
+    *(float *)&_inletParams[2] = 1.0f;  // end
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -104,11 +100,22 @@ void Counter::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThread
     start->update();
     end->update();
 
+    // count every bang event received since the last update, or the bang value of the link
+    int numBangs = 0;
+    bangEvents.clear();
     if(this->inletsConnected[0]){
-        if(*(float *)&_inletParams[0] < 1.0){
+        if(this->getInletEvents(0,bangEvents)){
+            for(size_t i=0;i<bangEvents.size();i++){
+                if(bangEvents.at(i).value >= 1.0f){
+                    numBangs++;
+                }
+            }
+            bang = numBangs > 0;
+        }else if(*(float *)&_inletParams[0] < 1.0){
             bang = false;
         }else{
             bang = true;
+            numBangs = 1;
         }
     }
 
@@ -119,7 +126,9 @@ void Counter::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThread
         }
     }
 
-    if(bang){
+    // every count is sent as an event at its bang time
+    size_t bangEvent = 0;
+    for(int b=0;b<numBangs;b++){
         int tempEnd = 1;
         if(this->inletsConnected[2]){
             tempEnd = static_cast<int>(*(float *)&_inletParams[2]);
@@ -135,6 +144,15 @@ void Counter::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThread
                 *(float *)&_outletParams[0] = _st;
             }
         }
+        while(bangEvent < bangEvents.size() && bangEvents.at(bangEvent).value < 1.0f){
+            bangEvent++;
+        }
+        if(bangEvent < bangEvents.size()){
+            this->pushOutletEvent(0,*(float *)&_outletParams[0],bangEvents.at(bangEvent).time);
+            bangEvent++;
+        }else{
+            this->pushOutletEvent(0,*(float *)&_outletParams[0]);
+        }
     }
 
     if(this->inletsConnected[1]){
@@ -220,3 +238,5 @@ void Counter::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( Counter, "counter", "logic", VP_OBJECT_GUI )
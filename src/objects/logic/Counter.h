@@ -62,4 +62,6 @@ public:
 
     bool                    loaded;
 
+    vector<PatchEvent>      bangEvents;
+
 };
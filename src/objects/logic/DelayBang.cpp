@@ -38,14 +38,11 @@ DelayBang::DelayBang() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _inletParams[1] = new float();  // ms
-    *(float *)&_inletParams[1] = 1000.0f;
+    *(float *)&_inletParams[1] = 1000.0f;  // ms
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     _outletParams[1] = new string(); // output string
     *static_cast<string *>(_outletParams[1]) = "";
@@ -61,7 +58,6 @@ DelayBang::DelayBang() : PatchObject(){
     loadStart           = false;
 
     wait                = static_cast<size_t>(floor(*(float *)&_inletParams[1]));
-    startTime           = ofGetElapsedTimeMillis();
 
 }
 
@@ -104,15 +100,32 @@ void DelayBang::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
     gui->update();
     inputNumber->update();
 
+    // the delay starts at the time of the bang event, not at this frame
+    uint64_t bangTime = PatchClock::getInstance().getElapsedTimeMicros();
     if(this->inletsConnected[0]){
-        if(*(float *)&_inletParams[0] == 1.0 && !bang){
+        if(this->getInletEvents(0,bangEvents)){
+            for(size_t i=0;i<bangEvents.size() && !bang;i++){
+                if(bangEvents.at(i).value == 1.0f){
+                    bang        = true;
+                    loadStart   = false;
+                    bangTime    = bangEvents.at(i).time;
+                }
+            }
+        }else if(*(float *)&_inletParams[0] == 1.0 && !bang){
             bang        = true;
             loadStart   = false;
-            startTime   = ofGetElapsedTimeMillis();
         }
     }
 
-    if(!loadStart && (ofGetElapsedTimeMillis()-startTime > wait)){
+    if(!loadStart && !delayTimer){
+        uint64_t elapsed = (PatchClock::getInstance().getElapsedTimeMicros() - std::min(bangTime,PatchClock::getInstance().getElapsedTimeMicros()))/1000;
+        delayTimer = ControlThread::getInstance().schedule(wait > elapsed ? wait-elapsed : 0,[this](){ bangMailbox.post(ControlThread::getInstance().getCurrentTime()*1000); });
+    }
+
+    bangTimes.clear();
+    if(bangMailbox.take(bangTimes) > 0){
+        this->pushOutletEvent(0,1.0f,bangTimes.at(0));
+        delayTimer.reset();
         bang        = false;
         loadStart   = true;
         delayBang   = true;
@@ -143,7 +156,7 @@ void DelayBang::drawObjectContent(ofxFontStash *font){
 
 //--------------------------------------------------------------
 void DelayBang::removeObjectContent(){
-
+    ControlThread::getInstance().cancelAndWait(delayTimer);
 }
 
 //--------------------------------------------------------------
@@ -187,3 +200,5 @@ void DelayBang::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( DelayBang, "delay bang", "logic", VP_OBJECT_GUI )
@@ -59,6 +59,11 @@ public:
 
     bool                    loadStart;
     size_t                  wait;
-    size_t                  startTime;
+
+    // delay timed on the control thread, the bang is handed to update() through the mailbox
+    ControlThread::TimerHandle  delayTimer;
+    ControlMailbox              bangMailbox;
+    vector<uint64_t>            bangTimes;
+    vector<PatchEvent>          bangEvents;
 
 };
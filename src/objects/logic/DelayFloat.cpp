@@ -38,17 +38,13 @@ DelayFloat::DelayFloat() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _inletParams[1] = new float();  // number
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // number
 
-    _inletParams[2] = new float();  // ms
-    *(float *)&_inletParams[2] = 1000.0f;
+    *(float *)&_inletParams[2] = 1000.0f;  // ms
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     this->initInletsState();
 
@@ -63,7 +59,7 @@ DelayFloat::DelayFloat() : PatchObject(){
     loaded              = false;
 
     wait                = static_cast<size_t>(floor(*(float *)&_inletParams[2]));
-    startTime           = ofGetElapsedTimeMillis();
+    startTime           = PatchClock::getInstance().getElapsedTimeMillis();
 
 }
 
@@ -110,10 +106,19 @@ void DelayFloat::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThr
     inputNumber->update();
 
     if(this->inletsConnected[0]){
-        if(*(float *)&_inletParams[0] == 1.0 && !bang){
+        // the delay starts at the time of the bang event, not at this frame
+        if(this->getInletEvents(0,bangEvents)){
+            for(size_t i=0;i<bangEvents.size() && !bang;i++){
+                if(bangEvents.at(i).value == 1.0f){
+                    bang        = true;
+                    loadStart   = false;
+                    startTime   = static_cast<size_t>(bangEvents.at(i).time/1000);
+                }
+            }
+        }else if(*(float *)&_inletParams[0] == 1.0 && !bang){
             bang        = true;
             loadStart   = false;
-            startTime   = ofGetElapsedTimeMillis();
+            startTime   = PatchClock::getInstance().getElapsedTimeMillis();
         }
     }
 
@@ -127,7 +132,7 @@ void DelayFloat::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThr
       inputNumber->setText(ofToString(wait));
     }
 
-    if(!loadStart && (ofGetElapsedTimeMillis()-startTime > wait)){
+    if(!loadStart && (PatchClock::getInstance().getElapsedTimeMillis()-startTime > wait)){
         bang        = false;
         loadStart   = true;
         delayBang   = true;
@@ -140,6 +145,9 @@ void DelayFloat::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThr
     }else if(delayBang && !this->inletsConnected[1]){
         *(float *)&_outletParams[0] = static_cast<float>(ofToFloat(numberBox->getText()));
     }
+    if(delayBang){
+        this->pushOutletEvent(0,*(float *)&_outletParams[0],static_cast<uint64_t>(startTime+wait)*1000);
+    }
 
     if(!loaded){
         loaded = true;
@@ -214,3 +222,5 @@ void DelayFloat::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( DelayFloat, "delay float", "logic", VP_OBJECT_GUI )
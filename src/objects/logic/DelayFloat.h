@@ -63,5 +63,6 @@ public:
     bool                    loadStart;
     size_t                  wait;
     size_t                  startTime;
+    vector<PatchEvent>      bangEvents;
 
 };
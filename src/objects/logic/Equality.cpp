@@ -38,14 +38,14 @@ Equality::Equality() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // input number
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // input number
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     this->height        /= 2;
 
     isGUIObject         = true;
@@ -83,16 +83,18 @@ void Equality::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void Equality::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    if(this->inletsConnected[0]){
-        inputValue = *(float *)&_inletParams[0];
-        if(inputValue == equalsTo){
-            *(float *)&_outletParams[0] = 1;
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[0]){
+            inputValue = *(float *)&_inletParams[0];
+            if(inputValue == equalsTo){
+                *(float *)&_outletParams[0] = 1;
+            }else{
+                *(float *)&_outletParams[0] = 0;
+            }
         }else{
             *(float *)&_outletParams[0] = 0;
         }
-    }else{
-        *(float *)&_outletParams[0] = 0;
-    }
+    });
 
     gui->update();
     inputNumber->update();
@@ -151,3 +153,5 @@ void Equality::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( Equality, "==", "logic", VP_OBJECT_GUI )
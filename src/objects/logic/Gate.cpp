@@ -38,25 +38,24 @@ Gate::Gate() : PatchObject(){
     this->numInlets  = 6;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // open
-    *(float *)&_inletParams[0] = 0.0f;
-
-    _inletParams[1] = new float();  // float1
-    _inletParams[2] = new float();  // float2
-    _inletParams[3] = new float();  // float3
-    _inletParams[4] = new float();  // float4
-    _inletParams[5] = new float();  // float5
+    *(float *)&_inletParams[0] = 0.0f;  // open
+
+    *(float *)&_inletParams[1] = 0.0f;  // float1
+    *(float *)&_inletParams[2] = 0.0f;  // float2
+    *(float *)&_inletParams[3] = 0.0f;  // float3
+    *(float *)&_inletParams[4] = 0.0f;  // float4
+    *(float *)&_inletParams[5] = 0.0f;  // float5
     *(float *)&_inletParams[1] = 0.0f;
     *(float *)&_inletParams[2] = 0.0f;
     *(float *)&_inletParams[3] = 0.0f;
     *(float *)&_inletParams[4] = 0.0f;
     *(float *)&_inletParams[5] = 0.0f;
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     this->initInletsState();
 
+
     isOpen      = false;
     openInlet   = 0;
 
@@ -81,24 +80,27 @@ void Gate::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void Gate::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    
-    if(this->inletsConnected[0]){
-        if(*(float *)&_inletParams[0] < 1.0){
-            isOpen = false;
-        }else{
-            isOpen = true;
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[0]){
+            if(*(float *)&_inletParams[0] < 1.0){
+                isOpen = false;
+            }else{
+                isOpen = true;
+            }
         }
-    }
 
-    if(isOpen){
-        openInlet = static_cast<int>(floor(*(float *)&_inletParams[0]));
-        if(openInlet >= 1 && openInlet <= this->numInlets && this->inletsConnected[openInlet]){
-            *(float *)&_outletParams[0] = *(float *)&_inletParams[openInlet];
+        if(isOpen){
+            openInlet = static_cast<int>(floor(*(float *)&_inletParams[0]));
+            if(openInlet >= 1 && openInlet <= this->numInlets && this->inletsConnected[openInlet]){
+                *(float *)&_outletParams[0] = *(float *)&_inletParams[openInlet];
+            }
+        }else{
+            *(float *)&_outletParams[0] = 0.0f;
         }
-    }else{
-        *(float *)&_outletParams[0] = 0.0f;
-    }
-    
+    },[this](int inlet){
+        // a closed gate blocks the events
+        return isOpen ? 0 : -1;
+    });
 }
 
 //--------------------------------------------------------------
@@ -112,3 +114,5 @@ void Gate::drawObjectContent(ofxFontStash *font){
 void Gate::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( Gate, "gate", "logic", 0 )
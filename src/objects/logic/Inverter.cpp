@@ -38,14 +38,14 @@ Inverter::Inverter() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     trigger = true;
 
 }
@@ -64,15 +64,16 @@ void Inverter::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void Inverter::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    
-    if(this->inletsConnected[0]){
-        if(*(float *)&_inletParams[0] < 1.0f){
-            trigger = true;
-        }else{
-            trigger = false;
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[0]){
+            if(*(float *)&_inletParams[0] < 1.0f){
+                trigger = true;
+            }else{
+                trigger = false;
+            }
         }
-    }
-    *(float *)&_outletParams[0] = static_cast<float>(trigger);
+        *(float *)&_outletParams[0] = static_cast<float>(trigger);
+    });
 }
 
 //--------------------------------------------------------------
@@ -99,3 +100,5 @@ void Inverter::drawObjectContent(ofxFontStash *font){
 void Inverter::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( Inverter, "inverter", "logic", 0 )
@@ -38,11 +38,9 @@ LoadBang::LoadBang() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // time
-    *(float *)&_inletParams[0] = 1000.0f;
+    *(float *)&_inletParams[0] = 1000.0f;  // time
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     _outletParams[1] = new string(); // output string
     *static_cast<string *>(_outletParams[1]) = "";
@@ -56,7 +54,7 @@ LoadBang::LoadBang() : PatchObject(){
     loadStart           = false;
 
     wait                = static_cast<size_t>(floor(*(float *)&_inletParams[0]));
-    startTime           = ofGetElapsedTimeMillis();
+    startTime           = PatchClock::getInstance().getElapsedTimeMillis();
 
     loaded              = false;
 
@@ -113,10 +111,10 @@ void LoadBang::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThrea
         timeSetting->setText(ofToString(wait));
         this->setCustomVar(static_cast<float>(wait),"TIME");
         loadStart = false;
-        startTime = ofGetElapsedTimeMillis();
+        startTime = PatchClock::getInstance().getElapsedTimeMillis();
     }
 
-    if(!loadStart && (ofGetElapsedTimeMillis()-startTime > wait)){
+    if(!loadStart && (PatchClock::getInstance().getElapsedTimeMillis()-startTime > wait)){
         bang = true;
         loadStart = true;
     }else{
@@ -187,10 +185,12 @@ void LoadBang::onTextInputEvent(ofxDatGuiTextInputEvent e){
                 this->setCustomVar(static_cast<float>(ofToInt(e.text)),"TIME");
                 wait = ofToInt(e.text);
                 loadStart = false;
-                startTime = ofGetElapsedTimeMillis();
+                startTime = PatchClock::getInstance().getElapsedTimeMillis();
             }else{
                 timeSetting->setText(ofToString(wait));
             }
         }
     }
 }
+
+OBJECT_REGISTER( LoadBang, "loadbang", "logic", VP_OBJECT_GUI )
@@ -38,16 +38,15 @@ OR::OR() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // b1
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // b2
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // b1
+    *(float *)&_inletParams[1] = 0.0f;  // b2
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     this->height        /= 2;
 
     bang                = false;
@@ -69,18 +68,20 @@ void OR::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void OR::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    if(this->inletsConnected[0] && this->inletsConnected[1]){
-        if(*(float *)&_inletParams[0] >= 1.0 || *(float *)&_inletParams[1] >= 1.0){
-            *(float *)&_outletParams[0] = 1;
-            bang                = true;
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[0] && this->inletsConnected[1]){
+            if(*(float *)&_inletParams[0] >= 1.0 || *(float *)&_inletParams[1] >= 1.0){
+                *(float *)&_outletParams[0] = 1;
+                bang                = true;
+            }else{
+                *(float *)&_outletParams[0] = 0;
+                bang                = false;
+            }
         }else{
             *(float *)&_outletParams[0] = 0;
             bang                = false;
         }
-    }else{
-        *(float *)&_outletParams[0] = 0;
-        bang                = false;
-    }
+    });
 }
 
 //--------------------------------------------------------------
@@ -98,3 +99,5 @@ void OR::drawObjectContent(ofxFontStash *font){
 void OR::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( OR, "||", "logic", 0 )
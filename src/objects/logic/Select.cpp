@@ -38,18 +38,17 @@ Select::Select() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 17;
 
-    _inletParams[0] = new float();  // state
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // state
 
     for(int i=0;i<this->numOutlets;i++){
-        _outletParams[i] = new float(); // output numeric
-        *(float *)&_outletParams[i] = 0.0f;
+        *(float *)&_outletParams[i] = 0.0f; // output numeric
     }
 
     this->height          *= 3;
 
     this->initInletsState();
 
+
     selector    = 0;
     lastValue   = 0;
 }
@@ -72,25 +71,33 @@ void Select::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void Select::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    
-    if(this->inletsConnected[0]){
-        if(static_cast<int>(floor(*(float *)&_inletParams[0])) != lastValue && static_cast<int>(floor(*(float *)&_inletParams[0])) < bangs.size()){
-            lastValue = static_cast<int>(floor(*(float *)&_inletParams[0]));
-            bangs.at(lastValue) = true;
-        }else if(static_cast<int>(floor(*(float *)&_inletParams[0])) != lastValue && static_cast<int>(floor(*(float *)&_inletParams[0])) >= bangs.size()){
-            lastValue = static_cast<int>(floor(*(float *)&_inletParams[0]));
-            bangs.at(bangs.size()-1) = true;
-        }else{
-            for(int i=0;i<bangs.size();i++){
-                bangs.at(i) = false;
+    int selected = -1;
+    this->runWithInletEvents([this,&selected](){
+        if(this->inletsConnected[0]){
+            if(static_cast<int>(floor(*(float *)&_inletParams[0])) != lastValue && static_cast<int>(floor(*(float *)&_inletParams[0])) < bangs.size()){
+                lastValue = static_cast<int>(floor(*(float *)&_inletParams[0]));
+                bangs.at(lastValue) = true;
+                selected  = lastValue;
+            }else if(static_cast<int>(floor(*(float *)&_inletParams[0])) != lastValue && static_cast<int>(floor(*(float *)&_inletParams[0])) >= bangs.size()){
+                lastValue = static_cast<int>(floor(*(float *)&_inletParams[0]));
+                bangs.at(bangs.size()-1) = true;
+                selected  = static_cast<int>(bangs.size())-1;
+            }else{
+                for(int i=0;i<bangs.size();i++){
+                    bangs.at(i) = false;
+                }
             }
-        }
 
-        for(int i=0;i<bangs.size();i++){
-            *(float *)&_outletParams[i] = static_cast<float>(bangs.at(i));
+            for(int i=0;i<bangs.size();i++){
+                *(float *)&_outletParams[i] = static_cast<float>(bangs.at(i));
+            }
         }
-    }
-    
+    },[&selected](int inlet){
+        // only a new selection bangs its outlet
+        int oid = selected;
+        selected = -1;
+        return oid;
+    });
 }
 
 //--------------------------------------------------------------
@@ -105,3 +112,5 @@ void Select::drawObjectContent(ofxFontStash *font){
 void Select::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( Select, "select", "logic", 0 )
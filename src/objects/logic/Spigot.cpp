@@ -38,11 +38,9 @@ Spigot::Spigot() : PatchObject(){
     this->numInlets  = 6;
     this->numOutlets = 5;
 
-    _inletParams[0] = new float();  // state
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // state
 
-    _inletParams[1] = new float();  // float
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // float
 
     _inletParams[2] = new string();  // string
     *static_cast<string *>(_inletParams[2]) = "";
@@ -53,8 +51,7 @@ Spigot::Spigot() : PatchObject(){
 
     _inletParams[5] = new ofSoundBuffer();  // signal
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     _outletParams[1] = new string();  // string
     *static_cast<string *>(_outletParams[1]) = "";
@@ -101,7 +98,16 @@ void Spigot::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void Spigot::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    
+
+    // numeric events pass through while the spigot is open, in time order with the open/close ones
+    this->processInletEvents([this](int inlet, uint64_t time){
+        if(inlet == 0 && this->inletsConnected[0]){
+            isOpen = *(float *)&_inletParams[0] >= 1.0;
+        }else if(inlet == 1 && isOpen){
+            this->pushOutletEvent(0,*(float *)&_inletParams[1],time);
+        }
+    });
+
     if(this->inletsConnected[0]){
         if(*(float *)&_inletParams[0] < 1.0){
             isOpen = false;
@@ -153,3 +159,5 @@ void Spigot::mouseReleasedObjectContent(ofVec3f _m){
         isOpen = !isOpen;
     }
 }
+
+OBJECT_REGISTER( Spigot, "spigot", "logic", VP_OBJECT_GL )
@@ -38,14 +38,11 @@ TimedSemaphore::TimedSemaphore() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
-    _inletParams[1] = new float();  // ms
-    *(float *)&_inletParams[1] = 1000.0f;
+    *(float *)&_inletParams[1] = 1000.0f;  // ms
 
-    _outletParams[0] = new float(); // output numeric
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output numeric
 
     this->initInletsState();
 
@@ -57,7 +54,7 @@ TimedSemaphore::TimedSemaphore() : PatchObject(){
     loadStart           = true;
 
     wait                = 1000;
-    startTime           = ofGetElapsedTimeMillis();
+    startTime           = PatchClock::getInstance().getElapsedTimeMillis();
 
 }
 
@@ -100,16 +97,27 @@ void TimedSemaphore::updateObjectContent(map<int,PatchObject*> &patchObjects, of
     inputNumber->update();
 
     if(this->inletsConnected[0] && loadStart){
-        if(*(float *)&_inletParams[0] == 1.0 && !bang){
+        // the semaphore closes from the time of the bang event, not from this frame
+        if(this->getInletEvents(0,bangEvents)){
+            for(size_t i=0;i<bangEvents.size() && !bang;i++){
+                if(bangEvents.at(i).value == 1.0f){
+                    bang        = true;
+                    loadStart   = false;
+                    startTime   = static_cast<size_t>(bangEvents.at(i).time/1000);
+                    this->pushOutletEvent(0,1.0f,bangEvents.at(i).time);
+                }
+            }
+        }else if(*(float *)&_inletParams[0] == 1.0 && !bang){
             bang        = true;
             loadStart   = false;
-            startTime   = ofGetElapsedTimeMillis();
+            startTime   = PatchClock::getInstance().getElapsedTimeMillis();
+            this->pushOutletEvent(0,1.0f);
         }
     }else{
       bang        = false;
     }
 
-    if(!loadStart && (ofGetElapsedTimeMillis()-startTime > wait)){
+    if(!loadStart && (PatchClock::getInstance().getElapsedTimeMillis()-startTime > wait)){
         loadStart   = true;
     }
     
@@ -183,3 +191,5 @@ void TimedSemaphore::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( TimedSemaphore, "timed semaphore", "logic", VP_OBJECT_GUI )
@@ -38,16 +38,15 @@ Add::Add() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // input number 1
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // input number 2
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // input number 1
+    *(float *)&_inletParams[1] = 0.0f;  // input number 2
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     this->height        /= 2;
 
     isGUIObject         = true;
@@ -102,15 +101,19 @@ void Add::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFi
         number = this->getCustomVar("NUMBER");
     }
 
-    if(this->inletsConnected[1]){
-        numberBox->setText(ofToString(*(float *)&_inletParams[1]));
-        number = *(float *)&_inletParams[1];
-    }
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[1]){
+            number = *(float *)&_inletParams[1];
+        }
+        if(this->inletsConnected[0]){
+          *(float *)&_outletParams[0] = *(float *)&_inletParams[0] + number;
+        }else{
+          *(float *)&_outletParams[0] = 0.0f;
+        }
+    });
 
-    if(this->inletsConnected[0]){
-      *(float *)&_outletParams[0] = *(float *)&_inletParams[0] + number;
-    }else{
-      *(float *)&_outletParams[0] = 0.0f;
+    if(this->inletsConnected[1]){
+        numberBox->setText(ofToString(number));
     }
 }
 
@@ -179,3 +182,5 @@ void Add::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( Add, "add", "math", VP_OBJECT_GUI )
@@ -38,18 +38,16 @@ Clamp::Clamp() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // min
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // max
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();  // value
-    *(float *)&_inletParams[2] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // min
+    *(float *)&_inletParams[1] = 0.0f;  // max
+    *(float *)&_inletParams[2] = 0.0f;  // value
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
 }
 
 //--------------------------------------------------------------
@@ -69,18 +67,20 @@ void Clamp::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void Clamp::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    if(this->inletsConnected[2]){
-      float _min = 0.0f, _max = 1000000000.0f;
-      if(this->inletsConnected[0]){
-        _min = *(float *)&_inletParams[0];
-      }
-      if(this->inletsConnected[0]){
-        _max = *(float *)&_inletParams[1];
-      }
-      *(float *)&_outletParams[0] = ofClamp(*(float *)&_inletParams[2],_min,_max);
-    }else{
-      *(float *)&_outletParams[0] = 0.0f;
-    }
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[2]){
+          float _min = 0.0f, _max = 1000000000.0f;
+          if(this->inletsConnected[0]){
+            _min = *(float *)&_inletParams[0];
+          }
+          if(this->inletsConnected[0]){
+            _max = *(float *)&_inletParams[1];
+          }
+          *(float *)&_outletParams[0] = ofClamp(*(float *)&_inletParams[2],_min,_max);
+        }else{
+          *(float *)&_outletParams[0] = 0.0f;
+        }
+    });
 }
 
 //--------------------------------------------------------------
@@ -95,3 +95,5 @@ void Clamp::drawObjectContent(ofxFontStash *font){
 void Clamp::removeObjectContent(){
 
 }
+
+OBJECT_REGISTER( Clamp, "clamp", "math", 0 )
@@ -38,11 +38,9 @@ Constant::Constant() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // input number
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // input number
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     _outletParams[1] = new string(); // output string
     *static_cast<string *>(_outletParams[1]) = "";
@@ -153,3 +151,5 @@ void Constant::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( Constant, "constant", "math", VP_OBJECT_GUI )
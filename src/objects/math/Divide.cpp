@@ -38,16 +38,15 @@ Divide::Divide() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // input number 1
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // input number 2
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // input number 1
+    *(float *)&_inletParams[1] = 0.0f;  // input number 2
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     this->height        /= 2;
 
     isGUIObject         = true;
@@ -103,20 +102,24 @@ void Divide::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreade
         number = this->getCustomVar("NUMBER");
     }
 
-    if(this->inletsConnected[1]){
-        numberBox->setText(ofToString(*(float *)&_inletParams[1]));
-        number = *(float *)&_inletParams[1];
-    }
-
-    if(this->inletsConnected[0]){
-      if(number == 0.0f){
-        *(float *)&_outletParams[0] = 0.0f;
-      }else{
-        *(float *)&_outletParams[0] = *(float *)&_inletParams[0] / number;
-      }
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[1]){
+            number = *(float *)&_inletParams[1];
+        }
+        if(this->inletsConnected[0]){
+          if(number == 0.0f){
+            *(float *)&_outletParams[0] = 0.0f;
+          }else{
+            *(float *)&_outletParams[0] = *(float *)&_inletParams[0] / number;
+          }
+
+        }else{
+          *(float *)&_outletParams[0] = 0.0f;
+        }
+    });
 
-    }else{
-      *(float *)&_outletParams[0] = 0.0f;
+    if(this->inletsConnected[1]){
+        numberBox->setText(ofToString(number));
     }
 }
 
@@ -185,3 +188,5 @@ void Divide::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( Divide, "divide", "math", VP_OBJECT_GUI )
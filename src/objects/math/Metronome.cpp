@@ -38,11 +38,9 @@ Metronome::Metronome() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float(); // time
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f; // time
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -50,8 +48,7 @@ Metronome::Metronome() : PatchObject(){
     this->isOverGUI     = true;
 
     wait = 1000;
-    resetTime = ofGetElapsedTimeMillis();
-    metroTime = ofGetElapsedTimeMillis();
+    timerWait = wait;
 
     sync                = false;
     loaded              = false;
@@ -92,8 +89,6 @@ void Metronome::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 //--------------------------------------------------------------
 void Metronome::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
 
-    metroTime = ofGetElapsedTimeMillis();
-
     gui->update();
     timeSetting->update();
 
@@ -107,13 +102,22 @@ void Metronome::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
         sync = static_cast<bool>(floor(*(float *)&_inletParams[1]));
     }
 
-    if(sync){
-        resetTime = ofGetElapsedTimeMillis();
+    // restart the timer on sync or when the time changes
+    if(sync || wait != timerWait){
+        ControlThread::cancel(metroTimer);
+    }
+    if(!sync && !metroTimer){
+        timerWait = wait;
+        metroTimer = ControlThread::getInstance().scheduleRepeating(wait,[this](){ bangMailbox.post(ControlThread::getInstance().getCurrentTime()*1000); });
     }
 
-    if(metroTime-resetTime > wait){
-        resetTime = ofGetElapsedTimeMillis();
+    // every tick fired since the last frame is sent as an event, at its control thread time
+    bangTimes.clear();
+    if(bangMailbox.take(bangTimes) > 0){
         *(float *)&_outletParams[0] = 1.0f;
+        for(size_t i=0;i<bangTimes.size();i++){
+            this->pushOutletEvent(0,1.0f,bangTimes.at(i));
+        }
     }else{
         *(float *)&_outletParams[0] = 0.0f;
     }
@@ -136,7 +140,7 @@ void Metronome::drawObjectContent(ofxFontStash *font){
 
 //--------------------------------------------------------------
 void Metronome::removeObjectContent(){
-    
+    ControlThread::getInstance().cancelAndWait(metroTimer);
 }
 
 //--------------------------------------------------------------
@@ -180,3 +184,5 @@ void Metronome::onTextInputEvent(ofxDatGuiTextInputEvent e){
 
     }
 }
+
+OBJECT_REGISTER( Metronome, "metronome", "math", VP_OBJECT_GUI )
@@ -55,8 +55,12 @@ public:
     ofxDatGuiTextInput*     timeSetting;
 
     size_t                  wait;
-    size_t                  resetTime;
-    size_t                  metroTime;
+    size_t                  timerWait;
+
+    // ticks on the control thread, bangs handed to update() through the mailbox
+    ControlThread::TimerHandle  metroTimer;
+    ControlMailbox              bangMailbox;
+    vector<uint64_t>            bangTimes;
 
     bool                    sync;
     bool                    loaded;
@@ -38,18 +38,16 @@ Range::Range() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // input 1
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // input 2
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // input 1
+    *(float *)&_inletParams[1] = 0.0f;  // input 2
 
-    _outletParams[0] = new float(); // output 1
-    *(float *)&_outletParams[0] = 0.0f;
-    _outletParams[1] = new float(); // output 2
-    *(float *)&_outletParams[1] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output 1
+    *(float *)&_outletParams[1] = 0.0f; // output 2
 
     this->initInletsState();
 
+    isTimeDrivenObject  = false;
+
     isGUIObject         = true;
     this->isOverGUI     = true;
 
@@ -177,3 +175,5 @@ void Range::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( Range, "range", "math", VP_OBJECT_GUI )
@@ -38,11 +38,9 @@ SimpleNoise::SimpleNoise() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // step
-    *(float *)&_inletParams[0] = 0.001f;
+    *(float *)&_inletParams[0] = 0.001f;  // step
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -92,3 +90,5 @@ void SimpleNoise::drawObjectContent(ofxFontStash *font){
 void SimpleNoise::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( SimpleNoise, "simple noise", "math", VP_OBJECT_GUI )
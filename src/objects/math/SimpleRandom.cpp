@@ -38,15 +38,14 @@ SimpleRandom::SimpleRandom() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // bang
-    _inletParams[1] = new float();  // min
-    _inletParams[2] = new float();  // max
+    *(float *)&_inletParams[0] = 0.0f;  // bang
+    *(float *)&_inletParams[1] = 0.0f;  // min
+    *(float *)&_inletParams[2] = 0.0f;  // max
     *(float *)&_inletParams[0] = 0.0f;
     *(float *)&_inletParams[1] = 0.0f;
     *(float *)&_inletParams[2] = 1.0f;
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -68,7 +67,7 @@ void SimpleRandom::newObject(){
 
 //--------------------------------------------------------------
 void SimpleRandom::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
-    ofSeedRandom(ofGetElapsedTimeMillis());
+    ofSeedRandom(PatchClock::getInstance().getElapsedTimeMillis());
 
     gui = new ofxDatGui( ofxDatGuiAnchor::TOP_RIGHT );
     gui->setAutoDraw(false);
@@ -83,16 +82,21 @@ void SimpleRandom::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow){
 
 //--------------------------------------------------------------
 void SimpleRandom::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd){
-    if(this->inletsConnected[0]){
-        if(*(float *)&_inletParams[0] < 1.0){
-            bang = false;
-        }else{
-            bang = true;
+    this->runWithInletEvents([this](){
+        if(this->inletsConnected[0]){
+            if(*(float *)&_inletParams[0] < 1.0){
+                bang = false;
+            }else{
+                bang = true;
+            }
         }
-    }
-    if(bang){
-        *(float *)&_outletParams[0] = ofRandom(*(float *)&_inletParams[1],*(float *)&_inletParams[2]);
-    }
+        if(bang){
+            *(float *)&_outletParams[0] = ofRandom(*(float *)&_inletParams[1],*(float *)&_inletParams[2]);
+        }
+    },[this](int inlet){
+        // a new random number for every bang event, the range inlets only set the range
+        return inlet == 0 && bang ? 0 : -1;
+    });
 
     gui->update();
     rPlotter->setValue(*(float *)&_outletParams[0]);
@@ -122,3 +126,5 @@ void SimpleRandom::drawObjectContent(ofxFontStash *font){
 void SimpleRandom::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( SimpleRandom, "simple random", "math", VP_OBJECT_GUI )
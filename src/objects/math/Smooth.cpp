@@ -38,13 +38,12 @@ Smooth::Smooth() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // input
-    _inletParams[1] = new float();  // smoothing
+    *(float *)&_inletParams[0] = 0.0f;  // input
+    *(float *)&_inletParams[1] = 0.0f;  // smoothing
     *(float *)&_inletParams[0] = 0.0f;
     *(float *)&_inletParams[1] = 1.0f;
 
-    _outletParams[0] = new float(); // output
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // output
 
     this->initInletsState();
 
@@ -147,3 +146,5 @@ void Smooth::dragGUIObject(ofVec3f _m){
 void Smooth::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"SMOOTHING");
 }
+
+OBJECT_REGISTER( Smooth, "smooth", "math", VP_OBJECT_GUI )
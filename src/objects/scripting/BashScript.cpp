@@ -39,10 +39,10 @@ BashScript::BashScript() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new string();         // control
-    *(string *)&_inletParams[0] = "";
+    *static_cast<string *>(_inletParams[0]) = "";
 
     _outletParams[0] = new string();        // output
-    *(string *)&_outletParams[0] = "";
+    *static_cast<string *>(_outletParams[0]) = "";
 
     this->initInletsState();
 
@@ -304,8 +304,7 @@ void BashScript::loadScript(string scriptFile){
         ofLog(OF_LOG_NOTICE," ");
 
         char buffer[128];
-        _outletParams[0] = new string();
-        *static_cast<string *>(_outletParams[0]) = "";
+        static_cast<string *>(_outletParams[0])->clear();
         while(!feof(execFile)){
             if(fgets(buffer, sizeof(buffer), execFile) != nullptr){
                 char *s = buffer;
@@ -385,3 +384,7 @@ void BashScript::pathChanged(const PathWatcher::Event &event) {
     }
 
 }
+
+#if defined(TARGET_LINUX) || defined(TARGET_OSX)
+OBJECT_REGISTER( BashScript, "bash script", "scripting", VP_OBJECT_GL )
+#endif
@@ -74,6 +74,9 @@ LuaScript::LuaScript() : PatchObject(){
     isError         = false;
     setupTrigger    = false;
 
+    isLuaInletConnected = false;
+    isLuaDataComputed   = false;
+
     lastLuaScript       = "";
     loadLuaScriptFlag   = false;
     saveLuaScriptFlag   = false;
@@ -253,30 +256,14 @@ void LuaScript::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
             static_cast<LiveCoding *>(_outletParams[1])->lua.scriptSetup();
         }
 
-        // receive external data
-        if(this->inletsConnected[0]){
-            for(int i=0;i<static_cast<int>(static_cast<vector<float> *>(_inletParams[0])->size());i++){
-                lua_getglobal(static_cast<LiveCoding *>(_outletParams[1])->lua, "_updateMosaicData");
-                lua_pushnumber(static_cast<LiveCoding *>(_outletParams[1])->lua,i+1);
-                lua_pushnumber(static_cast<LiveCoding *>(_outletParams[1])->lua,static_cast<vector<float> *>(_inletParams[0])->at(i));
-                lua_pcall(static_cast<LiveCoding *>(_outletParams[1])->lua,2,0,0);
+        // send internal data, read from the lua tables on the update pool last frame
+        if(isLuaDataComputed){
+            isLuaDataComputed = false;
+            if(!luaOutletData.empty()){
+                static_cast<vector<float> *>(_outletParams[2])->swap(luaOutletData);
             }
         }
 
-        // send internal data
-        size_t len = static_cast<LiveCoding *>(_outletParams[1])->lua.tableSize(luaTablename);
-        if(len > 0){
-            static_cast<vector<float> *>(_outletParams[2])->clear();
-            for(size_t s=0;s<len;s++){
-                lua_getglobal(static_cast<LiveCoding *>(_outletParams[1])->lua, "_getLUAOutletTableAt");
-                lua_pushnumber(static_cast<LiveCoding *>(_outletParams[1])->lua,s+1);
-                lua_pcall(static_cast<LiveCoding *>(_outletParams[1])->lua,1,1,0);
-                lua_Number tn = lua_tonumber(static_cast<LiveCoding *>(_outletParams[1])->lua, -2);
-                static_cast<vector<float> *>(_outletParams[2])->push_back(static_cast<float>(tn));
-            }
-            std::rotate(static_cast<vector<float> *>(_outletParams[2])->begin(),static_cast<vector<float> *>(_outletParams[2])->begin()+1,static_cast<vector<float> *>(_outletParams[2])->end());
-        }
-
 
         // update lua state
         ofSoundUpdate();
@@ -310,6 +297,43 @@ void LuaScript::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThre
     fbo->end();
     *static_cast<ofTexture *>(_outletParams[0]) = fbo->getTexture();
     ///////////////////////////////////////////
+
+    // receive external data: the lua tables exchange runs on the update pool,
+    // the script sees it at its next update
+    if(scriptLoaded && threadLoaded && !isError){
+        isLuaInletConnected = this->inletsConnected[0];
+        if(isLuaInletConnected){
+            luaInletData.assign(static_cast<vector<float> *>(_inletParams[0])->begin(),static_cast<vector<float> *>(_inletParams[0])->end());
+        }
+        this->requestCompute();
+    }
+}
+
+//--------------------------------------------------------------
+void LuaScript::computeObjectContent(){
+    if(isLuaInletConnected){
+        for(int i=0;i<static_cast<int>(luaInletData.size());i++){
+            lua_getglobal(static_cast<LiveCoding *>(_outletParams[1])->lua, "_updateMosaicData");
+            lua_pushnumber(static_cast<LiveCoding *>(_outletParams[1])->lua,i+1);
+            lua_pushnumber(static_cast<LiveCoding *>(_outletParams[1])->lua,luaInletData.at(i));
+            lua_pcall(static_cast<LiveCoding *>(_outletParams[1])->lua,2,0,0);
+        }
+    }
+
+    luaOutletData.clear();
+    size_t len = static_cast<LiveCoding *>(_outletParams[1])->lua.tableSize(luaTablename);
+    if(len > 0){
+        for(size_t s=0;s<len;s++){
+            lua_getglobal(static_cast<LiveCoding *>(_outletParams[1])->lua, "_getLUAOutletTableAt");
+            lua_pushnumber(static_cast<LiveCoding *>(_outletParams[1])->lua,s+1);
+            lua_pcall(static_cast<LiveCoding *>(_outletParams[1])->lua,1,1,0);
+            lua_Number tn = lua_tonumber(static_cast<LiveCoding *>(_outletParams[1])->lua, -2);
+            luaOutletData.push_back(static_cast<float>(tn));
+        }
+        std::rotate(luaOutletData.begin(),luaOutletData.begin()+1,luaOutletData.end());
+    }
+
+    isLuaDataComputed = true;
 }
 
 //--------------------------------------------------------------
@@ -625,3 +649,5 @@ void LuaScript::errorReceived(std::string& msg) {
         }
     }
 }
+
+OBJECT_REGISTER( LuaScript, "lua script", "scripting", VP_OBJECT_GL )
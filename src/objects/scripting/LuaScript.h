@@ -51,6 +51,7 @@ public:
     void            newObject();
     void            setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow);
     void            updateObjectContent(map<int,PatchObject*> &patchObjects, ofxThreadedFileDialog &fd);
+    void            computeObjectContent();
     void            drawObjectContent(ofxFontStash *font);
     void            removeObjectContent();
     void            mouseMovedObjectContent(ofVec3f _m);
@@ -101,6 +102,12 @@ public:
     string              luaTablename;
     string              tempstring;
 
+    // compute step: inlet data in, lua outlet table out (published on the next update)
+    vector<float>       luaInletData;
+    vector<float>       luaOutletData;
+    bool                isLuaInletConnected;
+    bool                isLuaDataComputed;
+
     string              lastLuaScript;
     bool                loadLuaScriptFlag;
     bool                saveLuaScriptFlag;
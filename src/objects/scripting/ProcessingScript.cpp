@@ -419,3 +419,4 @@ void ProcessingScript::pathChanged(const PathWatcher::Event &event) {
 
 }
 
+OBJECT_REGISTER( ProcessingScript, "processing script", "scripting", VP_OBJECT_GL )
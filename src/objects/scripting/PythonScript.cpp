@@ -442,3 +442,4 @@ void PythonScript::pathChanged(const PathWatcher::Event &event) {
 
 }
 
+OBJECT_REGISTER( PythonScript, "python script", "scripting", VP_OBJECT_GL )
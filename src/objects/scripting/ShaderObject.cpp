@@ -223,7 +223,7 @@ void ShaderObject::updateObjectContent(map<int,PatchObject*> &patchObjects, ofxT
             shader->setUniformTexture(texName.c_str(),textures[i]->getTexture(),i+1);
         }
         shader->setUniform2f("resolution",static_cast<float>(output_width),static_cast<float>(output_height));
-        shader->setUniform1f("time",static_cast<float>(ofGetElapsedTimef()));
+        shader->setUniform1f("time",static_cast<float>(PatchClock::getInstance().getElapsedTimef()));
 
         for(int i=0;i<this->numInlets;i++){
             if(this->inletsConnected[i] && this->getInletType(i) == VP_LINK_NUMERIC){
@@ -441,7 +441,6 @@ void ShaderObject::doFragmentShader(){
             shaderSliders.push_back(tempSlider);
             shaderSlidersIndex.push_back(i);
 
-            _inletParams[this->numInlets] = new float();
             *(float *)&_inletParams[this->numInlets] = 0.0f;
             this->numInlets++;
             this->addInlet(VP_LINK_NUMERIC,varName);
@@ -471,7 +470,6 @@ void ShaderObject::doFragmentShader(){
             shaderSliders.push_back(tempSlider);
             shaderSlidersIndex.push_back(i);
 
-            _inletParams[this->numInlets] = new float();
             *(float *)&_inletParams[this->numInlets] = 0.0f;
             this->numInlets++;
             this->addInlet(VP_LINK_NUMERIC,varName);
@@ -728,3 +726,5 @@ void ShaderObject::pathChanged(const PathWatcher::Event &event) {
     }
 
 }
+
+OBJECT_REGISTER( ShaderObject, "shader object", "scripting", VP_OBJECT_GL )
@@ -155,7 +155,7 @@ void AudioDevice::resetSystemObject(){
 
     deviceLoaded      = false;
 
-    if (XML.loadFile(patchFile)){
+    if (PatchDocument::getInstance().load(patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
 
         if (XML.pushTag("settings")){
@@ -276,7 +276,7 @@ void AudioDevice::resetSystemObject(){
             }
         }
 
-        XML.saveFile();
+        PatchDocument::getInstance().save(patchFile,XML);
 
         deviceLoaded      = true;
     }
@@ -286,7 +286,7 @@ void AudioDevice::resetSystemObject(){
 void AudioDevice::loadDeviceInfo(){
     ofxXmlSettings XML;
 
-    if (XML.loadFile(patchFile)){
+    if (PatchDocument::getInstance().load(patchFile,XML)){
         if (XML.pushTag("settings")){
             in_channels  = XML.getValue("input_channels",0);
             out_channels = XML.getValue("output_channels",0);
@@ -372,3 +372,5 @@ void AudioDevice::loadDeviceInfo(){
         deviceLoaded      = true;
     }
 }
+
+OBJECT_REGISTER( AudioDevice, "audio device", "", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -51,8 +51,6 @@ AudioExporter::AudioExporter() : PatchObject(){
     audioSaved          = false;
 
     audioFPS            = 0.0f;
-    audioCounter        = 0;
-    lastAudioTimeReset  = ofGetElapsedTimeMillis();
 }
 
 //--------------------------------------------------------------
@@ -107,13 +105,12 @@ void AudioExporter::updateObjectContent(map<int,PatchObject*> &patchObjects, ofx
 
     if(exportAudioFlag){
         exportAudioFlag = false;
-        fd.saveFile("export audiofile"+ofToString(this->getId()),"Export new mp3 320kb audio file as","export.mp3");
+        fd.saveFile("export audiofile"+ofToString(this->getId()),"Export new audio file as (wav, mp3 320kb)","export.wav");
     }
 
     if(audioSaved){
         audioSaved = false;
-        recorder.setOutputPath(filepath);
-        recorder.startCustomAudioRecord();
+        startRecording();
     }
 
 }
@@ -124,36 +121,43 @@ void AudioExporter::drawObjectContent(ofxFontStash *font){
     ofSetCircleResolution(50);
     ofEnableAlphaBlending();
     if(this->inletsConnected[0]){
+        scopeRing.buildWaveform(waveform,this->width,headerHeight,this->height);
         waveform.draw();
     }
     if (recorder.isPaused() && recorder.isRecording()){
         ofSetColor(ofColor::yellow);
-    }else if (recorder.isRecording()){
+    }else if (writer.isRecording()){
         ofSetColor(ofColor::red);
     }else{
         ofSetColor(ofColor::green);
     }
     ofDrawCircle(ofPoint(this->width-20, 30), 10);
+    if(writer.isRecording()){
+        ofSetColor(255);
+        font->draw("queue "+ofToString(writer.getQueueDepth())+" overruns "+ofToString(writer.getOverruns()),this->fontSize,10,this->headerHeight*2.3);
+    }
     gui->draw();
     ofDisableAlphaBlending();
 }
 
 //--------------------------------------------------------------
 void AudioExporter::removeObjectContent(){
-
+    stopRecording();
 }
 
 //--------------------------------------------------------------
 void AudioExporter::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
 
-            XML.popTag();
-        }
+        // audio buffers per second, for the encoder
+        audioFPS = bufferSize > 0 ? static_cast<float>(sampleRate)/static_cast<float>(bufferSize) : 0.0f;
+
+        scopeRing.allocate(bufferSize);
     }
 }
 
@@ -197,25 +201,16 @@ void AudioExporter::dragGUIObject(ofVec3f _m){
 
 //--------------------------------------------------------------
 void AudioExporter::audioInObject(ofSoundBuffer &inputBuffer){
-    if(ofGetElapsedTimeMillis()-lastAudioTimeReset >= 1000){
-        lastAudioTimeReset = ofGetElapsedTimeMillis();
-        audioFPS = audioCounter;
-        audioCounter = 0;
-    }else{
-        audioCounter++;
-    }
-
     if(this->inletsConnected[0]){
-        if(recorder.isRecording()){
-            recorder.addBuffer(*static_cast<ofSoundBuffer *>(_inletParams[0]),audioFPS);
+        // copied to the writer ring, disk and encoder work happen on the writer thread
+        if(writer.isRecording()){
+            writer.push(*static_cast<ofSoundBuffer *>(_inletParams[0]));
         }
 
-        waveform.clear();
-        for(size_t i = 0; i < static_cast<ofSoundBuffer *>(_inletParams[0])->getNumFrames(); i++) {
-            float sample = static_cast<ofSoundBuffer *>(_inletParams[0])->getSample(i,0);
-            float x = ofMap(i, 0, static_cast<ofSoundBuffer *>(_inletParams[0])->getNumFrames(), 0, this->width);
-            float y = ofMap(hardClip(sample), -1, 1, headerHeight, this->height);
-            waveform.addVertex(x, y);
+        // first channel to the display, the waveform is built in drawObjectContent
+        ofSoundBuffer *input = static_cast<ofSoundBuffer *>(_inletParams[0]);
+        if(input->getNumFrames() > 0){
+            scopeRing.push(input->getBuffer().data(),input->getNumFrames(),input->getNumChannels());
         }
     }
 }
@@ -228,21 +223,49 @@ void AudioExporter::fileDialogResponse(ofxThreadedFileDialogResponse &response){
     }
 }
 
+//--------------------------------------------------------------
+void AudioExporter::startRecording(){
+    int numChannels = std::max(static_cast<int>(static_cast<ofSoundBuffer *>(_inletParams[0])->getNumChannels()),1);
+    string extension = ofToLower(ofFilePath::getFileExt(filepath));
+
+    if(extension == "wav" || extension == "rf64"){
+        // float WAV written by the writer thread, RF64 past 4 GB
+        writer.startFile(filepath,sampleRate,numChannels);
+    }else{
+        // compressed formats through ffmpeg, fed from the writer thread
+        recorder.setOutputPath(filepath);
+        recorder.startCustomAudioRecord();
+        writer.startCallback(sampleRate,numChannels,[this](const float *interleaved, size_t numFrames, int channels){
+            encoderBuffer.copyFrom(interleaved,numFrames,static_cast<size_t>(channels),static_cast<unsigned int>(sampleRate));
+            recorder.addBuffer(encoderBuffer,audioFPS);
+        });
+    }
+}
+
+//--------------------------------------------------------------
+void AudioExporter::stopRecording(){
+    // drains the ring before closing the file or the encoder
+    writer.stop();
+    if(recorder.isRecording()){
+        recorder.stop();
+    }
+}
+
 //--------------------------------------------------------------
 void AudioExporter::onToggleEvent(ofxDatGuiToggleEvent e){
     if(!header->getIsCollapsed()){
         if(e.target == recButton){
             if(e.checked){
-                if(!recorder.isRecording()){
+                if(!writer.isRecording()){
                     exportAudioFlag = true;
                 }
                 ofLog(OF_LOG_NOTICE,"START EXPORTING AUDIO");
             }else{
-                if(recorder.isRecording()){
-                    recorder.stop();
-                }
+                stopRecording();
                 ofLog(OF_LOG_NOTICE,"FINISHED EXPORTING AUDIO");
             }
         }
     }
 }
+
+OBJECT_REGISTER( AudioExporter, "audio exporter", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN )
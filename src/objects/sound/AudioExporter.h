@@ -35,6 +35,7 @@
 #include "PatchObject.h"
 
 #include "ofxFFmpegRecorder.h"
+#include "AudioFileWriter.h"
 
 
 class AudioExporter : public PatchObject {
@@ -50,6 +51,8 @@ public:
     void            removeObjectContent();
 
     void            loadAudioSettings();
+    void            startRecording();
+    void            stopRecording();
 
     void            audioInObject(ofSoundBuffer &inputBuffer);
 
@@ -60,6 +63,9 @@ public:
     void            onToggleEvent(ofxDatGuiToggleEvent e);
 
     ofxFFmpegRecorder   recorder;
+    AudioFileWriter     writer;
+    ofSoundBuffer       encoderBuffer;
+    ScopeRing           scopeRing;
     ofPolyline          waveform;
 
     bool                exportAudioFlag;
@@ -68,9 +74,7 @@ public:
     int                 bufferSize;
     int                 sampleRate;
 
-    size_t              lastAudioTimeReset;
     float               audioFPS;
-    int                 audioCounter;
 
     ofxDatGui*          gui;
     ofxDatGuiHeader*    header;
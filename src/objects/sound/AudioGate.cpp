@@ -38,8 +38,7 @@ AudioGate::AudioGate() : PatchObject(){
     this->numInlets  = 6;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // open
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // open
 
     _inletParams[1] = new ofSoundBuffer();  // sig1
     _inletParams[2] = new ofSoundBuffer();  // sig2
@@ -146,3 +145,5 @@ void AudioGate::audioOutObject(ofSoundBuffer &outputBuffer){
         *static_cast<ofSoundBuffer *>(_outletParams[0]) *= 0.0f;
     }
 }
+
+OBJECT_REGISTER( AudioGate, "audio gate", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_OUT )
@@ -40,8 +40,7 @@ Crossfader::Crossfader() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer();  // audio in 1
     _inletParams[1] = new ofSoundBuffer();  // audio in 2
-    _inletParams[2] = new float();          // fade
-    *(float *)&_inletParams[2] = 0.0f;
+    *(float *)&_inletParams[2] = 0.0f;          // fade
 
     _outletParams[0] = new ofSoundBuffer(); // audio output L
 
@@ -145,14 +144,12 @@ void Crossfader::removeObjectContent(){
 
 //--------------------------------------------------------------
 void Crossfader::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -208,3 +205,5 @@ void Crossfader::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"FADE");
     fade_ctrl.set(ofClamp(static_cast<float>(e.value),0.0f,1.0f));
 }
+
+OBJECT_REGISTER( Crossfader, "crossfader", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
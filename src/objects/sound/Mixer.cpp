@@ -119,14 +119,12 @@ void Mixer::removeObjectContent(){
 
 //--------------------------------------------------------------
 void Mixer::loadAudioSettings(){
-    ofxXmlSettings XML;
-
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
+
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -140,3 +138,5 @@ void Mixer::audioOutObject(ofSoundBuffer &outputBuffer){
     // SIGNAL BUFFER
     static_cast<ofSoundBuffer *>(_outletParams[0])->copyFrom(scope.getBuffer().data(), bufferSize, 1, sampleRate);
 }
+
+OBJECT_REGISTER( Mixer, "mixer", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
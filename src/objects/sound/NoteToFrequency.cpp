@@ -83,14 +83,11 @@ NoteToFrequency::NoteToFrequency() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 3;
 
-    _inletParams[0] = new float();  // midi [0 - 127]
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // midi [0 - 127]
 
-    _outletParams[0] = new float(); // frequency
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f; // frequency
 
-    _outletParams[1] = new float(); // pitch
-    *(float *)&_outletParams[1] = 0.0f;
+    *(float *)&_outletParams[1] = 0.0f; // pitch
 
     _outletParams[2] = new string(); // pitch
     *static_cast<string *>(_outletParams[2]) = "";
@@ -213,3 +210,5 @@ float NoteToFrequency::noteToHarmonicFrequency(int _note){
 float NoteToFrequency::frequencyToPitch(float freq){
     return pdsp::f2p(freq);
 }
+
+OBJECT_REGISTER( NoteToFrequency, "note to frequency", "sound", VP_OBJECT_GL )
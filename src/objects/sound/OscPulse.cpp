@@ -38,10 +38,8 @@ OscPulse::OscPulse() : PatchObject(){
     this->numInlets  = 2;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // pitch
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // pulse width
-    *(float *)&_inletParams[1] = 0.5f;
+    *(float *)&_inletParams[0] = 0.0f;  // pitch
+    *(float *)&_inletParams[1] = 0.5f;  // pulse width
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
     _outletParams[1] = new vector<float>(); // audio buffer
@@ -145,6 +143,7 @@ void OscPulse::drawObjectContent(ofxFontStash *font){
     ofDrawRectangle(0,0,this->width,this->height);
     ofEnableAlphaBlending();
     ofSetColor(255,255,120);
+    scopeRing.buildWaveform(waveform,this->width,headerHeight,this->height);
     waveform.draw();
     ofSetColor(255);
     gui->draw();
@@ -160,34 +159,31 @@ void OscPulse::removeObjectContent(){
 
 //--------------------------------------------------------------
 void OscPulse::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
 
-            for(int i=0;i<bufferSize;i++){
-                static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
-            }
-
-            XML.popTag();
+        for(int i=0;i<bufferSize;i++){
+            static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
         }
+
+        scopeRing.allocate(bufferSize);
     }
 }
 
 //--------------------------------------------------------------
 void OscPulse::audioOutObject(ofSoundBuffer &outputBuffer){
-    waveform.clear();
-    for(size_t i = 0; i < scope.getBuffer().size(); i++) {
-        float sample = scope.getBuffer().at(i);
-        float x = ofMap(i, 0, scope.getBuffer().size(), 0, this->width);
-        float y = ofMap(hardClip(sample), -1, 1, headerHeight, this->height);
-        waveform.addVertex(x, y);
-
-        // SIGNAL BUFFER DATA
-        static_cast<vector<float> *>(_outletParams[1])->at(i) = sample;
-    }
+    // audio thread: copies only, the display waveform is built in drawObjectContent
+    scopeRing.push(scope.getBuffer().data(),scope.getBuffer().size());
+
+    // SIGNAL BUFFER DATA
+    vector<float> *data = static_cast<vector<float> *>(_outletParams[1]);
+    size_t numSamples = std::min(scope.getBuffer().size(),data->size());
+    std::copy(scope.getBuffer().begin(),scope.getBuffer().begin()+numSamples,data->begin());
+
     // SIGNAL BUFFER
     static_cast<ofSoundBuffer *>(_outletParams[0])->copyFrom(scope.getBuffer().data(), bufferSize, 1, sampleRate);
 }
@@ -246,3 +242,5 @@ void OscPulse::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( OscPulse, "pulse", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_OUT )
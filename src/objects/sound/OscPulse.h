@@ -62,6 +62,7 @@ public:
     pdsp::ValueControl      pitch_ctrl;
     pdsp::ValueControl      pw_ctrl;
 
+    ScopeRing               scopeRing;
     ofPolyline              waveform;
 
     ofxDatGui*              gui;
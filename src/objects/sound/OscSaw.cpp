@@ -38,8 +38,7 @@ OscSaw::OscSaw() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();  // pitch
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // pitch
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
     _outletParams[1] = new vector<float>(); // audio buffer
@@ -127,6 +126,7 @@ void OscSaw::drawObjectContent(ofxFontStash *font){
     ofDrawRectangle(0,0,this->width,this->height);
     ofEnableAlphaBlending();
     ofSetColor(255,255,120);
+    scopeRing.buildWaveform(waveform,this->width,headerHeight,this->height);
     waveform.draw();
     ofSetColor(255);
     gui->draw();
@@ -142,34 +142,31 @@ void OscSaw::removeObjectContent(){
 
 //--------------------------------------------------------------
 void OscSaw::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
 
-            for(int i=0;i<bufferSize;i++){
-                static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
-            }
-
-            XML.popTag();
+        for(int i=0;i<bufferSize;i++){
+            static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
         }
+
+        scopeRing.allocate(bufferSize);
     }
 }
 
 //--------------------------------------------------------------
 void OscSaw::audioOutObject(ofSoundBuffer &outputBuffer){
-    waveform.clear();
-    for(size_t i = 0; i < scope.getBuffer().size(); i++) {
-        float sample = scope.getBuffer().at(i);
-        float x = ofMap(i, 0, scope.getBuffer().size(), 0, this->width);
-        float y = ofMap(hardClip(sample), -1, 1, headerHeight, this->height);
-        waveform.addVertex(x, y);
-
-        // SIGNAL BUFFER DATA
-        static_cast<vector<float> *>(_outletParams[1])->at(i) = sample;
-    }
+    // audio thread: copies only, the display waveform is built in drawObjectContent
+    scopeRing.push(scope.getBuffer().data(),scope.getBuffer().size());
+
+    // SIGNAL BUFFER DATA
+    vector<float> *data = static_cast<vector<float> *>(_outletParams[1]);
+    size_t numSamples = std::min(scope.getBuffer().size(),data->size());
+    std::copy(scope.getBuffer().begin(),scope.getBuffer().begin()+numSamples,data->begin());
+
     // SIGNAL BUFFER
     static_cast<ofSoundBuffer *>(_outletParams[0])->copyFrom(scope.getBuffer().data(), bufferSize, 1, sampleRate);
 }
@@ -218,3 +215,5 @@ void OscSaw::onSliderEvent(ofxDatGuiSliderEvent e){
     pitch_ctrl.set(ofClamp(static_cast<float>(e.value),0,127));
     oscInfo->setLabel(ofToString(pdsp::PitchToFreq::eval(ofClamp(static_cast<float>(e.value),0,127))) + " Hz");
 }
+
+OBJECT_REGISTER( OscSaw, "saw", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_OUT )
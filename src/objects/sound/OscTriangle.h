@@ -61,6 +61,7 @@ public:
     pdsp::Scope             scope;
     pdsp::ValueControl      pitch_ctrl;
 
+    ScopeRing               scopeRing;
     ofPolyline              waveform;
 
     ofxDatGui*              gui;
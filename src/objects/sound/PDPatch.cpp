@@ -402,35 +402,39 @@ void PDPatch::dragGUIObject(ofVec3f _m){
 
 //--------------------------------------------------------------
 void PDPatch::loadAudioSettings(){
-    ofxXmlSettings XML;
-
-    if (XML.loadFile(this->patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
-        int totalObjects = XML.getNumTags("object");
-
-        // Load object outlet config
-        for(int i=0;i<totalObjects;i++){
-            if(XML.pushTag("object", i)){
-                if(XML.getValue("id", -1) == this->nId){
-                    if (XML.pushTag("vars")){
-                        int totalVars = XML.getNumTags("var");
-
-                        for (int t=0;t<totalVars;t++){
-                            if(XML.pushTag("var",t)){
-                                prevExternalsFolder = XML.getValue("name","");
-                                //ofLog(OF_LOG_NOTICE,"%s",prevExternalsFolder.c_str());
-                                XML.popTag();
+    // read in place, no copy of the whole patch
+    {
+        PatchDocument::Access doc = PatchDocument::getInstance().access(this->patchFile);
+        ofxXmlSettings &XML = doc.getXml();
+
+        if (doc.isLoaded()){
+            if (XML.pushTag("settings")){
+                sampleRate = XML.getValue("sample_rate_in",0);
+                bufferSize = XML.getValue("buffer_size",0);
+                XML.popTag();
+            }
+            int totalObjects = XML.getNumTags("object");
+
+            // Load object outlet config
+            for(int i=0;i<totalObjects;i++){
+                if(XML.pushTag("object", i)){
+                    if(XML.getValue("id", -1) == this->nId){
+                        if (XML.pushTag("vars")){
+                            int totalVars = XML.getNumTags("var");
+
+                            for (int t=0;t<totalVars;t++){
+                                if(XML.pushTag("var",t)){
+                                    prevExternalsFolder = XML.getValue("name","");
+                                    //ofLog(OF_LOG_NOTICE,"%s",prevExternalsFolder.c_str());
+                                    XML.popTag();
+                                }
                             }
-                        }
 
-                        XML.popTag();
+                            XML.popTag();
+                        }
                     }
+                    XML.popTag();
                 }
-                XML.popTag();
             }
         }
     }
@@ -624,3 +628,5 @@ void PDPatch::receivePolyAftertouch(const int channel, const int pitch, const in
 void PDPatch::receiveMidiByte(const int port, const int byte) {
     //ofLog(OF_LOG_NOTICE,"Mosaic MIDI: midi byte: %i %i", port, byte);
 }
+
+OBJECT_REGISTER( PDPatch, "pd patch", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
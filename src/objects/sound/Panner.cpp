@@ -39,8 +39,7 @@ Panner::Panner() : PatchObject(){
     this->numOutlets = 2;
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
-    _inletParams[1] = new float();          // gain
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // gain
 
     _outletParams[0] = new ofSoundBuffer(); // audio output L
     _outletParams[1] = new ofSoundBuffer(); // audio output R
@@ -146,14 +145,12 @@ void Panner::removeObjectContent(){
 
 //--------------------------------------------------------------
 void Panner::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -210,3 +207,5 @@ void Panner::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"PAN");
     pan_ctrl.set(ofClamp(static_cast<float>(e.value),-1.0f,1.0f));
 }
+
+OBJECT_REGISTER( Panner, "panner", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
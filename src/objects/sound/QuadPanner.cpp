@@ -39,8 +39,8 @@ QuadPanner::QuadPanner() : PatchObject(){
     this->numOutlets = 4;
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
-    _inletParams[1] = new float();          // pan X
-    _inletParams[2] = new float();          // pan Y
+    *(float *)&_inletParams[1] = 0.0f;          // pan X
+    *(float *)&_inletParams[2] = 0.0f;          // pan Y
     *(float *)&_inletParams[1] = 0.0f;
     *(float *)&_inletParams[2] = 0.0f;
 
@@ -192,14 +192,12 @@ void QuadPanner::removeObjectContent(){
 
 //--------------------------------------------------------------
 void QuadPanner::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -260,3 +258,5 @@ void QuadPanner::on2dPadEvent(ofxDatGui2dPadEvent e){
     gain_ctrl3.set(ofClamp(static_cast<float>(e.y/pad->getBounds().height),0.0f,1.0f) * ofClamp(ofMap(static_cast<float>(e.x/pad->getBounds().width),0.0,1.0,1.0,0.0),0.0f,1.0f));
     gain_ctrl4.set(ofClamp(static_cast<float>(e.y/pad->getBounds().height),0.0f,1.0f) * static_cast<float>(e.x/pad->getBounds().width));
 }
+
+OBJECT_REGISTER( QuadPanner, "quad panner", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -39,8 +39,7 @@ SigMult::SigMult() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
-    _inletParams[1] = new float();          // gain
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // gain
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -150,14 +149,12 @@ void SigMult::removeObjectContent(){
 
 //--------------------------------------------------------------
 void SigMult::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -212,3 +209,5 @@ void SigMult::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"GAIN");
     gain_ctrl.set(ofClamp(static_cast<float>(e.value),0.0f,12.0f));
 }
+
+OBJECT_REGISTER( SigMult, "amp", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -39,11 +39,9 @@ SignalTrigger::SignalTrigger() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofSoundBuffer();  // audio in
-    _inletParams[1] = new float();          // threshold
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // threshold
 
-    _outletParams[0] = new float();         // signal trigger --> bang
-    *(float *)&_outletParams[0] = 0.0f;
+    *(float *)&_outletParams[0] = 0.0f;         // signal trigger --> bang
 
     this->initInletsState();
 
@@ -153,14 +151,12 @@ void SignalTrigger::removeObjectContent(){
 
 //--------------------------------------------------------------
 void SignalTrigger::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -215,3 +211,5 @@ void SignalTrigger::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"THRESHOLD");
     thresh_ctrl.set(ofClamp(static_cast<float>(e.value),0.0f,1.0f));
 }
+
+OBJECT_REGISTER( SignalTrigger, "signal trigger", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
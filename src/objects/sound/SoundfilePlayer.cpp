@@ -40,14 +40,10 @@ SoundfilePlayer::SoundfilePlayer() : PatchObject(){
 
     _inletParams[0] = new string();  // control
     *static_cast<string *>(_inletParams[0]) = "";
-    _inletParams[1] = new float();  // playhead
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();  // speed
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();  // volume
-    *(float *)&_inletParams[3] = 0.0f;
-    _inletParams[4] = new float();  // trigger
-    *(float *)&_inletParams[4] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // playhead
+    *(float *)&_inletParams[2] = 0.0f;  // speed
+    *(float *)&_inletParams[3] = 0.0f;  // volume
+    *(float *)&_inletParams[4] = 0.0f;  // trigger
 
     _outletParams[0] = new ofSoundBuffer();  // signal
     _outletParams[1] = new vector<float>(); // audio buffer
@@ -61,6 +57,7 @@ SoundfilePlayer::SoundfilePlayer() : PatchObject(){
 
     isNewObject         = false;
     isFileLoaded        = false;
+    isFileLoading       = false;
     isPlaying           = false;
     audioWasPlaying     = false;
     lastMessage         = "";
@@ -71,6 +68,11 @@ SoundfilePlayer::SoundfilePlayer() : PatchObject(){
     sampleRate          = 44100.0;
     bufferSize          = 256;
 
+    stream              = nullptr;
+    renderingStream     = false;
+    loadRequest         = 0;
+    interpolation       = VP_INTERPOLATION_LINEAR;
+
     lastSoundfile       = "";
     loadSoundfileFlag   = false;
     soundfileLoaded     = false;
@@ -91,6 +93,8 @@ void SoundfilePlayer::newObject(){
     this->addInlet(VP_LINK_NUMERIC,"bang");
     this->addOutlet(VP_LINK_AUDIO,"audioFileSignal");
     this->addOutlet(VP_LINK_ARRAY,"dataBuffer");
+
+    this->setCustomVar(static_cast<float>(VP_INTERPOLATION_LINEAR),"INTERPOLATION");
 }
 
 //--------------------------------------------------------------
@@ -110,6 +114,7 @@ void SoundfilePlayer::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow
     gui->setUseCustomMouse(true);
     gui->setWidth(this->width);
     gui->onButtonEvent(this, &SoundfilePlayer::onButtonEvent);
+    gui->onToggleEvent(this, &SoundfilePlayer::onToggleEvent);
 
     header = gui->addHeader("CONFIG",false);
     header->setUseCustomMouse(true);
@@ -118,6 +123,9 @@ void SoundfilePlayer::setupObjectContent(shared_ptr<ofAppGLFWWindow> &mainWindow
     gui->addBreak();
     loadButton = gui->addButton("OPEN");
     loadButton->setUseCustomMouse(true);
+    interpolation = static_cast<int>(this->getCustomVar("INTERPOLATION")) == VP_INTERPOLATION_SINC ? VP_INTERPOLATION_SINC : VP_INTERPOLATION_LINEAR;
+    sincToggle = gui->addToggle("SINC INTERPOLATION",interpolation == VP_INTERPOLATION_SINC);
+    sincToggle->setUseCustomMouse(true);
 
     gui->setPosition(0,this->height - header->getHeight());
     gui->collapse();
@@ -140,6 +148,7 @@ void SoundfilePlayer::updateObjectContent(map<int,PatchObject*> &patchObjects, o
     gui->update();
     header->update();
     loadButton->update();
+    sincToggle->update();
 
     if(loadSoundfileFlag){
         loadSoundfileFlag = false;
@@ -166,12 +175,14 @@ void SoundfilePlayer::updateObjectContent(map<int,PatchObject*> &patchObjects, o
         }
     }
 
-    if(!isFileLoaded && audiofile.loaded() && audiofile.samplerate() > 100){
+    SoundfileStream *currentStream = stream.load();
+
+    if(!isFileLoaded && !isFileLoading && currentStream != nullptr && currentStream->getSampleRate() > 100){
         isFileLoaded = true;
-        ofLog(OF_LOG_NOTICE,"[verbose] sound file loaded: %s, Sample Rate: %s, Audiofile length: %s",filepath.c_str(), ofToString(audiofile.samplerate()).c_str(), ofToString(audiofile.length()).c_str());
+        ofLog(OF_LOG_NOTICE,"[verbose] sound file loaded: %s, Sample Rate: %s, Audiofile length: %s%s",filepath.c_str(), ofToString(currentStream->getSampleRate()).c_str(), ofToString(currentStream->getLength()).c_str(), currentStream->getIsStreaming() ? ", streaming" : "");
     }
 
-    if(isFileLoaded && audiofile.loaded()){
+    if(isFileLoaded && currentStream != nullptr){
         // listen to message control (_inletParams[0])
         if(this->inletsConnected[0]){
             if(lastMessage != *static_cast<string *>(_inletParams[0])){
@@ -200,7 +211,7 @@ void SoundfilePlayer::updateObjectContent(map<int,PatchObject*> &patchObjects, o
         }
         // playhead
         if(this->inletsConnected[1] && *(float *)&_inletParams[1] != -1.0f){
-            playhead = static_cast<double>(*(float *)&_inletParams[1]) * audiofile.length();
+            playhead = static_cast<double>(*(float *)&_inletParams[1]) * currentStream->getLength();
         }
         // speed
         if(this->inletsConnected[2]){
@@ -230,7 +241,8 @@ void SoundfilePlayer::updateObjectContent(map<int,PatchObject*> &patchObjects, o
 void SoundfilePlayer::drawObjectContent(ofxFontStash *font){
     ofSetColor(255);
     ofEnableAlphaBlending();
-    if(isFileLoaded && audiofile.loaded()){
+    SoundfileStream *currentStream = stream.load();
+    if(isFileLoaded && currentStream != nullptr){
         posX = 0;
         posY = this->headerHeight;
         drawW = this->width;
@@ -243,9 +255,10 @@ void SoundfilePlayer::drawObjectContent(ofxFontStash *font){
 
         ofSetColor(255,255,120,255);
         ofSetLineWidth(1);
+        // peaks overview, filled in background for the streamed files
         for( int x=0; x<drawW; ++x){
-            int n = ofMap( x, 0, drawW, 0, audiofile.length(), true );
-            float val = audiofile.sample( n, 0 );
+            size_t bin = static_cast<size_t>(ofMap( x, 0, drawW, 0, STREAM_OVERVIEW_SIZE-1, true ));
+            float val = currentStream->getOverview(bin);
             ofDrawLine(x+posX, (drawH*0.5)+posY - (val*(drawH*0.5)),x+posX, ((drawH*0.5)+posY) + (val*(drawH*0.5)));
         }
 
@@ -266,7 +279,7 @@ void SoundfilePlayer::drawObjectContent(ofxFontStash *font){
 
         ofSetColor(255);
         ofSetLineWidth(2);
-        float phx = ofMap( playhead, 0, audiofile.length(), 0, drawW );
+        float phx = ofMap( playhead, 0, currentStream->getLength(), 0, drawW );
         ofDrawLine( phx, posY+2, phx, drawH+posY);
     }else if(!isNewObject && !loading){
         ofSetColor(255,0,0);
@@ -283,6 +296,8 @@ void SoundfilePlayer::removeObjectContent(){
     for(map<int,pdsp::PatchNode>::iterator it = this->pdspOut.begin(); it != this->pdspOut.end(); it++ ){
         it->second.disconnectAll();
     }
+    isFileLoaded = false;
+    swapStream(nullptr);
 }
 
 //--------------------------------------------------------------
@@ -299,9 +314,10 @@ void SoundfilePlayer::mouseMovedObjectContent(ofVec3f _m){
     gui->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
     header->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
     loadButton->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
+    sincToggle->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
 
     if(!header->getIsCollapsed()){
-        this->isOverGUI = header->hitTest(_m-this->getPos()) || loadButton->hitTest(_m-this->getPos());
+        this->isOverGUI = header->hitTest(_m-this->getPos()) || loadButton->hitTest(_m-this->getPos()) || sincToggle->hitTest(_m-this->getPos());
     }else{
         this->isOverGUI = header->hitTest(_m-this->getPos());
     }
@@ -314,6 +330,7 @@ void SoundfilePlayer::dragGUIObject(ofVec3f _m){
         gui->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
         header->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
         loadButton->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
+        sincToggle->setCustomMousePos(static_cast<int>(_m.x - this->getPos().x),static_cast<int>(_m.y - this->getPos().y));
     }else{
         ofNotifyEvent(dragEvent, nId);
 
@@ -332,50 +349,38 @@ void SoundfilePlayer::dragGUIObject(ofVec3f _m){
 
 //--------------------------------------------------------------
 void SoundfilePlayer::audioOutObject(ofSoundBuffer &outputBuffer){
-    if(isFileLoaded && audiofile.loaded() && isPlaying){
-        for(size_t i = 0; i < monoBuffer.getNumFrames(); i++) {
-            int n = static_cast<int>(floor(playhead));
-
-            if(n < audiofile.length()-1){
-                float fract = static_cast<float>(playhead - n);
-                float isample = audiofile.sample(n, 0)*(1.0f-fract) + audiofile.sample(n+1, 0)*fract; // linear interpolation
-                monoBuffer.getSample(i,0) = isample * volume;
-
-                playhead += (step*speed);
-
-            }else{
-                monoBuffer.getSample(i,0) = 0.0f;
-                if(loop){
-                    // backword
-                    if(speed < 0.0){
-                        playhead = audiofile.length()-2;
-                    }else if(speed > 0.0){
-                        playhead = 0.0;
-                    }
-
-                }
-            }
+    float *samples = monoBuffer.getBuffer().data();
+    size_t numFrames = monoBuffer.getNumFrames();
+
+    // the stream is only swapped or deleted while this flag is down
+    renderingStream.store(true);
+    SoundfileStream *currentStream = stream.load();
+    if(isFileLoaded && currentStream != nullptr && isPlaying){
+        // block resampling from the stream cache, loops handled inside
+        currentStream->render(playhead,step*speed,loop,interpolation,samples,numFrames);
+        for(size_t i = 0; i < numFrames; i++) {
+            samples[i] *= volume;
         }
-        lastBuffer = monoBuffer;
     }else{
-        lastBuffer = monoBuffer * 0.0f;
+        std::fill(samples,samples+numFrames,0.0f);
     }
+    renderingStream.store(false);
 
-    fileOUT.copyInput(lastBuffer.getBuffer().data(),lastBuffer.getNumFrames());
-    *static_cast<ofSoundBuffer *>(_outletParams[0]) = lastBuffer;
+    fileOUT.copyInput(samples,numFrames);
+    *static_cast<ofSoundBuffer *>(_outletParams[0]) = monoBuffer;
     *static_cast<vector<float> *>(_outletParams[1]) = scope.getBuffer();
 
 }
 
 //--------------------------------------------------------------
 void SoundfilePlayer::loadSettings(){
-    ofxXmlSettings XML;
+    {
+        PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+        ofxXmlSettings &XML = settings.getXml();
 
-    if(XML.loadFile(patchFile)){
-        if(XML.pushTag("settings")){
+        if(settings.isValid()){
             sampleRate = static_cast<double>(XML.getValue("sample_rate_out",0));
             bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
         }
     }
 
@@ -397,14 +402,30 @@ void SoundfilePlayer::loadAudioFile(string audiofilepath){
 
     filepath = forceCheckMosaicDataPath(audiofilepath);
 
-    audiofile.free();
-    audiofile.load(filepath);
-    playhead = std::numeric_limits<int>::max();
-    step = audiofile.samplerate() / sampleRate;
-
-    ofSoundBuffer tmpBuffer(shortBuffer,static_cast<size_t>(bufferSize),1,static_cast<unsigned int>(sampleRate));
-    monoBuffer.clear();
-    monoBuffer = tmpBuffer;
+    // the audio thread stops reading the file, opened on the asset loader
+    isFileLoaded = false;
+    isFileLoading = true;
+
+    // every load owns its stream, only the latest request is swapped in
+    string path = filepath;
+    int request = ++loadRequest;
+    shared_ptr<unique_ptr<SoundfileStream>> loadedStream = make_shared<unique_ptr<SoundfileStream>>();
+    AssetLoader::getInstance().load([loadedStream,path](){
+        loadedStream->reset(new SoundfileStream());
+        if(!(*loadedStream)->open(path)){
+            loadedStream->reset();
+        }
+    },[this,loadedStream,request](){
+        if(this->getWillErase() || request != loadRequest){
+            return;
+        }
+        swapStream(loadedStream->release());
+        if(stream.load() != nullptr){
+            step = stream.load()->getSampleRate() / sampleRate;
+        }
+        playhead = 0.0;
+        isFileLoading = false;
+    });
 
     ofFile tempFile(filepath);
     if(tempFile.getFileName().size() > 44){
@@ -413,12 +434,22 @@ void SoundfilePlayer::loadAudioFile(string audiofilepath){
         soundfileName->setLabel(tempFile.getFileName());
     }
 
-    playhead = 0.0;
-
     this->saveConfig(false,this->nId);
 
-    isFileLoaded = false;
+}
+
+//--------------------------------------------------------------
+void SoundfilePlayer::swapStream(SoundfileStream *newStream){
+    SoundfileStream *oldStream = stream.exchange(newStream);
+
+    // wait for the audio callback to leave the old stream (one buffer at most)
+    while(renderingStream.load()){
+        std::this_thread::yield();
+    }
 
+    if(oldStream != nullptr){
+        delete oldStream;
+    }
 }
 
 //--------------------------------------------------------------
@@ -429,3 +460,16 @@ void SoundfilePlayer::onButtonEvent(ofxDatGuiButtonEvent e){
         }
     }
 }
+
+//--------------------------------------------------------------
+void SoundfilePlayer::onToggleEvent(ofxDatGuiToggleEvent e){
+    if(!header->getIsCollapsed()){
+        if (e.target == sincToggle){
+            interpolation = e.checked ? VP_INTERPOLATION_SINC : VP_INTERPOLATION_LINEAR;
+            this->setCustomVar(static_cast<float>(interpolation),"INTERPOLATION");
+            this->saveConfig(false,this->nId);
+        }
+    }
+}
+
+OBJECT_REGISTER( SoundfilePlayer, "soundfile player", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_OUT )
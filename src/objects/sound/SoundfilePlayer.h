@@ -33,6 +33,7 @@
 #pragma once
 
 #include "PatchObject.h"
+#include "SoundfileStream.h"
 
 class SoundfilePlayer : public PatchObject {
 
@@ -56,10 +57,11 @@ public:
 
     void            loadSettings();
     void            loadAudioFile(string audiofilepath);
+    void            swapStream(SoundfileStream *newStream);
 
     void            onButtonEvent(ofxDatGuiButtonEvent e);
+    void            onToggleEvent(ofxDatGuiToggleEvent e);
 
-    ofSoundBuffer       lastBuffer;
     ofSoundBuffer       monoBuffer;
     short               *shortBuffer;
     float               posX, posY, drawW, drawH;
@@ -68,11 +70,16 @@ public:
     bool                loop;
     bool                isNewObject;
     bool                isFileLoaded;
+    bool                isFileLoading;
     bool                isPlaying;
     bool                audioWasPlaying;
     string              lastMessage;
 
-    ofxAudioFile        audiofile;
+    // swapped on the main thread while the audio callback is out of it
+    std::atomic<SoundfileStream*>   stream;
+    std::atomic<bool>   renderingStream;
+    int                 loadRequest;
+    int                 interpolation;
     pdsp::ExternalInput fileOUT;
     pdsp::Scope         scope;
     double              playhead;
@@ -84,6 +91,7 @@ public:
     ofxDatGuiHeader*    header;
     ofxDatGuiLabel*     soundfileName;
     ofxDatGuiButton*    loadButton;
+    ofxDatGuiToggle*    sincToggle;
 
     size_t              startTime;
     bool                loading;
@@ -40,10 +40,8 @@ pdspADSR::pdspADSR() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer(); // audio input
 
-    _inletParams[1] = new float();          // bang
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();          // duration
-    *(float *)&_inletParams[2] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // bang
+    *(float *)&_inletParams[2] = 0.0f;          // duration
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -226,19 +224,16 @@ void pdspADSR::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspADSR::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
 
-            /*for(int i=0;i<bufferSize;i++){
-                static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
-            }*/
-
-            XML.popTag();
-        }
+        /*for(int i=0;i<bufferSize;i++){
+            static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
+        }*/
     }
 }
 
@@ -334,3 +329,5 @@ void pdspADSR::onSliderEvent(ofxDatGuiSliderEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( pdspADSR, "ADSR envelope", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -38,8 +38,7 @@ pdspBitNoise::pdspBitNoise() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 2;
 
-    _inletParams[0] = new float();          // pitch
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;          // pitch
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
     _outletParams[1] = new vector<float>(); // audio buffer
@@ -139,18 +138,15 @@ void pdspBitNoise::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspBitNoise::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
 
-            for(int i=0;i<bufferSize;i++){
-                static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
-            }
-
-            XML.popTag();
+        for(int i=0;i<bufferSize;i++){
+            static_cast<vector<float> *>(_outletParams[1])->push_back(0.0f);
         }
     }
 }
@@ -214,3 +210,5 @@ void pdspBitNoise::onSliderEvent(ofxDatGuiSliderEvent e){
         pitch_ctrl.set(static_cast<float>(e.value));
     }
 }
+
+OBJECT_REGISTER( pdspBitNoise, "bit noise", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_OUT )
@@ -40,12 +40,9 @@ pdspCombFilter::pdspCombFilter() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
 
-    _inletParams[1] = new float();          // pitch
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();          // damping
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();          // feedback
-    *(float *)&_inletParams[3] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // pitch
+    *(float *)&_inletParams[2] = 0.0f;          // damping
+    *(float *)&_inletParams[3] = 0.0f;          // feedback
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -179,14 +176,12 @@ void pdspCombFilter::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspCombFilter::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -254,3 +249,5 @@ void pdspCombFilter::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( pdspCombFilter, "comb filter", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -40,16 +40,11 @@ pdspCompressor::pdspCompressor() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer(); // audio input
 
-    _inletParams[1] = new float();          // attack
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();          // release
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();          // thresh
-    *(float *)&_inletParams[3] = 0.0f;
-    _inletParams[4] = new float();          // ratio
-    *(float *)&_inletParams[4] = 0.0f;
-    _inletParams[5] = new float();          // knee
-    *(float *)&_inletParams[5] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // attack
+    *(float *)&_inletParams[2] = 0.0f;          // release
+    *(float *)&_inletParams[3] = 0.0f;          // thresh
+    *(float *)&_inletParams[4] = 0.0f;          // ratio
+    *(float *)&_inletParams[5] = 0.0f;          // knee
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -228,15 +223,12 @@ void pdspCompressor::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspCompressor::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -314,3 +306,5 @@ void pdspCompressor::onSliderEvent(ofxDatGuiSliderEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( pdspCompressor, "compressor", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
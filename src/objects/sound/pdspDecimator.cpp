@@ -39,8 +39,7 @@ pdspDecimator::pdspDecimator() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
-    _inletParams[1] = new float();          // sample rate freq
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // sample rate freq
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -150,14 +149,12 @@ void pdspDecimator::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspDecimator::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -212,3 +209,5 @@ void pdspDecimator::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"GAIN");
     freq_ctrl.set(ofMap(ofClamp(static_cast<float>(e.value),0.0f,1.0f),0.0f,1.0f,2.0f,1600.0f,true));
 }
+
+OBJECT_REGISTER( pdspDecimator, "decimator", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -42,12 +42,9 @@ pdspDelay::pdspDelay() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
 
-    _inletParams[1] = new float();          // time
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();          // damping
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();          // feedback
-    *(float *)&_inletParams[3] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // time
+    *(float *)&_inletParams[2] = 0.0f;          // damping
+    *(float *)&_inletParams[3] = 0.0f;          // feedback
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -183,14 +180,12 @@ void pdspDelay::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspDelay::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -258,3 +253,5 @@ void pdspDelay::onSliderEvent(ofxDatGuiSliderEvent e){
     }
     
 }
+
+OBJECT_REGISTER( pdspDelay, "delay", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
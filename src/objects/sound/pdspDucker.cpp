@@ -40,12 +40,9 @@ pdspDucker::pdspDucker() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer(); // audio input
 
-    _inletParams[1] = new float();          // bang
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();          // duration
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();          // ducking
-    *(float *)&_inletParams[3] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // bang
+    *(float *)&_inletParams[2] = 0.0f;          // duration
+    *(float *)&_inletParams[3] = 0.0f;          // ducking
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -248,15 +245,12 @@ void pdspDucker::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspDucker::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -355,3 +349,5 @@ void pdspDucker::onSliderEvent(ofxDatGuiSliderEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( pdspDucker, "ducker", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
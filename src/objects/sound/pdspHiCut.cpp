@@ -39,8 +39,7 @@ pdspHiCut::pdspHiCut() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
-    _inletParams[1] = new float();          // cut frequency
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // cut frequency
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -152,14 +151,12 @@ void pdspHiCut::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspHiCut::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -214,3 +211,5 @@ void pdspHiCut::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"FREQUENCY");
     freq_ctrl.set(ofClamp(static_cast<float>(e.value),20.0f,20000.0f));
 }
+
+OBJECT_REGISTER( pdspHiCut, "low pass", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -38,12 +38,9 @@ pdspLFO::pdspLFO() : PatchObject(){
     this->numInlets  = 3;
     this->numOutlets = 5;
 
-    _inletParams[0] = new float();  // retrig (bang)
-    *(float *)&_inletParams[0] = 0.0f;
-    _inletParams[1] = new float();  // frequency
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();  // phase
-    *(float *)&_inletParams[2] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // retrig (bang)
+    *(float *)&_inletParams[1] = 0.0f;  // frequency
+    *(float *)&_inletParams[2] = 0.0f;  // phase
 
     _outletParams[0] = new ofSoundBuffer(); // triangle LFO
     _outletParams[1] = new ofSoundBuffer(); // sine     LFO
@@ -191,15 +188,12 @@ void pdspLFO::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspLFO::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -267,3 +261,5 @@ void pdspLFO::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( pdspLFO, "lfo", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_OUT )
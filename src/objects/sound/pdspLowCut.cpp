@@ -39,8 +39,7 @@ pdspLowCut::pdspLowCut() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
-    _inletParams[1] = new float();          // gain
-    *(float *)&_inletParams[1] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // gain
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -151,14 +150,12 @@ void pdspLowCut::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspLowCut::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -213,3 +210,5 @@ void pdspLowCut::onSliderEvent(ofxDatGuiSliderEvent e){
     this->setCustomVar(static_cast<float>(e.value),"FREQUENCY");
     freq_ctrl.set(ofClamp(static_cast<float>(e.value),20.0f,20000.0f));
 }
+
+OBJECT_REGISTER( pdspLowCut, "hi pass", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
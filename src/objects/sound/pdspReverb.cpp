@@ -40,16 +40,11 @@ pdspReverb::pdspReverb() : PatchObject(){
 
     _inletParams[0] = new ofSoundBuffer();  // audio input
 
-    _inletParams[1] = new float();          // time
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();          // density
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();          // damping
-    *(float *)&_inletParams[3] = 0.0f;
-    _inletParams[4] = new float();          // modSpeed
-    *(float *)&_inletParams[4] = 0.0f;
-    _inletParams[5] = new float();          // mosAmount
-    *(float *)&_inletParams[5] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;          // time
+    *(float *)&_inletParams[2] = 0.0f;          // density
+    *(float *)&_inletParams[3] = 0.0f;          // damping
+    *(float *)&_inletParams[4] = 0.0f;          // modSpeed
+    *(float *)&_inletParams[5] = 0.0f;          // mosAmount
 
     _outletParams[0] = new ofSoundBuffer(); // audio output
 
@@ -214,14 +209,12 @@ void pdspReverb::removeObjectContent(){
 
 //--------------------------------------------------------------
 void pdspReverb::loadAudioSettings(){
-    ofxXmlSettings XML;
+    PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+    ofxXmlSettings &XML = settings.getXml();
 
-    if (XML.loadFile(patchFile)){
-        if (XML.pushTag("settings")){
-            sampleRate = XML.getValue("sample_rate_in",0);
-            bufferSize = XML.getValue("buffer_size",0);
-            XML.popTag();
-        }
+    if (settings.isValid()){
+        sampleRate = XML.getValue("sample_rate_in",0);
+        bufferSize = XML.getValue("buffer_size",0);
     }
 }
 
@@ -300,3 +293,5 @@ void pdspReverb::onSliderEvent(ofxDatGuiSliderEvent e){
     }
     
 }
+
+OBJECT_REGISTER( pdspReverb, "reverb", "sound", VP_OBJECT_GL|VP_OBJECT_AUDIO_IN|VP_OBJECT_AUDIO_OUT )
@@ -368,3 +368,5 @@ void KinectGrabber::onMatrixEvent(ofxDatGuiMatrixEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( KinectGrabber, "kinect grabber", "video", VP_OBJECT_GL )
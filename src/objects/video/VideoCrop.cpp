@@ -39,14 +39,10 @@ VideoCrop::VideoCrop() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofTexture();  // input
-    _inletParams[1] = new float();      // x
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();      // y
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();      // w
-    *(float *)&_inletParams[3] = 0.0f;
-    _inletParams[4] = new float();      // h
-    *(float *)&_inletParams[4] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;      // x
+    *(float *)&_inletParams[2] = 0.0f;      // y
+    *(float *)&_inletParams[3] = 0.0f;      // w
+    *(float *)&_inletParams[4] = 0.0f;      // h
 
     _outletParams[0] = new ofTexture(); // output
 
@@ -316,3 +312,5 @@ ofRectangle VideoCrop::getIntersection(ofRectangle & r1,ofRectangle & r2){
         return result;
     }
 }
+
+OBJECT_REGISTER( VideoCrop, "video crop", "video", VP_OBJECT_GL )
@@ -39,14 +39,10 @@ VideoDelay::VideoDelay() : PatchObject(){
     this->numOutlets = 1;
 
     _inletParams[0] = new ofTexture();  // input
-    _inletParams[1] = new float();      // x
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();      // y
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();      // scale
-    *(float *)&_inletParams[3] = 0.0f;
-    _inletParams[4] = new float();      // alpha
-    *(float *)&_inletParams[4] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;      // x
+    *(float *)&_inletParams[2] = 0.0f;      // y
+    *(float *)&_inletParams[3] = 0.0f;      // scale
+    *(float *)&_inletParams[4] = 0.0f;      // alpha
 
     _outletParams[0] = new ofTexture(); // output
 
@@ -287,3 +283,5 @@ void VideoDelay::onSliderEvent(ofxDatGuiSliderEvent e){
     }
 
 }
+
+OBJECT_REGISTER( VideoDelay, "video feedback", "video", VP_OBJECT_GL )
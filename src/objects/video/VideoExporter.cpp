@@ -288,3 +288,5 @@ void VideoExporter::onDropdownEvent(ofxDatGuiDropdownEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VideoExporter, "video exporter", "video", VP_OBJECT_GL )
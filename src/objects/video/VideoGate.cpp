@@ -38,8 +38,7 @@ VideoGate::VideoGate() : PatchObject(){
     this->numInlets  = 6;
     this->numOutlets = 1;
 
-    _inletParams[0] = new float();  // open
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // open
 
     _inletParams[1] = new ofTexture();  // float1
     _inletParams[2] = new ofTexture();  // float2
@@ -130,3 +129,5 @@ void VideoGate::drawObjectContent(ofxFontStash *font){
 void VideoGate::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( VideoGate, "video gate", "video", VP_OBJECT_GL )
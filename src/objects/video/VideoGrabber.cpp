@@ -369,3 +369,5 @@ void VideoGrabber::onMatrixEvent(ofxDatGuiMatrixEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VideoGrabber, "video grabber", "video", VP_OBJECT_GL )
@@ -40,12 +40,9 @@ VideoPlayer::VideoPlayer() : PatchObject(){
 
     _inletParams[0] = new string();  // control
     *static_cast<string *>(_inletParams[0]) = "";
-    _inletParams[1] = new float();  // playhead
-    *(float *)&_inletParams[1] = 0.0f;
-    _inletParams[2] = new float();  // speed
-    *(float *)&_inletParams[2] = 0.0f;
-    _inletParams[3] = new float();  // volume
-    *(float *)&_inletParams[3] = 0.0f;
+    *(float *)&_inletParams[1] = 0.0f;  // playhead
+    *(float *)&_inletParams[2] = 0.0f;  // speed
+    *(float *)&_inletParams[3] = 0.0f;  // volume
 
     _outletParams[0] = new ofTexture(); // output
 
@@ -411,3 +408,5 @@ void VideoPlayer::onButtonEvent(ofxDatGuiButtonEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VideoPlayer, "video player", "video", VP_OBJECT_GL )
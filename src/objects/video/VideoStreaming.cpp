@@ -226,3 +226,5 @@ void VideoStreaming::onToggleEvent(ofxDatGuiToggleEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VideoStreaming, "video streaming", "video", VP_OBJECT_GL )
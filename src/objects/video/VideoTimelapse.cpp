@@ -40,8 +40,7 @@ VideoTimelapse::VideoTimelapse() : PatchObject(){
 
     _inletParams[0] = new ofTexture();  // input
 
-    _inletParams[1] = new float();  // delay frames
-    *(float *)&_inletParams[1] = 25.0f;
+    *(float *)&_inletParams[1] = 25.0f;  // delay frames
 
     _outletParams[0] = new ofTexture(); // output
 
@@ -55,8 +54,8 @@ VideoTimelapse::VideoTimelapse() : PatchObject(){
     capturedFrame   = 0;
     delayFrame      = 0;
 
-    resetTime       = ofGetElapsedTimeMillis();
-    wait            = 1000/static_cast<int>(ofGetFrameRate());
+    resetTime       = PatchClock::getInstance().getElapsedTimeMillis();
+    wait            = static_cast<size_t>(PatchClock::getInstance().getFrameMillis());
 
 }
 
@@ -104,8 +103,8 @@ void VideoTimelapse::updateObjectContent(map<int,PatchObject*> &patchObjects, of
     guiDelayMS->update();
     
     if(this->inletsConnected[0]){
-        if(ofGetElapsedTimeMillis()-resetTime > wait){
-            resetTime       = ofGetElapsedTimeMillis();
+        if(PatchClock::getInstance().getElapsedTimeMillis()-resetTime > wait){
+            resetTime       = PatchClock::getInstance().getElapsedTimeMillis();
 
             ofImage rgbaImage;
             rgbaImage.allocate(static_cast<ofTexture *>(_inletParams[0])->getWidth(), static_cast<ofTexture *>(_inletParams[0])->getHeight(),OF_IMAGE_COLOR_ALPHA);
@@ -140,8 +139,8 @@ void VideoTimelapse::updateObjectContent(map<int,PatchObject*> &patchObjects, of
             capturedFrame   = 0;
             delayFrame      = 0;
 
-            resetTime       = ofGetElapsedTimeMillis();
-            wait            = 1000/static_cast<int>(ofGetFrameRate());
+            resetTime       = PatchClock::getInstance().getElapsedTimeMillis();
+            wait            = static_cast<size_t>(PatchClock::getInstance().getFrameMillis());
 
             videoBuffer->setup(nDelayFrames);
         }
@@ -228,8 +227,8 @@ void VideoTimelapse::onTextInputEvent(ofxDatGuiTextInputEvent e){
                 capturedFrame   = 0;
                 delayFrame      = 0;
 
-                resetTime       = ofGetElapsedTimeMillis();
-                wait            = 1000/static_cast<int>(ofGetFrameRate());
+                resetTime       = PatchClock::getInstance().getElapsedTimeMillis();
+                wait            = static_cast<size_t>(PatchClock::getInstance().getFrameMillis());
 
                 videoBuffer->setup(nDelayFrames);
             }else{
@@ -239,3 +238,5 @@ void VideoTimelapse::onTextInputEvent(ofxDatGuiTextInputEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( VideoTimelapse, "video timedelay", "video", VP_OBJECT_GL )
@@ -38,8 +38,7 @@ moHttpForm::moHttpForm() : PatchObject(){
     this->numInlets  = 1;
     this->numOutlets = 0;
 
-    _inletParams[0] = new float();  // bang
-    *(float *)&_inletParams[0] = 0.0f;
+    *(float *)&_inletParams[0] = 0.0f;  // bang
 
     this->initInletsState();
 
@@ -221,7 +220,7 @@ void moHttpForm::dragGUIObject(ofVec3f _m){
 //--------------------------------------------------------------
 void moHttpForm::initInlets(){
     ofxXmlSettings XML;
-    if(XML.loadFile(this->patchFile)){
+    if(PatchDocument::getInstance().load(this->patchFile,XML)){
         int totalObjects = XML.getNumTags("object");
 
         // Get object inlets config
@@ -364,3 +363,5 @@ void moHttpForm::onTextInputEvent(ofxDatGuiTextInputEvent e){
 void moHttpForm::newResponse(HttpFormResponse &response){
     ofLog(OF_LOG_NOTICE,"form '%s' returned : %s\n", response.url.c_str(), response.ok ? "OK" : "KO" );
 }
+
+OBJECT_REGISTER( moHttpForm, "http form", "web", VP_OBJECT_GL )
@@ -89,3 +89,5 @@ void LivePatching::drawObjectContent(ofxFontStash *font){
 void LivePatching::removeObjectContent(){
     
 }
+
+OBJECT_REGISTER( LivePatching, "live patching", "windowing", VP_OBJECT_GL )
@@ -793,3 +793,5 @@ void OutputWindow::onSliderEvent(ofxDatGuiSliderEvent e){
 
     }
 }
+
+OBJECT_REGISTER( OutputWindow, "output window", "windowing", VP_OBJECT_GL )
@@ -425,3 +425,5 @@ void ProjectionMapping::onButtonEvent(ofxDatGuiButtonEvent e){
         }
     }
 }
+
+OBJECT_REGISTER( ProjectionMapping, "projection mapping", "windowing", VP_OBJECT_GL )
@@ -34,55 +34,8 @@
 
 //--------------------------------------------------------------
 void ofxVisualProgramming::initObjectMatrix(){
-    vector<string> vecInit = {};
-
-    vecInit = {"audio analyzer","beat extractor","bpm extractor","centroid extractor","dissonance extractor","fft extractor","hfc extractor","hpcp extractor","inharmonicity extractor","mel bands extractor","mfcc extractor","onset extractor","pitch extractor","power extractor","rms extractor","rolloff extractor","tristimulus extractor"};
-    objectsMatrix["audio_analysis"] = vecInit;
-
-    vecInit = {"arduino serial","key pressed","key released","midi key","midi knob","midi pad","midi receiver","midi score","midi sender","osc receiver","osc sender"};
-    objectsMatrix["communications"] = vecInit;
-
-#if defined(TARGET_LINUX) || defined(TARGET_OSX)
-    vecInit = {"background subtraction","chroma key","color tracking","contour tracking","face tracker","haar tracking","motion detection","optical flow"};
-#elif defined(TARGET_WIN32)
-    vecInit = {"background subtraction","chroma key","color tracking","contour tracking","haar tracking","motion detection","optical flow"};
-#endif
-    objectsMatrix["computer vision"] = vecInit;
-
-    vecInit = {"bang multiplexer","bang to float","data to texture","floats to vector","texture to data","vector at","vector concat","vector gate","vector multiply"};
-    objectsMatrix["data"] = vecInit;
-
-    vecInit = {"image exporter","image loader"};
-    objectsMatrix["graphics"] = vecInit;
-
-    vecInit = {"2d pad","bang","comment","message","player controls","signal viewer","slider","sonogram","timeline","trigger","video viewer","vu meter"};
-    objectsMatrix["gui"] = vecInit;
-
-    vecInit = {"&&","||","==","!=",">","<","counter","delay bang","delay float","gate","inverter","loadbang","select","spigot","timed semaphore"};
-    objectsMatrix["logic"] = vecInit;
-
-    vecInit = {"add","clamp","constant","divide","metronome","modulus","multiply","range","simple noise","simple random","smooth","subtract"};
-    objectsMatrix["math"] = vecInit;
-
-#if defined(TARGET_LINUX) || defined(TARGET_OSX)
-    vecInit = {"bash script","lua script","processing script","python script","shader object"};
-#elif defined(TARGET_WIN32)
-    vecInit = {"lua script","processing script","python script","shader object"};
-#endif
-    objectsMatrix["scripting"] = vecInit;
-
-    vecInit = {"ADSR envelope","AHR envelope","amp","audio exporter","audio gate","bit noise","chorus","comb filter","compressor","crossfader","data oscillator","decimator","delay","ducker","hi pass","lfo","low pass","mixer","note to frequency","panner","pd patch","quad panner","pulse","reverb","saw","signal trigger","sine","soundfile player","triangle","white noise"};
-    objectsMatrix["sound"] = vecInit;
-
-    vecInit = {"kinect grabber","video crop","video feedback","video exporter","video gate","video grabber","video player","video scale","video streaming","video timedelay"};
-    objectsMatrix["video"] = vecInit;
-
-    vecInit = {"http form"};
-    objectsMatrix["web"] = vecInit;
-
-    vecInit = {"live patching","output window","projection mapping"};
-    objectsMatrix["windowing"] = vecInit;
-
+    // objects menu, from the objects self registered in ObjectFactory
+    objectsMatrix = ObjectFactory::getInstance().getCategories();
 }
 
 //--------------------------------------------------------------
@@ -90,27 +43,31 @@ ofxVisualProgramming::ofxVisualProgramming(){
 
     mainWindow = dynamic_pointer_cast<ofAppGLFWWindow>(ofGetCurrentWindow());
 
+    // without a GLFW window (ofAppNoWindow) there is no GL context, run headless
+    hasGLContext            = mainWindow != nullptr;
+    headless                = !hasGLContext;
+    headlessAudioTime       = 0;
+
     // Profiler
     profilerActive          = false;
     TIME_SAMPLE_SET_DRAW_LOCATION(TIME_MEASUREMENTS_BOTTOM_RIGHT);
     TIME_SAMPLE_SET_AVERAGE_RATE(0.3);
     TIME_SAMPLE_SET_REMOVE_EXPIRED_THREADS(true);
-    TIME_SAMPLE_GET_INSTANCE()->drawUiWithFontStash(MAIN_FONT);
+    if(hasGLContext){
+        TIME_SAMPLE_GET_INSTANCE()->drawUiWithFontStash(MAIN_FONT);
+    }
     TIME_SAMPLE_GET_INSTANCE()->setAutoDraw(false);
     TIME_SAMPLE_GET_INSTANCE()->setSavesSettingsOnExit(false);
     TIME_SAMPLE_SET_ENABLED(profilerActive);
 
-    //  Event listeners
-    ofAddListener(ofEvents().mouseMoved, this, &ofxVisualProgramming::mouseMoved);
-    ofAddListener(ofEvents().mouseDragged, this, &ofxVisualProgramming::mouseDragged);
-    ofAddListener(ofEvents().mousePressed, this, &ofxVisualProgramming::mousePressed);
-    ofAddListener(ofEvents().mouseReleased, this, &ofxVisualProgramming::mouseReleased);
-    ofAddListener(ofEvents().mouseScrolled, this, &ofxVisualProgramming::mouseScrolled);
-    ofAddListener(ofEvents().keyPressed, this, &ofxVisualProgramming::keyPressed);
-
     // System
-    glVersion           = "OpenGL "+ofToString(glGetString(GL_VERSION));
-    glShadingVersion    = "Shading Language "+ofToString(glGetString(GL_SHADING_LANGUAGE_VERSION));
+    if(hasGLContext){
+        glVersion           = "OpenGL "+ofToString(glGetString(GL_VERSION));
+        glShadingVersion    = "Shading Language "+ofToString(glGetString(GL_SHADING_LANGUAGE_VERSION));
+    }else{
+        glVersion           = "OpenGL none";
+        glShadingVersion    = "Shading Language none";
+    }
 
     engine                  = new pdsp::Engine();
 
@@ -131,6 +88,12 @@ ofxVisualProgramming::ofxVisualProgramming(){
     draggingObject          = false;
     bLoadingNewObject       = false;
     bLoadingNewPatch        = false;
+    bGraphChanged           = false;
+    parallelUpdate          = true;
+
+    eventsTime              = 0;
+    eventsLastCount         = 0;
+    eventsPerSecond         = 0.0f;
 
     livePatchingObiID       = -1;
 
@@ -159,33 +122,55 @@ ofxVisualProgramming::~ofxVisualProgramming(){
 void ofxVisualProgramming::setup(){
 
     // Load resources
-    font->setup(MAIN_FONT,1.0,2048,true,8,3.0f);
-
-    // Check retina screens
-    if(ofGetScreenWidth() >= RETINA_MIN_WIDTH && ofGetScreenHeight() >= RETINA_MIN_HEIGHT){
-        isRetina = true;
-        scaleFactor = 2;
-        fontSize    = 26;
-        linkActivateDistance *= scaleFactor;
-        TIME_SAMPLE_GET_INSTANCE()->setUiScale(scaleFactor);
+    if(hasGLContext){
+        font->setup(MAIN_FONT,1.0,2048,true,8,3.0f);
     }
 
-    // Set pan-zoom canvas
-    canvas.disableMouseInput();
-    canvas.setbMouseInputEnabled(true);
-    canvas.toggleOfCam();
-    easyCam.enableOrtho();
+    if(!headless){
+        // Check retina screens
+        if(ofGetScreenWidth() >= RETINA_MIN_WIDTH && ofGetScreenHeight() >= RETINA_MIN_HEIGHT){
+            isRetina = true;
+            scaleFactor = 2;
+            fontSize    = 26;
+            linkActivateDistance *= scaleFactor;
+            TIME_SAMPLE_GET_INSTANCE()->setUiScale(scaleFactor);
+        }
+
+        //  Event listeners
+        ofAddListener(ofEvents().mouseMoved, this, &ofxVisualProgramming::mouseMoved);
+        ofAddListener(ofEvents().mouseDragged, this, &ofxVisualProgramming::mouseDragged);
+        ofAddListener(ofEvents().mousePressed, this, &ofxVisualProgramming::mousePressed);
+        ofAddListener(ofEvents().mouseReleased, this, &ofxVisualProgramming::mouseReleased);
+        ofAddListener(ofEvents().mouseScrolled, this, &ofxVisualProgramming::mouseScrolled);
+        ofAddListener(ofEvents().keyPressed, this, &ofxVisualProgramming::keyPressed);
+
+        // Set pan-zoom canvas
+        canvas.disableMouseInput();
+        canvas.setbMouseInputEnabled(true);
+        canvas.toggleOfCam();
+        easyCam.enableOrtho();
+    }else{
+        ofLog(OF_LOG_NOTICE,"[verbose] running headless, %s",hasGLContext ? "GL objects render offscreen" : "no GL context, GL and GUI objects are skipped");
+    }
 
     // RESET TEMP FOLDER
     resetTempFolder();
 
     // Threaded File Dialogs
-    fileDialog.setup();
-    ofAddListener(fileDialog.fileDialogEvent, this, &ofxVisualProgramming::onFileDialogResponse);
+    if(!headless){
+        fileDialog.setup();
+        ofAddListener(fileDialog.fileDialogEvent, this, &ofxVisualProgramming::onFileDialogResponse);
+    }
 
     // INIT OBJECTS
     initObjectMatrix();
 
+    // Parallel update workers
+    updatePool.setup();
+
+    // Control rate timers (metronome, delays)
+    ControlThread::getInstance().setup();
+
     // Create new empty file patch
     newPatch();
 
@@ -194,8 +179,15 @@ void ofxVisualProgramming::setup(){
 //--------------------------------------------------------------
 void ofxVisualProgramming::update(){
 
+    // advance the patch time (virtual time in fixed step mode)
+    PatchClock::getInstance().tick();
+    if(PatchClock::getInstance().isFixedStep()){
+        // deterministic control timers, fired from the render thread
+        ControlThread::getInstance().advanceTo(PatchClock::getInstance().getElapsedTimeMillis());
+    }
+
     // canvas init
-    if(!inited){
+    if(!inited && !headless){
         inited = true;
         canvasViewport.set(0,20,ofGetWindowWidth(),ofGetWindowHeight());
 
@@ -205,23 +197,82 @@ void ofxVisualProgramming::update(){
         }
     }
 
-    // Sound Context
-    unique_lock<std::mutex> lock(inputAudioMutex);
-    {
+    // Graphical Context
+    if(!headless){
+        canvas.update();
+    }
+
+    // Objects resources loaded in background
+    AssetLoader::getInstance().update();
+
+    // Texture readbacks nobody asked for lately
+    TextureReadback::getInstance().update();
+
+    // Audio graph snapshots replaced since the last frame
+    audioGraph.reclaim();
 
+    // Recompile the execution schedule only if the patch graph changed
+    if(bGraphChanged){
+        compilePatchGraph();
     }
 
-    // Graphical Context
-    canvas.update();
+    // cache objects layout, links recompute their positions only when one of their ends moved
+    for(size_t i=0;i<executionOrder.size();i++){
+        executionOrder.at(i)->checkLayout();
+    }
 
-    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-        TS_START(it->second->getName()+ofToString(it->second->getId())+"_update");
-        it->second->update(patchObjects,fileDialog);
-        TS_STOP(it->second->getName()+ofToString(it->second->getId())+"_update");
+    // Update objects in topological order, so data crosses the whole chain in the same frame.
+    // Objects of the same graph level don't depend on each other, so the ones touching neither GL
+    // nor ofxDatGui (its focus and events are shared static state) run in parallel,
+    // while all the others stay on the main thread, and hand their heavy compute step to the pool:
+    // it runs next to the rest of the update pass, all of them are done before the draw.
+    if(parallelUpdate && updatePool.isRunning()){
+        for(size_t l=0;l+1<scheduleLevels.size();l++){
+            size_t begin = scheduleLevels[l];
+            size_t end   = scheduleLevels[l+1];
+            ThreadPool::Job job;
+            if(end-begin > 1){
+                for(size_t s=begin;s<end;s++){
+                    if(!(scheduleFlags[s] & SCHEDULE_MAIN_THREAD)){
+                        updatePool.submit(job,[this,s](){ updatePatchObject(s); });
+                    }
+                }
+            }
+            updatePool.wait(job);
+            for(size_t s=begin;s<end;s++){
+                if((scheduleFlags[s] & SCHEDULE_MAIN_THREAD) || end-begin == 1){
+                    updatePatchObject(s);
+                }
+            }
+        }
+        updatePool.wait(computeJob);
+    }else{
+        for(size_t s=0;s<executionOrder.size();s++){
+            updatePatchObject(s);
+        }
+    }
 
-        if(draggingObject && draggingObjectID == it->first){
-            it->second->mouseDragged(actualMouse.x,actualMouse.y);
+    // Headless audio graph
+    if(headless){
+        processHeadlessAudio();
+    }
+
+    // Profiler histograms window
+    PatchProfiler::getInstance().update();
+
+    // Events throughput
+    uint64_t eventsNow = PatchClock::getInstance().getElapsedTimeMillis();
+    if(eventsNow < eventsTime || eventsNow-eventsTime >= 1000){
+        uint64_t numEvents = PatchObject::getNumEventsSent();
+        if(eventsNow > eventsTime){
+            eventsPerSecond = static_cast<float>(numEvents-eventsLastCount)*1000.0f/static_cast<float>(eventsNow-eventsTime);
         }
+        eventsLastCount = numEvents;
+        eventsTime      = eventsNow;
+    }
+
+    if(draggingObject && patchObjects.find(draggingObjectID) != patchObjects.end() && patchObjects.at(draggingObjectID) != nullptr){
+        patchObjects.at(draggingObjectID)->mouseDragged(actualMouse.x,actualMouse.y);
     }
     // Clear map from deleted objects
     if(ofGetElapsedTimeMillis()-resetTime > wait){
@@ -233,16 +284,62 @@ void ofxVisualProgramming::update(){
 
             }
         }
+        if(!eraseIndexes.empty()){
+            // the sound stream must be out of the erased objects before their content goes away
+            publishAudioGraph();
+            audioGraph.synchronize();
+        }
         for(int x=0;x<static_cast<int>(eraseIndexes.size());x++){
             for(int p=0;p<static_cast<int>(patchObjects.at(eraseIndexes.at(x))->outPut.size());p++){
-                patchObjects[patchObjects.at(eraseIndexes.at(x))->outPut.at(p)->toObjectID]->inletsConnected.at(patchObjects.at(eraseIndexes.at(x))->outPut.at(p)->toInletID) = false;
+                patchObjects[patchObjects.at(eraseIndexes.at(x))->outPut.at(p)->toObjectID]->unlinkInlet(patchObjects.at(eraseIndexes.at(x))->outPut.at(p)->toInletID);
             }
             patchObjects.at(eraseIndexes.at(x))->removeObjectContent();
+            PatchProfiler::getInstance().removeObject(eraseIndexes.at(x));
             patchObjects.erase(eraseIndexes.at(x));
         }
+        if(!eraseIndexes.empty()){
+            compilePatchGraph();
+        }
+
+    }
+
+}
+
+//--------------------------------------------------------------
+void ofxVisualProgramming::updatePatchObject(size_t slot){
+    // new data on the inlets if any upstream slot changed its outlets: the ones already run
+    // this frame, or the last frame for the feedback links scheduled after us
+    // (time driven objects run anyway, no need to look)
+    bool inletsChanged = false;
+    for(size_t u=scheduleUpstreamBegin[slot];u<scheduleUpstreamBegin[slot+1] && !(scheduleFlags[slot] & SCHEDULE_TIME_DRIVEN);u++){
+        if(scheduleChanged[scheduleUpstream[u]]){
+            inletsChanged = true;
+            break;
+        }
+    }
 
+    PatchObject *obj = executionOrder[slot];
+    PatchProfiler::Scope profile(obj->getProfilerEntry(),VP_PROFILE_UPDATE);
+    TS_START(obj->getProfilerKey(VP_PROFILE_UPDATE));
+    scheduleChanged[slot] = obj->update(patchObjects,fileDialog,inletsChanged) ? 1 : 0;
+    TS_STOP(obj->getProfilerKey(VP_PROFILE_UPDATE));
+
+    if(obj->takeComputeRequest()){
+        if(parallelUpdate && updatePool.isRunning()){
+            updatePool.submit(computeJob,[obj](){ obj->computeObjectContent(); });
+        }else{
+            obj->computeObjectContent();
+        }
     }
+}
 
+//--------------------------------------------------------------
+bool ofxVisualProgramming::saveProfilerReport(string path){
+    // per object update/draw/audio timings, .json or .csv
+    if(ofToLower(ofFilePath::getFileExt(path)) == "json"){
+        return PatchProfiler::getInstance().exportJSON(path);
+    }
+    return PatchProfiler::getInstance().exportCSV(path);
 }
 
 //--------------------------------------------------------------
@@ -253,6 +350,10 @@ void ofxVisualProgramming::updateCanvasViewport(){
 //--------------------------------------------------------------
 void ofxVisualProgramming::draw(){
 
+    if(headless){
+        return;
+    }
+
     TSGL_START("draw");
 
     ofPushView();
@@ -269,13 +370,15 @@ void ofxVisualProgramming::draw(){
 
     livePatchingObiID = -1;
 
-    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-        TS_START(it->second->getName()+ofToString(it->second->getId())+"_draw");
-        if(it->second->getName() == "live patching"){
-           livePatchingObiID = it->second->getId();
+    for(size_t i=0;i<objectsList.size();i++){
+        PatchObject *obj = objectsList.at(i);
+        PatchProfiler::Scope profile(obj->getProfilerEntry(),VP_PROFILE_DRAW);
+        TS_START(obj->getProfilerKey(VP_PROFILE_DRAW));
+        if(obj->getName() == "live patching"){
+           livePatchingObiID = obj->getId();
         }
-        it->second->draw(font);
-        TS_STOP(it->second->getName()+ofToString(it->second->getId())+"_draw");
+        obj->draw(font);
+        TS_STOP(obj->getProfilerKey(VP_PROFILE_DRAW));
     }
 
     // draw outlet cables with var name
@@ -294,6 +397,8 @@ void ofxVisualProgramming::draw(){
             break;
         case 5: ofSetColor(COLOR_SCRIPT_LINK); ofSetLineWidth(1);
             break;
+        case 6: ofSetColor(COLOR_AUDIOFEATURES_LINK);
+            break;
         default: break;
         }
         ofDrawLine(patchObjects[selectedObjectID]->getOutletPosition(selectedObjectLink).x, patchObjects[selectedObjectID]->getOutletPosition(selectedObjectLink).y, canvas.getMovingPoint().x,canvas.getMovingPoint().y);
@@ -312,6 +417,8 @@ void ofxVisualProgramming::draw(){
             break;
         case 5: patchObjects[selectedObjectID]->linkTypeName = patchObjects[selectedObjectID]->specialLinkTypeName;
             break;
+        case 6: patchObjects[selectedObjectID]->linkTypeName = "AudioFeatureFrame";
+            break;
         default: patchObjects[selectedObjectID]->linkTypeName = "";
             break;
         }
@@ -334,6 +441,12 @@ void ofxVisualProgramming::draw(){
     ofSetColor(200);
     font->draw(glError.getError(),fontSize,glVersion.length()*fontSize*0.5f + 10*scaleFactor,ofGetHeight() - (6*scaleFactor));
 
+    // Assets loading progress
+    if(AssetLoader::getInstance().isLoading()){
+        ofSetColor(ofColor::fromHex(0xFFD00B));
+        ofDrawRectangle(0,ofGetHeight() - (20*scaleFactor),ofGetWidth()*AssetLoader::getInstance().getProgress(),(2*scaleFactor));
+    }
+
     // DSP flag
     if(dspON){
         ofSetColor(ofColor::fromHex(0xFFD00B));
@@ -343,6 +456,10 @@ void ofxVisualProgramming::draw(){
         font->draw("DSP OFF",fontSize,glVersion.length()*fontSize*0.5f + glError.getError().length()*fontSize*0.5f + 30*scaleFactor,ofGetHeight() - (6*scaleFactor));
     }
 
+    // Events throughput
+    ofSetColor(ofColor::fromHex(0x777777));
+    font->draw(ofToString(static_cast<int>(eventsPerSecond))+" events/s",fontSize,glVersion.length()*fontSize*0.5f + glError.getError().length()*fontSize*0.5f + 30*scaleFactor + 8*fontSize*0.5f + 10*scaleFactor,ofGetHeight() - (6*scaleFactor));
+
 
     ofDisableAlphaBlending();
 
@@ -400,7 +517,15 @@ void ofxVisualProgramming::exit(){
         it->second->removeObjectContent();
     }
 
-    fileDialog.stop();
+    if(!headless){
+        fileDialog.stop();
+    }
+    AssetLoader::getInstance().stop();
+    ControlThread::getInstance().stop();
+    TextureReadback::getInstance().clear();
+    PatchDocument::getInstance().close();
+
+    updatePool.stop();
 
     if(dspON){
         deactivateDSP();
@@ -415,11 +540,11 @@ void ofxVisualProgramming::mouseMoved(ofMouseEventArgs &e){
     actualMouse = ofVec2f(canvas.getMovingPoint().x,canvas.getMovingPoint().y);
 
     // CANVAS
-    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-        it->second->mouseMoved(actualMouse.x,actualMouse.y);
-        it->second->setIsActive(false);
-        if (it->second->isOver(actualMouse)){
-            activeObject(it->first);
+    for(size_t i=0;i<objectsList.size();i++){
+        objectsList.at(i)->mouseMoved(actualMouse.x,actualMouse.y);
+        objectsList.at(i)->setIsActive(false);
+        if (objectsList.at(i)->isOver(actualMouse)){
+            activeObject(objectsList.at(i)->getId());
         }
     }
 
@@ -558,7 +683,7 @@ void ofxVisualProgramming::mouseReleased(ofMouseEventArgs &e){
         }
     }
 
-    if(!isLinked && selectedObjectLinkType != -1 && selectedObjectLink != -1 && selectedObjectID != -1 && !patchObjects.empty() && patchObjects[selectedObjectID] != nullptr && patchObjects[selectedObjectID]->outPut.size()>0 && isOutletSelected){
+    if(!isLinked && selectedObjectLinkType != -1 && selectedObjectLink != -1 && selectedObjectID != -1 && !patchObjects.empty() && getObject(selectedObjectID) != nullptr && patchObjects[selectedObjectID]->outPut.size()>0 && isOutletSelected){
         vector<bool> tempEraseLinks;
         for(int j=0;j<static_cast<int>(patchObjects[selectedObjectID]->outPut.size());j++){
             //ofLog(OF_LOG_NOTICE,"Object %i have link to %i",selectedObjectID,patchObjects[selectedObjectID]->outPut[j]->toObjectID);
@@ -578,7 +703,7 @@ void ofxVisualProgramming::mouseReleased(ofMouseEventArgs &e){
             }else{
                 patchObjects[selectedObjectID]->removeLinkFromConfig(selectedObjectLink);
                 if(patchObjects[patchObjects[selectedObjectID]->outPut[i]->toObjectID] != nullptr){
-                    patchObjects[patchObjects[selectedObjectID]->outPut[i]->toObjectID]->inletsConnected[patchObjects[selectedObjectID]->outPut[i]->toInletID] = false;
+                    patchObjects[patchObjects[selectedObjectID]->outPut[i]->toObjectID]->unlinkInlet(patchObjects[selectedObjectID]->outPut[i]->toInletID);
                     if(patchObjects[selectedObjectID]->getIsPDSPPatchableObject() || patchObjects[selectedObjectID]->getName() == "audio device"){
                         patchObjects[selectedObjectID]->pdspOut[i].disconnectOut();
                     }
@@ -591,8 +716,9 @@ void ofxVisualProgramming::mouseReleased(ofMouseEventArgs &e){
         }
 
         patchObjects[selectedObjectID]->outPut = tempBuffer;
+        bGraphChanged = true;
 
-    }else if(!isLinked && selectedObjectLinkType != -1 && selectedObjectLink != -1 && selectedObjectID != -1 && !patchObjects.empty() && patchObjects[selectedObjectID] != nullptr && !isOutletSelected){
+    }else if(!isLinked && selectedObjectLinkType != -1 && selectedObjectLink != -1 && selectedObjectID != -1 && !patchObjects.empty() && getObject(selectedObjectID) != nullptr && !isOutletSelected){
         // Disconnect selected --> inlet link
 
         for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
@@ -616,8 +742,8 @@ void ofxVisualProgramming::mouseReleased(ofMouseEventArgs &e){
                             tempBuffer.push_back(it->second->outPut[s]);
                         }else{
                             it->second->removeLinkFromConfig(it->second->outPut[s]->fromOutletID);
-                            if(patchObjects[selectedObjectID] != nullptr){
-                                patchObjects[selectedObjectID]->inletsConnected[selectedObjectLink] = false;
+                            if(getObject(selectedObjectID) != nullptr){
+                                patchObjects[selectedObjectID]->unlinkInlet(selectedObjectLink);
                                 if(patchObjects[selectedObjectID]->getIsPDSPPatchableObject()){
                                     patchObjects[selectedObjectID]->pdspIn[selectedObjectLink].disconnectIn();
                                 }
@@ -626,6 +752,7 @@ void ofxVisualProgramming::mouseReleased(ofMouseEventArgs &e){
                     }
 
                     it->second->outPut = tempBuffer;
+                    bGraphChanged = true;
 
                     break;
                 }
@@ -654,8 +781,8 @@ void ofxVisualProgramming::mouseScrolled(ofMouseEventArgs &e){
 
 //--------------------------------------------------------------
 void ofxVisualProgramming::keyPressed(ofKeyEventArgs &e){
-    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-        it->second->keyPressed(e.key);
+    for(size_t i=0;i<objectsList.size();i++){
+        objectsList.at(i)->keyPressed(e.key);
     }
 }
 
@@ -663,6 +790,7 @@ void ofxVisualProgramming::keyPressed(ofKeyEventArgs &e){
 void ofxVisualProgramming::onFileDialogResponse(ofxThreadedFileDialogResponse &response){
     for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
         it->second->fileDialogResponse(response);
+        it->second->markDirty();
     }
 }
 
@@ -673,31 +801,21 @@ void ofxVisualProgramming::audioProcess(float *input, int bufferSize, int nChann
 
         TS_START("ofxVP audioProcess");
 
-        if(!bLoadingNewObject){
-            if(audioDevices[audioINDev].inputChannels > 0){
-                inputBuffer.copyFrom(input, bufferSize, nChannels, audioSampleRate);
-
-                // compute audio input
-                if(!bLoadingNewPatch){
-                    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                        it->second->audioIn(inputBuffer);
-                    }
-                }
-
+        // lock free: the graph snapshot stays valid until release, edits publish a new one
+        const AudioGraphSnapshot *graph = audioGraph.acquire();
 
-                unique_lock<std::mutex> lock(inputAudioMutex);
-                lastInputBuffer = inputBuffer;
-            }
-            if(audioDevices[audioOUTDev].outputChannels > 0){
-                // compute audio output
-                if(!bLoadingNewPatch){
-                    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-                        it->second->audioOut(emptyBuffer);
-                    }
-                }
-            }
+        if(audioDevices[audioINDev].inputChannels > 0){
+            inputBuffer.copyFrom(input, bufferSize, nChannels, audioSampleRate);
 
+            // compute audio input
+            processAudioNodesIn(graph,inputBuffer);
         }
+        if(audioDevices[audioOUTDev].outputChannels > 0){
+            // compute audio output
+            processAudioNodesOut(graph,emptyBuffer);
+        }
+
+        audioGraph.release();
 
         TS_STOP("ofxVP audioProcess");
 
@@ -705,17 +823,74 @@ void ofxVisualProgramming::audioProcess(float *input, int bufferSize, int nChann
 
 }
 
+//--------------------------------------------------------------
+void ofxVisualProgramming::processAudioBlock(float *input, int bufferSize, int nChannels){
+
+    // headless runs have no sound stream, the audio objects are driven from here
+    if(!headless || audioSampleRate == 0 || bLoadingNewObject || bLoadingNewPatch){
+        return;
+    }
+
+    TS_START("ofxVP audioProcess");
+
+    inputBuffer.copyFrom(input, bufferSize, nChannels, audioSampleRate);
+
+    const AudioGraphSnapshot *graph = audioGraph.acquire();
+    processAudioNodesIn(graph,inputBuffer);
+    processAudioNodesOut(graph,emptyBuffer);
+    audioGraph.release();
+
+    TS_STOP("ofxVP audioProcess");
+
+}
+
+//--------------------------------------------------------------
+void ofxVisualProgramming::processAudioNodesIn(const AudioGraphSnapshot *graph, ofSoundBuffer &buffer){
+    for(size_t i=0;i<graph->inNodes.size();i++){
+        PatchProfiler::Scope profile(graph->inNodes[i]->getProfilerEntry(),VP_PROFILE_AUDIO);
+        graph->inNodes[i]->audioIn(buffer);
+    }
+}
+
+//--------------------------------------------------------------
+void ofxVisualProgramming::processAudioNodesOut(const AudioGraphSnapshot *graph, ofSoundBuffer &buffer){
+    for(size_t i=0;i<graph->outNodes.size();i++){
+        PatchProfiler::Scope profile(graph->outNodes[i]->getProfilerEntry(),VP_PROFILE_AUDIO);
+        graph->outNodes[i]->audioOut(buffer);
+    }
+}
+
+//--------------------------------------------------------------
+void ofxVisualProgramming::processHeadlessAudio(){
+    if(audioSampleRate == 0 || audioBufferSize <= 0){
+        return;
+    }
+
+    // patch time, in fixed step mode every frame renders the same amount of audio
+    uint64_t now = PatchClock::getInstance().getElapsedTimeMicros();
+    if(headlessAudioTime == 0 || now < headlessAudioTime){
+        headlessAudioTime = now;
+        return;
+    }
+
+    // run the buffers elapsed since the last frame, with a silent input
+    uint64_t bufferTime = static_cast<uint64_t>(audioBufferSize) * 1000000 / static_cast<uint64_t>(audioSampleRate);
+    if(headlessInput.size() != static_cast<size_t>(audioBufferSize)){
+        headlessInput.assign(static_cast<size_t>(audioBufferSize),0.0f);
+    }
+    while(now - headlessAudioTime >= bufferTime){
+        headlessAudioTime += bufferTime;
+        processAudioBlock(&headlessInput[0],audioBufferSize,1);
+    }
+}
+
 //--------------------------------------------------------------
 void ofxVisualProgramming::activeObject(int oid){
-    if ((oid != -1) && (patchObjects[oid] != nullptr)){
+    if ((oid != -1) && (getObject(oid) != nullptr)){
         selectedObjectID = oid;
 
-        for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
-            if (it->first == oid){
-                it->second->setIsActive(true);
-            }else{
-                it->second->setIsActive(false);
-            }
+        for(size_t i=0;i<objectsList.size();i++){
+            objectsList.at(i)->setIsActive(objectsList.at(i)->getId() == oid);
         }
     }
 }
@@ -724,16 +899,7 @@ void ofxVisualProgramming::activeObject(int oid){
 void ofxVisualProgramming::addObject(string name,ofVec2f pos){
 
     // check if object exists
-    bool exists = false;
-    for(map<string,vector<string>>::iterator it = objectsMatrix.begin(); it != objectsMatrix.end(); it++ ){
-        for(int j=0;j<static_cast<int>(it->second.size());j++){
-            if(it->second.at(j) == name){
-                exists = true;
-                break;
-            }
-        }
-    }
-    if(!exists && name != "audio device"){
+    if(!ObjectFactory::getInstance().exists(name)){
         return;
     }
 
@@ -746,6 +912,10 @@ void ofxVisualProgramming::addObject(string name,ofVec2f pos){
     bLoadingNewObject       = true;
 
     PatchObject* tempObj = selectObject(name);
+    if(tempObj == nullptr){
+        bLoadingNewObject   = false;
+        return;
+    }
 
     tempObj->newObject();
     tempObj->setPatchfile(currentPatchFile);
@@ -768,6 +938,7 @@ void ofxVisualProgramming::addObject(string name,ofVec2f pos){
         patchObjects[tempObj->getId()] = tempObj;
         patchObjects[tempObj->getId()]->fixCollisions(patchObjects);
         lastAddedObjectID = tempObj->getId();
+        bGraphChanged = true;
     }
 
     bLoadingNewObject       = false;
@@ -791,10 +962,11 @@ void ofxVisualProgramming::dragObject(int &id){
 
 //--------------------------------------------------------------
 void ofxVisualProgramming::resetObject(int &id){
-    if ((id != -1) && (patchObjects[id] != nullptr)){
+    if ((id != -1) && (getObject(id) != nullptr)){
 
-        ofxXmlSettings XML;
-        if (XML.loadFile(currentPatchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(currentPatchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if (doc.isLoaded()){
 
             for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
                 vector<PatchLink*> tempBuffer;
@@ -809,6 +981,7 @@ void ofxVisualProgramming::resetObject(int &id){
                 }
                 it->second->outPut = tempBuffer;
             }
+            bGraphChanged = true;
 
             int totalObjects = XML.getNumTags("object");
 
@@ -843,7 +1016,7 @@ void ofxVisualProgramming::resetObject(int &id){
                 }
             }
 
-            XML.saveFile();
+            doc.setDirty();
 
         }
     }
@@ -851,7 +1024,7 @@ void ofxVisualProgramming::resetObject(int &id){
 
 //--------------------------------------------------------------
 void ofxVisualProgramming::resetObject(int id){
-    if ((id != -1) && (patchObjects[id] != nullptr)){
+    if ((id != -1) && (getObject(id) != nullptr)){
         for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
             vector<PatchLink*> tempBuffer;
             for(int j=0;j<static_cast<int>(it->second->outPut.size());j++){
@@ -859,20 +1032,22 @@ void ofxVisualProgramming::resetObject(int id){
                     tempBuffer.push_back(it->second->outPut[j]);
                 }else{
                     it->second->outPut[j]->isDisabled = true;
-                    patchObjects[it->second->outPut[j]->toObjectID]->inletsConnected[it->second->outPut[j]->toInletID] = false;
+                    patchObjects[it->second->outPut[j]->toObjectID]->unlinkInlet(it->second->outPut[j]->toInletID);
                 }
             }
             it->second->outPut = tempBuffer;
         }
+        bGraphChanged = true;
     }
 }
 
 //--------------------------------------------------------------
 void ofxVisualProgramming::reconnectObjectOutlets(int &id){
-    if ((id != -1) && (patchObjects[id] != nullptr)){
+    if ((id != -1) && (getObject(id) != nullptr)){
 
+        // work on a copy, connecting objects can save their config in the patch document
         ofxXmlSettings XML;
-        if (XML.loadFile(currentPatchFile)){
+        if (PatchDocument::getInstance().load(currentPatchFile,XML)){
             int totalObjects = XML.getNumTags("object");
 
             // relink object outlets from XML
@@ -918,12 +1093,13 @@ void ofxVisualProgramming::reconnectObjectOutlets(int &id){
 void ofxVisualProgramming::deleteObject(int id){
     resetTime = ofGetElapsedTimeMillis();
 
-    if ((id != -1) && (patchObjects[id] != nullptr)){
+    if ((id != -1) && (getObject(id) != nullptr)){
 
         int targetID = id;
         bool found = false;
-        ofxXmlSettings XML;
-        if (XML.loadFile(currentPatchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(currentPatchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if (doc.isLoaded()){
             int totalObjects = XML.getNumTags("object");
 
             for(int i=0;i<totalObjects;i++){
@@ -971,7 +1147,7 @@ void ofxVisualProgramming::deleteObject(int id){
             // remove object
             if(found){
                 XML.removeTag("object", targetID);
-                XML.saveFile();
+                doc.setDirty();
             }
         }
 
@@ -982,11 +1158,12 @@ void ofxVisualProgramming::deleteObject(int id){
                     tempBuffer.push_back(it->second->outPut[j]);
                 }else{
                     it->second->outPut[j]->isDisabled = true;
-                    patchObjects[it->second->outPut[j]->toObjectID]->inletsConnected[it->second->outPut[j]->toInletID] = false;
+                    patchObjects[it->second->outPut[j]->toObjectID]->unlinkInlet(it->second->outPut[j]->toInletID);
                 }
             }
             it->second->outPut = tempBuffer;
         }
+        bGraphChanged = true;
 
     }
 }
@@ -1001,16 +1178,172 @@ void ofxVisualProgramming::deleteSelectedObject(){
     }
 }
 
+//--------------------------------------------------------------
+void ofxVisualProgramming::compilePatchGraph(){
+    // Kahn's algorithm over the object links: every object is scheduled after all the objects
+    // feeding its inlets. Objects are taken in id order when free, so the schedule is stable.
+    map<int,int> inDegree;
+    map<int,vector<int>> adjacency;
+
+    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
+        if(it->second != nullptr){
+            inDegree[it->first] += 0;
+            // links changed, rebuild the outlets adjacency and recompute everything once
+            it->second->compileLinks(patchObjects);
+            it->second->initProfiler();
+            it->second->markDirty();
+        }
+    }
+    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
+        if(it->second == nullptr){
+            continue;
+        }
+        for(int j=0;j<static_cast<int>(it->second->outPut.size());j++){
+            PatchLink *link = it->second->outPut[j];
+            if(!link->isDisabled && inDegree.count(link->toObjectID) > 0 && link->toObjectID != it->first){
+                adjacency[it->first].push_back(link->toObjectID);
+                inDegree[link->toObjectID]++;
+            }
+        }
+    }
+
+    map<int,PatchObject*> ready;
+    for(map<int,int>::iterator it = inDegree.begin(); it != inDegree.end(); it++ ){
+        if(it->second == 0){
+            ready[it->first] = patchObjects.at(it->first);
+        }
+    }
+
+    // graph level = longest path from a source object
+    map<int,int> depth;
+
+    vector<vector<int>> levels;
+
+    while(!ready.empty()){
+        int oid = ready.begin()->first;
+        int lvl = depth[oid];
+        if(lvl >= static_cast<int>(levels.size())){
+            levels.resize(lvl+1);
+        }
+        levels.at(lvl).push_back(oid);
+        ready.erase(ready.begin());
+        inDegree.erase(oid);
+
+        vector<int> &next = adjacency[oid];
+        for(size_t n=0;n<next.size();n++){
+            if(depth[next.at(n)] < lvl+1){
+                depth[next.at(n)] = lvl+1;
+            }
+            map<int,int>::iterator dst = inDegree.find(next.at(n));
+            if(dst != inDegree.end() && --dst->second == 0){
+                ready[dst->first] = patchObjects.at(dst->first);
+            }
+        }
+    }
+
+    // Objects left with pending inlets are part of (or fed by) a feedback loop,
+    // keep them running in id order, with one frame delay on the loop links
+    if(!inDegree.empty()){
+        string cycleObjects = "";
+        for(map<int,int>::iterator it = inDegree.begin(); it != inDegree.end(); it++ ){
+            levels.push_back(vector<int>(1,it->first));
+            cycleObjects += " "+patchObjects.at(it->first)->getName()+"("+ofToString(it->first)+")";
+        }
+        ofLog(OF_LOG_WARNING,"Feedback loop detected in patch, objects involved:%s",cycleObjects.c_str());
+    }
+
+    // flatten the levels into the slot arrays, levels order is a valid topological order
+    map<int,size_t> slots;
+    executionOrder.clear();
+    scheduleLevels.clear();
+    scheduleFlags.clear();
+    for(size_t l=0;l<levels.size();l++){
+        scheduleLevels.push_back(executionOrder.size());
+        for(size_t i=0;i<levels[l].size();i++){
+            PatchObject *obj = patchObjects.at(levels[l][i]);
+            slots[levels[l][i]] = executionOrder.size();
+            executionOrder.push_back(obj);
+            scheduleFlags.push_back((obj->getIsGLObject() ? SCHEDULE_MAIN_THREAD : 0) | (obj->getIsTimeDrivenObject() ? SCHEDULE_TIME_DRIVEN : 0));
+        }
+    }
+    scheduleLevels.push_back(executionOrder.size());
+
+    // upstream slots of every slot, from the enabled links (feedback ones included)
+    vector<vector<size_t>> upstream(executionOrder.size());
+    for(size_t s=0;s<executionOrder.size();s++){
+        PatchObject *obj = executionOrder[s];
+        for(int j=0;j<static_cast<int>(obj->outPut.size());j++){
+            PatchLink *link = obj->outPut[j];
+            map<int,size_t>::iterator dst = slots.find(link->toObjectID);
+            if(!link->isDisabled && dst != slots.end() && dst->second != s){
+                upstream[dst->second].push_back(s);
+            }
+        }
+    }
+    scheduleUpstreamBegin.assign(1,0);
+    scheduleUpstream.clear();
+    for(size_t s=0;s<upstream.size();s++){
+        scheduleUpstream.insert(scheduleUpstream.end(),upstream[s].begin(),upstream[s].end());
+        scheduleUpstreamBegin.push_back(scheduleUpstream.size());
+    }
+    // everything was marked dirty, downstream objects see the first run as new data too
+    scheduleChanged.assign(executionOrder.size(),1);
+
+    // dense objects list
+    objectsList.clear();
+    objectsList.reserve(patchObjects.size());
+    for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
+        if(it->second != nullptr){
+            objectsList.push_back(it->second);
+        }
+    }
+
+    publishAudioGraph();
+
+    bGraphChanged = false;
+}
+
+//--------------------------------------------------------------
+void ofxVisualProgramming::publishAudioGraph(){
+    // audio nodes in execution order, so every audio object runs after the ones feeding it;
+    // objects waiting to be erased are left out
+    AudioGraphSnapshot *snapshot = new AudioGraphSnapshot();
+    for(size_t i=0;i<executionOrder.size();i++){
+        PatchObject *obj = executionOrder.at(i);
+        if(obj->getWillErase()){
+            continue;
+        }
+        if(obj->getIsAudioINObject()){
+            snapshot->inNodes.push_back(obj);
+        }
+        if(obj->getIsAudioOUTObject()){
+            snapshot->outNodes.push_back(obj);
+        }
+    }
+    audioGraph.publish(snapshot);
+}
+
+//--------------------------------------------------------------
+PatchObject* ofxVisualProgramming::getObject(int id){
+    // lookup without inserting null entries for unknown ids
+    map<int,PatchObject*>::iterator it = patchObjects.find(id);
+    if(it != patchObjects.end()){
+        return it->second;
+    }
+    return nullptr;
+}
+
 //--------------------------------------------------------------
 void ofxVisualProgramming::removeObject(int &id){
     resetTime = ofGetElapsedTimeMillis();
 
-    if ((id != -1) && (patchObjects[id] != nullptr)){
+    if ((id != -1) && (getObject(id) != nullptr)){
 
         int targetID = id;
         bool found = false;
-        ofxXmlSettings XML;
-        if (XML.loadFile(currentPatchFile)){
+        PatchDocument::Access doc = PatchDocument::getInstance().access(currentPatchFile);
+        ofxXmlSettings &XML = doc.getXml();
+        if (doc.isLoaded()){
             int totalObjects = XML.getNumTags("object");
 
             for(int i=0;i<totalObjects;i++){
@@ -1058,7 +1391,7 @@ void ofxVisualProgramming::removeObject(int &id){
             // remove object
             if(found){
                 XML.removeTag("object", targetID);
-                XML.saveFile();
+                doc.setDirty();
             }
         }
 
@@ -1069,11 +1402,12 @@ void ofxVisualProgramming::removeObject(int &id){
                     tempBuffer.push_back(it->second->outPut[j]);
                 }else{
                     it->second->outPut[j]->isDisabled = true;
-                    patchObjects[it->second->outPut[j]->toObjectID]->inletsConnected[it->second->outPut[j]->toInletID] = false;
+                    patchObjects[it->second->outPut[j]->toObjectID]->unlinkInlet(it->second->outPut[j]->toInletID);
                 }
             }
             it->second->outPut = tempBuffer;
         }
+        bGraphChanged = true;
 
     }
 }
@@ -1098,7 +1432,12 @@ void ofxVisualProgramming::duplicateObject(int &id){
 bool ofxVisualProgramming::connect(int fromID, int fromOutlet, int toID,int toInlet, int linkType){
     bool connected = false;
 
-    if((fromID != -1) && (patchObjects[fromID] != nullptr) && (toID != -1) && (patchObjects[toID] != nullptr) && (patchObjects[fromID]->getOutletType(fromOutlet) == patchObjects[toID]->getInletType(toInlet)) && !patchObjects[toID]->inletsConnected[toInlet]){
+    // links of older patches to an outlet that was split by type
+    if((fromID != -1) && (getObject(fromID) != nullptr) && (toID != -1) && (getObject(toID) != nullptr) && patchObjects[fromID]->getOutletType(fromOutlet) != patchObjects[toID]->getInletType(toInlet)){
+        fromOutlet = patchObjects[fromID]->upgradeLinkOutlet(fromOutlet,patchObjects[toID]->getInletType(toInlet));
+    }
+
+    if((fromID != -1) && (getObject(fromID) != nullptr) && (toID != -1) && (getObject(toID) != nullptr) && (patchObjects[fromID]->getOutletType(fromOutlet) == patchObjects[toID]->getInletType(toInlet)) && !patchObjects[toID]->inletsConnected[toInlet]){
         PatchLink   *tempLink = new PatchLink();
 
         tempLink->posFrom = patchObjects[fromID]->getOutletPosition(fromOutlet);
@@ -1108,6 +1447,9 @@ bool ofxVisualProgramming::connect(int fromID, int fromOutlet, int toID,int toIn
         tempLink->toObjectID = toID;
         tempLink->toInletID = toInlet;
         tempLink->isDisabled = false;
+        tempLink->toObject = nullptr;
+        tempLink->fromLayoutVersion = 0;
+        tempLink->toLayoutVersion = 0;
 
         tempLink->linkVertices.push_back(DraggableVertex(tempLink->posFrom.x,tempLink->posFrom.y));
         tempLink->linkVertices.push_back(DraggableVertex(tempLink->posFrom.x+20,tempLink->posFrom.y));
@@ -1118,16 +1460,12 @@ bool ofxVisualProgramming::connect(int fromID, int fromOutlet, int toID,int toIn
 
         patchObjects[toID]->inletsConnected[toInlet] = true;
 
-        if(tempLink->type == VP_LINK_NUMERIC){
-            patchObjects[toID]->_inletParams[toInlet] = new float();
-        }else if(tempLink->type == VP_LINK_STRING){
-            patchObjects[toID]->_inletParams[toInlet] = new string();
-        }else if(tempLink->type == VP_LINK_ARRAY){
-            patchObjects[toID]->_inletParams[toInlet] = new vector<float>();
-        }else if(tempLink->type == VP_LINK_TEXTURE){
-            patchObjects[toID]->_inletParams[toInlet] = new ofTexture();
-        }else if(tempLink->type == VP_LINK_AUDIO){
-            patchObjects[toID]->_inletParams[toInlet] = new ofSoundBuffer();
+        // wire the inlet straight to the outlet data, the same the update pass keeps pushing:
+        // numbers are copied by value, every other type shares the outlet buffer (no per link allocation)
+        patchObjects[toID]->linkInlet(toInlet,patchObjects[fromID]->bindOutletData(fromOutlet),patchObjects[fromID]->getOutletVersion(fromOutlet));
+        patchObjects[toID]->markDirty();
+
+        if(tempLink->type == VP_LINK_AUDIO){
             if(patchObjects[fromID]->getIsPDSPPatchableObject() && patchObjects[toID]->getIsPDSPPatchableObject()){
                 patchObjects[fromID]->pdspOut[fromOutlet] >> patchObjects[toID]->pdspIn[toInlet];
             }else if(patchObjects[fromID]->getName() == "audio device" && patchObjects[toID]->getIsPDSPPatchableObject()){
@@ -1137,6 +1475,7 @@ bool ofxVisualProgramming::connect(int fromID, int fromOutlet, int toID,int toIn
 
         checkSpecialConnection(fromID,toID,linkType);
 
+        bGraphChanged = true;
         connected = true;
     }
 
@@ -1199,302 +1538,16 @@ bool ofxVisualProgramming::weAlreadyHaveObject(string name){
 
 //--------------------------------------------------------------
 PatchObject* ofxVisualProgramming::selectObject(string objname){
-    PatchObject* tempObj;
-
-#if defined(TARGET_LINUX) || defined(TARGET_OSX)
-    if(objname == "bash script"){
-        tempObj = new BashScript();
-    }else if(objname == "face tracker"){
-        tempObj = new FaceTracker();
-    }else
-#endif
-
-    if(objname == "python script"){
-        tempObj = new PythonScript();
-    }else if(objname == "lua script"){
-        tempObj = new LuaScript();
-    }else if(objname == "processing script"){
-        tempObj = new ProcessingScript();
-    }else if(objname == "shader object"){
-        tempObj = new ShaderObject();
-    // -------------------------------------- Audio Analysis
-    }else if(objname == "audio analyzer"){
-        tempObj = new AudioAnalyzer();
-    }else if(objname == "audio device"){
-        tempObj = new AudioDevice();
-    }else if(objname == "beat extractor"){
-        tempObj = new BeatExtractor();
-    }else if(objname == "bpm extractor"){
-        tempObj = new BPMExtractor();
-    }else if(objname == "centroid extractor"){
-        tempObj = new CentroidExtractor();
-    }else if(objname == "dissonance extractor"){
-        tempObj = new DissonanceExtractor();
-    }else if(objname == "fft extractor"){
-        tempObj = new FftExtractor();
-    }else if(objname == "hfc extractor"){
-        tempObj = new HFCExtractor();
-    }else if(objname == "hpcp extractor"){
-        tempObj = new HPCPExtractor();
-    }else if(objname == "inharmonicity extractor"){
-        tempObj = new InharmonicityExtractor();
-    }else if(objname == "mel bands extractor"){
-        tempObj = new MelBandsExtractor();
-    }else if(objname == "mfcc extractor"){
-        tempObj = new MFCCExtractor();
-    }else if(objname == "onset extractor"){
-        tempObj = new OnsetExtractor();
-    }else if(objname == "pitch extractor"){
-        tempObj = new PitchExtractor();
-    }else if(objname == "power extractor"){
-        tempObj = new PowerExtractor();
-    }else if(objname == "rms extractor"){
-        tempObj = new RMSExtractor();
-    }else if(objname == "rolloff extractor"){
-        tempObj = new RollOffExtractor();
-    }else if(objname == "tristimulus extractor"){
-        tempObj = new TristimulusExtractor();
-    // -------------------------------------- Communications
-    }else if(objname == "arduino serial"){
-        tempObj = new ArduinoSerial();
-    }else if(objname == "key pressed"){
-        tempObj = new KeyPressed();
-    }else if(objname == "key released"){
-        tempObj = new KeyReleased();
-    }else if(objname == "midi key"){
-        tempObj = new MidiKey();
-    }else if(objname == "midi knob"){
-        tempObj = new MidiKnob();
-    }else if(objname == "midi pad"){
-        tempObj = new MidiPad();
-    }else if(objname == "midi receiver"){
-        tempObj = new MidiReceiver();
-    }else if(objname == "midi score"){
-        tempObj = new MidiScore();
-    }else if(objname == "midi sender"){
-        tempObj = new MidiSender();
-    }else if(objname == "osc receiver"){
-        tempObj = new OscReceiver();
-    }else if(objname == "osc sender"){
-        tempObj = new OscSender();
-    // -------------------------------------- Data
-    }else if(objname == "bang multiplexer"){
-        tempObj = new BangMultiplexer();
-    }else if(objname == "bang to float"){
-        tempObj = new BangToFloat();
-    }else if(objname == "data to texture"){
-        tempObj = new DataToTexture();
-    }else if(objname == "vector at"){
-        tempObj = new VectorAt();
-    }else if(objname == "vector concat"){
-        tempObj = new VectorConcat();
-    }else if(objname == "floats to vector"){
-        tempObj = new FloatsToVector();
-    }else if(objname == "texture to data"){
-        tempObj = new TextureToData();
-    }else if(objname == "vector gate"){
-        tempObj = new VectorGate();
-    }else if(objname == "vector multiply"){
-        tempObj = new VectorMultiply();
-    // -------------------------------------- Graphics
-    }else if(objname == "image exporter"){
-        tempObj = new ImageExporter();
-    }else if(objname == "image loader"){
-        tempObj = new ImageLoader();
-    // -------------------------------------- Sound
-    }else if(objname == "ADSR envelope"){
-        tempObj = new pdspADSR();
-    }else if(objname == "AHR envelope"){
-        tempObj = new pdspAHR();
-    }else if(objname == "amp"){
-        tempObj = new SigMult();
-    }else if(objname == "audio exporter"){
-        tempObj = new AudioExporter();
-    }else if(objname == "audio gate"){
-        tempObj = new AudioGate();
-    }else if(objname == "bit noise"){
-        tempObj = new pdspBitNoise();
-    }else if(objname == "crossfader"){
-        tempObj = new Crossfader();
-    }else if(objname == "chorus"){
-        tempObj = new pdspChorusEffect();
-    }else if(objname == "comb filter"){
-        tempObj = new pdspCombFilter();
-    }else if(objname == "compressor"){
-        tempObj = new pdspCompressor();
-    }else if(objname == "decimator"){
-        tempObj = new pdspDecimator();
-    }else if(objname == "ducker"){
-        tempObj = new pdspDucker();
-    }else if(objname == "lfo"){
-        tempObj = new pdspLFO();
-    }else if(objname == "mixer"){
-        tempObj = new Mixer();
-    }else if(objname == "note to frequency"){
-        tempObj = new NoteToFrequency();
-    }else if(objname == "panner"){
-        tempObj = new Panner();
-    }else if(objname == "pd patch"){
-        tempObj = new PDPatch();
-    }else if(objname == "quad panner"){
-        tempObj = new QuadPanner();
-    }else if(objname == "pulse"){
-        tempObj = new OscPulse();
-    }else if(objname == "reverb"){
-        tempObj = new pdspReverb();
-    }else if(objname == "saw"){
-        tempObj = new OscSaw();
-    }else if(objname == "sine"){
-        tempObj = new Oscillator();
-    }else if(objname == "triangle"){
-        tempObj = new OscTriangle();
-    }else if(objname == "signal trigger"){
-        tempObj = new SignalTrigger();
-    }else if(objname == "soundfile player"){
-        tempObj = new SoundfilePlayer();
-    }else if(objname == "delay"){
-        tempObj = new pdspDelay();
-    }else if(objname == "data oscillator"){
-        tempObj = new pdspDataOscillator();
-    }else if(objname == "low pass"){
-        tempObj = new pdspHiCut();
-    }else if(objname == "hi pass"){
-        tempObj = new pdspLowCut();
-    }else if(objname == "white noise"){
-        tempObj = new pdspWhiteNoise();
-    // -------------------------------------- Math
-    }else if(objname == "add"){
-        tempObj = new Add();
-    }else if(objname == "clamp"){
-        tempObj = new Clamp();
-    }else if(objname == "constant"){
-        tempObj = new Constant();
-    }else if(objname == "divide"){
-        tempObj = new Divide();
-    }else if(objname == "metronome"){
-        tempObj = new Metronome();
-    }else if(objname == "modulus"){
-        tempObj = new Module();
-    }else if(objname == "multiply"){
-        tempObj = new Multiply();
-    }else if(objname == "range"){
-        tempObj = new Range();
-    }else if(objname == "simple random"){
-        tempObj = new SimpleRandom();
-    }else if(objname == "simple noise"){
-        tempObj = new SimpleNoise();
-    }else if(objname == "smooth"){
-        tempObj = new Smooth();
-    }else if(objname == "subtract"){
-        tempObj = new Subtract();
-    // -------------------------------------- Logic
-    }else if(objname == "&&"){
-        tempObj = new AND();
-    }else if(objname == "||"){
-        tempObj = new OR();
-    }else if(objname == "=="){
-        tempObj = new Equality();
-    }else if(objname == "!="){
-        tempObj = new Inequality();
-    }else if(objname == ">"){
-        tempObj = new BiggerThan();
-    }else if(objname == "<"){
-        tempObj = new SmallerThan();
-    }else if(objname == "counter"){
-        tempObj = new Counter();
-    }else if(objname == "delay bang"){
-        tempObj = new DelayBang();
-    }else if(objname == "delay float"){
-        tempObj = new DelayFloat();
-    }else if(objname == "gate"){
-        tempObj = new Gate();
-    }else if(objname == "inverter"){
-        tempObj = new Inverter();
-    }else if(objname == "loadbang"){
-        tempObj = new LoadBang();
-    }else if(objname == "select"){
-        tempObj = new Select();
-    }else if(objname == "spigot"){
-        tempObj = new Spigot();
-    }else if(objname == "timed semaphore"){
-        tempObj = new TimedSemaphore();
-    // -------------------------------------- GUI
-    }else if(objname == "2d pad"){
-        tempObj = new mo2DPad();
-    }else if(objname == "bang"){
-        tempObj = new moBang();
-    }else if(objname == "comment"){
-        tempObj = new moComment();
-    }else if(objname == "message"){
-        tempObj = new moMessage();
-    }else if(objname == "player controls"){
-        tempObj = new moPlayerControls();
-    }else if(objname == "slider"){
-        tempObj = new moSlider();
-    }else if(objname == "sonogram"){
-        tempObj = new moSonogram();
-    }else if(objname == "timeline"){
-        tempObj = new moTimeline();
-    }else if(objname == "trigger"){
-        tempObj = new moTrigger();
-    }else if(objname == "video viewer"){
-        tempObj = new moVideoViewer();
-    }else if(objname == "signal viewer"){
-        tempObj = new moSignalViewer();
-    }else if(objname == "vu meter"){
-        tempObj = new moVUMeter();
-    // -------------------------------------- VIDEO
-    }else if(objname == "kinect grabber"){
-        tempObj = new KinectGrabber();
-    }else if(objname == "video player"){
-        tempObj = new VideoPlayer();
-    }else if(objname == "video grabber"){
-        tempObj = new VideoGrabber();
-    }else if(objname == "video feedback"){
-        tempObj = new VideoDelay();
-    }else if(objname == "video exporter"){
-        tempObj = new VideoExporter();
-    }else if(objname == "video crop"){
-        tempObj = new VideoCrop();
-    }else if(objname == "video gate"){
-        tempObj = new VideoGate();
-    }else if(objname == "video scale"){
-        tempObj = new VideoScale();
-    }else if(objname == "video streaming"){
-        tempObj = new VideoStreaming();
-    }else if(objname == "video timedelay"){
-        tempObj = new VideoTimelapse();
-    // -------------------------------------- WEB
-    }else if(objname == "http form"){
-        tempObj = new moHttpForm();
-    // -------------------------------------- WINDOWING
-    }else if(objname == "live patching"){
-        tempObj = new LivePatching();
-    }else if(objname == "output window"){
-        tempObj = new OutputWindow();
-    }else if(objname == "projection mapping"){
-        tempObj = new ProjectionMapping();
-    // -------------------------------------- COMPUTER VISION
-    }else if(objname == "background subtraction"){
-        tempObj = new BackgroundSubtraction();
-    }else if(objname == "chroma key"){
-        tempObj = new ChromaKey();
-    }else if(objname == "color tracking"){
-        tempObj = new ColorTracking();
-    }else if(objname == "contour tracking"){
-        tempObj = new ContourTracking();
-    }else if(objname == "haar tracking"){
-        tempObj = new HaarTracking();
-    }else if(objname == "motion detection"){
-        tempObj = new MotionDetection();
-    }else if(objname == "optical flow"){
-        tempObj = new OpticalFlow();
-    }else{
-        tempObj = nullptr;
+    // nullptr for unknown (or not available on this platform) objects
+    // ofxDatGui needs a GL context too: without one only the objects with no GL and no GUI can be set up
+    if(!hasGLContext){
+        const ObjectFactoryEntry *entry = ObjectFactory::getInstance().getEntry(objname);
+        if(entry != nullptr && entry->isMainThreadOnly()){
+            ofLog(OF_LOG_WARNING,"%s object skipped, it needs an OpenGL context",objname.c_str());
+            return nullptr;
+        }
     }
-
-
-    return tempObj;
+    return ObjectFactory::getInstance().create(objname);
 }
 
 //--------------------------------------------------------------
@@ -1502,7 +1555,7 @@ void ofxVisualProgramming::newPatch(){
     string newFileName = "patch_"+ofGetTimestampString("%y%m%d")+alphabet.at(newFileCounter)+".xml";
     ofFile fileToRead(ofToDataPath("empty_patch.xml",true));
     ofFile newPatchFile(ofToDataPath("temp/"+newFileName,true));
-    ofFile::copyFromTo(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath(),true,true);
+    PatchDocument::getInstance().copyFile(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath());
     newFileCounter++;
 
     currentPatchFile = newPatchFile.getAbsolutePath();
@@ -1517,21 +1570,43 @@ void ofxVisualProgramming::newTempPatchFromFile(string patchFile){
     string newFileName = "patch_"+ofGetTimestampString("%y%m%d")+alphabet.at(newFileCounter)+".xml";
     ofFile fileToRead(patchFile);
     ofFile newPatchFile(ofToDataPath("temp/"+newFileName,true));
-    ofFile::copyFromTo(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath(),true,true);
-    newFileCounter++;
+    if(PatchBinary::isBinaryPatch(fileToRead.getAbsolutePath())){
+        // binary patches: objects and links come from the binary tables, the working document
+        // (settings read by the objects setup, later edits) is built in memory straight from the
+        // node table, no text parsing (the XML temp file is written on edits or save)
+        PatchBinary binaryPatch;
+        if(!binaryPatch.open(fileToRead.getAbsolutePath()) || !PatchDocument::getInstance().load(newPatchFile.getAbsolutePath(),binaryPatch)){
+            ofLog(OF_LOG_ERROR,"Can't open the binary patch %s",fileToRead.getAbsolutePath().c_str());
+            return;
+        }
+        newFileCounter++;
 
-    currentPatchFile = newPatchFile.getAbsolutePath();
-    openPatch(currentPatchFile);
+        currentPatchFile = newPatchFile.getAbsolutePath();
+        openPatch(currentPatchFile,&binaryPatch);
+    }else{
+        if(!PatchDocument::getInstance().copyFile(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath())){
+            ofLog(OF_LOG_ERROR,"Can't open the patch %s",fileToRead.getAbsolutePath().c_str());
+            return;
+        }
+        newFileCounter++;
+
+        currentPatchFile = newPatchFile.getAbsolutePath();
+        openPatch(currentPatchFile);
+    }
 
     tempPatchFile = currentPatchFile;
 }
 
 //--------------------------------------------------------------
-void ofxVisualProgramming::openPatch(string patchFile){
+void ofxVisualProgramming::openPatch(string patchFile, const PatchBinary *binary){
     bLoadingNewPatch = true;
 
     currentPatchFile = patchFile;
 
+    // detach the previous patch from the sound stream before tearing it down
+    audioGraph.publish(new AudioGraphSnapshot());
+    audioGraph.synchronize();
+
     // clear previous patch
     for(map<int,PatchObject*>::iterator it = patchObjects.begin(); it != patchObjects.end(); it++ ){
         it->second->removeObjectContent();
@@ -1540,164 +1615,206 @@ void ofxVisualProgramming::openPatch(string patchFile){
         delete it->second;
     }*/
     patchObjects.clear();
+    PatchProfiler::getInstance().clear();
+    executionOrder.clear();
+    scheduleLevels.clear();
+    scheduleFlags.clear();
+    scheduleChanged.clear();
+    scheduleUpstreamBegin.clear();
+    scheduleUpstream.clear();
+    objectsList.clear();
+    bGraphChanged = true;
 
     // load new patch
-    loadPatch(currentPatchFile);
+    loadPatch(currentPatchFile,binary);
 
 }
 
 //--------------------------------------------------------------
-void ofxVisualProgramming::loadPatch(string patchFile){
+void ofxVisualProgramming::loadPatch(string patchFile, const PatchBinary *binary){
 
+    // xml patches: objects and links are listed from a copy, objects read the patch document while loading;
+    // binary patches list them straight from the object and link tables
     ofxXmlSettings XML;
 
-    if (XML.loadFile(patchFile)){
-
-        // Load main settings
-        if (XML.pushTag("settings")){
-            // Setup projector dimension
-            output_width = XML.getValue("output_width",0);
-            output_height = XML.getValue("output_height",0);
-
-            // setup audio
-            dspON = XML.getValue("dsp",0);
-            audioINDev = XML.getValue("audio_in_device",0);
-            audioOUTDev = XML.getValue("audio_out_device",0);
-            audioBufferSize = XML.getValue("buffer_size",0);
-
-            audioDevices = soundStreamIN.getDeviceList();
-            audioDevicesStringIN.clear();
-            audioDevicesID_IN.clear();
-            audioDevicesStringOUT.clear();
-            audioDevicesID_OUT.clear();
-            ofLog(OF_LOG_NOTICE," ");
-            ofLog(OF_LOG_NOTICE,"------------------- AUDIO DEVICES");
-            for(size_t i=0;i<audioDevices.size();i++){
-                if(audioDevices[i].inputChannels > 0){
-                    audioDevicesStringIN.push_back("  "+audioDevices[i].name);
-                    audioDevicesID_IN.push_back(i);
+    if (binary != nullptr ? binary->isOpen() : PatchDocument::getInstance().load(patchFile,XML)){
+
+        // Load main settings, in place in the patch document
+        // (scoped: the objects setup reads the document too)
+        {
+            PatchDocument::Settings settings = PatchDocument::getInstance().settings(patchFile);
+            if (settings.isValid()){
+                ofxXmlSettings &settingsXML = settings.getXml();
+                // Setup projector dimension
+                output_width = settingsXML.getValue("output_width",0);
+                output_height = settingsXML.getValue("output_height",0);
+
+                // setup audio
+                dspON = settingsXML.getValue("dsp",0);
+                audioINDev = settingsXML.getValue("audio_in_device",0);
+                audioOUTDev = settingsXML.getValue("audio_out_device",0);
+                audioBufferSize = settingsXML.getValue("buffer_size",0);
+
+                if(headless){
+                    // no sound stream, audio is driven from update() at the patch sample rate
+                    audioSampleRate = settingsXML.getValue("sample_rate_out",44100);
+                    if(audioSampleRate < 44100){
+                        audioSampleRate = 44100;
+                    }
+                    headlessAudioTime = 0;
+                }else{
+                    audioDevices = soundStreamIN.getDeviceList();
+                    audioDevicesStringIN.clear();
+                    audioDevicesID_IN.clear();
+                    audioDevicesStringOUT.clear();
+                    audioDevicesID_OUT.clear();
+                    ofLog(OF_LOG_NOTICE," ");
+                    ofLog(OF_LOG_NOTICE,"------------------- AUDIO DEVICES");
+                    for(size_t i=0;i<audioDevices.size();i++){
+                        if(audioDevices[i].inputChannels > 0){
+                            audioDevicesStringIN.push_back("  "+audioDevices[i].name);
+                            audioDevicesID_IN.push_back(i);
 
-                }
-                if(audioDevices[i].outputChannels > 0){
-                    audioDevicesStringOUT.push_back("  "+audioDevices[i].name);
-                    audioDevicesID_OUT.push_back(i);
-                }
-                if(audioINDev == i){
-                   audioGUIINIndex = audioDevicesID_IN.size()-1;
-                }
-                if(audioOUTDev == i){
-                   audioGUIOUTIndex = audioDevicesID_OUT.size()-1;
-                }
-                string tempSR = "";
-                for(size_t sr=0;sr<audioDevices[i].sampleRates.size();sr++){
-                    if(sr < audioDevices[i].sampleRates.size()-1){
-                        tempSR += ofToString(audioDevices[i].sampleRates.at(sr))+", ";
-                    }else{
-                        tempSR += ofToString(audioDevices[i].sampleRates.at(sr));
+                        }
+                        if(audioDevices[i].outputChannels > 0){
+                            audioDevicesStringOUT.push_back("  "+audioDevices[i].name);
+                            audioDevicesID_OUT.push_back(i);
+                        }
+                        if(audioINDev == i){
+                           audioGUIINIndex = audioDevicesID_IN.size()-1;
+                        }
+                        if(audioOUTDev == i){
+                           audioGUIOUTIndex = audioDevicesID_OUT.size()-1;
+                        }
+                        string tempSR = "";
+                        for(size_t sr=0;sr<audioDevices[i].sampleRates.size();sr++){
+                            if(sr < audioDevices[i].sampleRates.size()-1){
+                                tempSR += ofToString(audioDevices[i].sampleRates.at(sr))+", ";
+                            }else{
+                                tempSR += ofToString(audioDevices[i].sampleRates.at(sr));
+                            }
+                        }
+                        ofLog(OF_LOG_NOTICE,"Device[%zu]: %s (IN:%i - OUT:%i), Sample Rates: %s",i,audioDevices[i].name.c_str(),audioDevices[i].inputChannels,audioDevices[i].outputChannels,tempSR.c_str());
                     }
-                }
-                ofLog(OF_LOG_NOTICE,"Device[%zu]: %s (IN:%i - OUT:%i), Sample Rates: %s",i,audioDevices[i].name.c_str(),audioDevices[i].inputChannels,audioDevices[i].outputChannels,tempSR.c_str());
-            }
-            ofLog(OF_LOG_NOTICE," ");
+                    ofLog(OF_LOG_NOTICE," ");
 
-            audioSampleRate = audioDevices[audioOUTDev].sampleRates[0];
+                    audioSampleRate = audioDevices[audioOUTDev].sampleRates[0];
 
-            if(audioSampleRate < 44100){
-                audioSampleRate = 44100;
-            }
+                    if(audioSampleRate < 44100){
+                        audioSampleRate = 44100;
+                    }
 
-            XML.setValue("sample_rate_in",audioSampleRate);
-            XML.setValue("sample_rate_out",audioSampleRate);
-            XML.setValue("input_channels",static_cast<int>(audioDevices[audioINDev].inputChannels));
-            XML.setValue("output_channels",static_cast<int>(audioDevices[audioOUTDev].outputChannels));
-            XML.saveFile();
+                    settingsXML.setValue("sample_rate_in",audioSampleRate);
+                    settingsXML.setValue("sample_rate_out",audioSampleRate);
+                    settingsXML.setValue("input_channels",static_cast<int>(audioDevices[audioINDev].inputChannels));
+                    settingsXML.setValue("output_channels",static_cast<int>(audioDevices[audioOUTDev].outputChannels));
+                    settings.setDirty();
 
-            delete engine;
-            engine = nullptr;
-            engine = new pdsp::Engine();
+                    delete engine;
+                    engine = nullptr;
+                    engine = new pdsp::Engine();
 
-            if(dspON){
-                engine->setChannels(audioDevices[audioINDev].inputChannels, audioDevices[audioOUTDev].outputChannels);
-                this->setChannels(audioDevices[audioINDev].inputChannels,0);
+                    if(dspON){
+                        engine->setChannels(audioDevices[audioINDev].inputChannels, audioDevices[audioOUTDev].outputChannels);
+                        this->setChannels(audioDevices[audioINDev].inputChannels,0);
+
+                        for(int in=0;in<audioDevices[audioINDev].inputChannels;in++){
+                            engine->audio_in(in) >> this->in(in);
+                        }
+                        this->out_silent() >> engine->blackhole();
+
+                        engine->setOutputDeviceID(audioDevices[audioOUTDev].deviceID);
+                        engine->setInputDeviceID(audioDevices[audioINDev].deviceID);
+                        engine->setup(audioSampleRate, audioBufferSize, 3);
+
+                        ofLog(OF_LOG_NOTICE," ");
+                        ofLog(OF_LOG_NOTICE,"------------------- Soundstream INPUT Started on");
+                        ofLog(OF_LOG_NOTICE,"Audio device: %s",audioDevices[audioINDev].name.c_str());
+                        ofLog(OF_LOG_NOTICE," ");
+                        ofLog(OF_LOG_NOTICE,"------------------- Soundstream OUTPUT Started on");
+                        ofLog(OF_LOG_NOTICE,"Audio device: %s",audioDevices[audioOUTDev].name.c_str());
+                        ofLog(OF_LOG_NOTICE," ");
+                    }
 
-                for(int in=0;in<audioDevices[audioINDev].inputChannels;in++){
-                    engine->audio_in(in) >> this->in(in);
                 }
-                this->out_silent() >> engine->blackhole();
-
-                engine->setOutputDeviceID(audioDevices[audioOUTDev].deviceID);
-                engine->setInputDeviceID(audioDevices[audioINDev].deviceID);
-                engine->setup(audioSampleRate, audioBufferSize, 3);
-
-                ofLog(OF_LOG_NOTICE," ");
-                ofLog(OF_LOG_NOTICE,"------------------- Soundstream INPUT Started on");
-                ofLog(OF_LOG_NOTICE,"Audio device: %s",audioDevices[audioINDev].name.c_str());
-                ofLog(OF_LOG_NOTICE," ");
-                ofLog(OF_LOG_NOTICE,"------------------- Soundstream OUTPUT Started on");
-                ofLog(OF_LOG_NOTICE,"Audio device: %s",audioDevices[audioOUTDev].name.c_str());
-                ofLog(OF_LOG_NOTICE," ");
-            }
 
-            XML.popTag();
+            }
         }
 
-        int totalObjects = XML.getNumTags("object");
+        // Load all the patch objects, binary patches configure them from the object table
+        // and their node subtree, xml patches from their <object> tag in the document
+        int totalObjects = binary != nullptr ? static_cast<int>(binary->getNumObjects()) : XML.getNumTags("object");
 
-        // Load all the patch objects
         for(int i=0;i<totalObjects;i++){
-            if(XML.pushTag("object", i)){
-                string objname = XML.getValue("name","");
-                bool loaded = false;
-                PatchObject* tempObj = selectObject(objname);
-                if(tempObj != nullptr){
+            string objname = "";
+            if(binary != nullptr){
+                objname = binary->getString(binary->getObjects()[i].name);
+            }else if(XML.pushTag("object", i)){
+                objname = XML.getValue("name","");
+                XML.popTag();
+            }else{
+                continue;
+            }
+            bool loaded = false;
+            PatchObject* tempObj = selectObject(objname);
+            if(tempObj != nullptr){
+                if(binary != nullptr){
+                    loaded = tempObj->loadConfig(mainWindow,*engine,*binary,static_cast<uint32_t>(i),patchFile);
+                }else{
                     loaded = tempObj->loadConfig(mainWindow,*engine,i,patchFile);
-                    if(loaded){
-                        tempObj->setIsRetina(isRetina);
-                        ofAddListener(tempObj->dragEvent ,this,&ofxVisualProgramming::dragObject);
-                        ofAddListener(tempObj->removeEvent ,this,&ofxVisualProgramming::removeObject);
-                        ofAddListener(tempObj->resetEvent ,this,&ofxVisualProgramming::resetObject);
-                        ofAddListener(tempObj->reconnectOutletsEvent ,this,&ofxVisualProgramming::reconnectObjectOutlets);
-                        ofAddListener(tempObj->iconifyEvent ,this,&ofxVisualProgramming::iconifyObject);
-                        ofAddListener(tempObj->duplicateEvent ,this,&ofxVisualProgramming::duplicateObject);
-                        // Insert the new patch into the map
-                        patchObjects[tempObj->getId()] = tempObj;
-                        actualObjectID = tempObj->getId();
-                        lastAddedObjectID = tempObj->getId();
-                    }
                 }
-                XML.popTag();
+                if(loaded){
+                    tempObj->setIsRetina(isRetina);
+                    ofAddListener(tempObj->dragEvent ,this,&ofxVisualProgramming::dragObject);
+                    ofAddListener(tempObj->removeEvent ,this,&ofxVisualProgramming::removeObject);
+                    ofAddListener(tempObj->resetEvent ,this,&ofxVisualProgramming::resetObject);
+                    ofAddListener(tempObj->reconnectOutletsEvent ,this,&ofxVisualProgramming::reconnectObjectOutlets);
+                    ofAddListener(tempObj->iconifyEvent ,this,&ofxVisualProgramming::iconifyObject);
+                    ofAddListener(tempObj->duplicateEvent ,this,&ofxVisualProgramming::duplicateObject);
+                    // Insert the new patch into the map
+                    patchObjects[tempObj->getId()] = tempObj;
+                    actualObjectID = tempObj->getId();
+                    lastAddedObjectID = tempObj->getId();
+                }
             }
         }
 
         // Load Links
-        for(int i=0;i<totalObjects;i++){
-            if(XML.pushTag("object", i)){
-                int fromID = XML.getValue("id", -1);
-                if (XML.pushTag("outlets")){
-                    int totalOutlets = XML.getNumTags("link");
-                    for(int j=0;j<totalOutlets;j++){
-                        if (XML.pushTag("link",j)){
-                            int linkType = XML.getValue("type", 0);
-                            int totalLinks = XML.getNumTags("to");
-                            for(int z=0;z<totalLinks;z++){
-                                if(XML.pushTag("to",z)){
-                                    int toObjectID = XML.getValue("id", 0);
-                                    int toInletID = XML.getValue("inlet", 0);
-
-                                    if(connect(fromID,j,toObjectID,toInletID,linkType)){
-                                        //ofLog(OF_LOG_NOTICE,"Connected object %s, outlet %i TO object %s, inlet %i",patchObjects[fromID]->getName().c_str(),z,patchObjects[toObjectID]->getName().c_str(),toInletID);
-                                    }
+        if(binary != nullptr){
+            const PatchBinary::Link *binaryLinks = binary->getLinks();
+            for(uint32_t l=0;l<binary->getNumLinks();l++){
+                connect(binaryLinks[l].fromObjectID,binaryLinks[l].fromOutletID,binaryLinks[l].toObjectID,binaryLinks[l].toInletID,binaryLinks[l].type);
+            }
+        }else{
+            for(int i=0;i<totalObjects;i++){
+                if(XML.pushTag("object", i)){
+                    int fromID = XML.getValue("id", -1);
+                    if (XML.pushTag("outlets")){
+                        int totalOutlets = XML.getNumTags("link");
+                        for(int j=0;j<totalOutlets;j++){
+                            if (XML.pushTag("link",j)){
+                                int linkType = XML.getValue("type", 0);
+                                int totalLinks = XML.getNumTags("to");
+                                for(int z=0;z<totalLinks;z++){
+                                    if(XML.pushTag("to",z)){
+                                        int toObjectID = XML.getValue("id", 0);
+                                        int toInletID = XML.getValue("inlet", 0);
+
+                                        if(connect(fromID,j,toObjectID,toInletID,linkType)){
+                                            //ofLog(OF_LOG_NOTICE,"Connected object %s, outlet %i TO object %s, inlet %i",patchObjects[fromID]->getName().c_str(),z,patchObjects[toObjectID]->getName().c_str(),toInletID);
+                                        }
 
-                                    XML.popTag();
+                                        XML.popTag();
+                                    }
                                 }
+                                XML.popTag();
                             }
-                            XML.popTag();
                         }
-                    }
 
+                        XML.popTag();
+                    }
                     XML.popTag();
                 }
-                XML.popTag();
             }
         }
 
@@ -1714,10 +1831,19 @@ void ofxVisualProgramming::loadPatch(string patchFile){
 //--------------------------------------------------------------
 void ofxVisualProgramming::savePatchAs(string patchFile){
 
+    // binary export, the session keeps working on the current XML patch
+    if(ofToLower(ofFilePath::getFileExt(patchFile)) == PATCH_BINARY_EXTENSION){
+        ofxXmlSettings XML;
+        if(!PatchDocument::getInstance().load(currentPatchFile,XML) || !PatchBinary::save(patchFile,XML)){
+            ofLog(OF_LOG_ERROR,"Can't export the patch to %s",patchFile.c_str());
+        }
+        return;
+    }
+
     string newFileName = patchFile;
     ofFile fileToRead(currentPatchFile);
     ofFile newPatchFile(newFileName);
-    ofFile::copyFromTo(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath(),true,true);
+    PatchDocument::getInstance().copyFile(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath());
 
     currentPatchFile = newFileName;
 
@@ -1737,17 +1863,18 @@ void ofxVisualProgramming::savePatchAsLast(){
     string newFileName = "last_patch.xml";
     ofFile fileToRead(currentPatchFile);
     ofFile newPatchFile(newFileName);
-    ofFile::copyFromTo(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath(),true,true);
+    PatchDocument::getInstance().copyFile(fileToRead.getAbsolutePath(),newPatchFile.getAbsolutePath());
 }
 
 //--------------------------------------------------------------
 void ofxVisualProgramming::setPatchVariable(string var, int value){
-    ofxXmlSettings XML;
+    PatchDocument::Access doc = PatchDocument::getInstance().access(currentPatchFile);
+    ofxXmlSettings &XML = doc.getXml();
 
-    if (XML.loadFile(currentPatchFile)){
+    if (doc.isLoaded()){
         if (XML.pushTag("settings")){
             XML.setValue(var,value);
-            XML.saveFile();
+            doc.setDirty();
             XML.popTag();
         }
     }
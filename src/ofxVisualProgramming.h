@@ -44,6 +44,13 @@
 #include "ofxPDSP.h"
 
 #include "PatchObject.h"
+#include "PatchBinary.h"
+#include "AudioGraph.h"
+#include "ThreadPool.h"
+
+// compiled schedule slot flags
+#define SCHEDULE_MAIN_THREAD    0x01    // GL or ofxDatGui object
+#define SCHEDULE_TIME_DRIVEN    0x02    // runs every frame regardless of its inlets
 
 
 class ofxVisualProgramming : public pdsp::Wrapper {
@@ -94,10 +101,17 @@ public:
     void            deleteObject(int id);
     void            deleteSelectedObject();
 
+    PatchObject*    getObject(int id);
+    void            compilePatchGraph();
+    void            updatePatchObject(size_t slot);
+    void            setParallelUpdate(bool p){ parallelUpdate = p; }
+    float           getEventsPerSecond(){ return eventsPerSecond; }
+    bool            saveProfilerReport(string path);
+
     void            newPatch();
     void            newTempPatchFromFile(string patchFile);
-    void            openPatch(string patchFile);
-    void            loadPatch(string patchFile);
+    void            openPatch(string patchFile, const PatchBinary *binary=nullptr);
+    void            loadPatch(string patchFile, const PatchBinary *binary=nullptr);
     void            savePatchAs(string patchFile);
     void            openLastPatch();
     void            savePatchAsLast();
@@ -110,6 +124,12 @@ public:
 
     void            setIsHoverMenu(bool ish){ isHoverMenu = ish; }
 
+    // HEADLESS (call setHeadless before setup)
+    void            setHeadless(bool h){ headless = h || !hasGLContext; }
+    bool            getIsHeadless(){ return headless; }
+    bool            getHasGLContext(){ return hasGLContext; }
+    void            processAudioBlock(float *input, int bufferSize, int nChannels);
+
     // PATCH CANVAS
     ofxInfiniteCanvas       canvas;
     ofEasyCam               easyCam;
@@ -138,6 +158,34 @@ public:
     bool                    bLoadingNewObject;
     bool                    bLoadingNewPatch;
 
+    // PATCH GRAPH (compiled execution schedule, rebuilt on graph edits)
+    // executionOrder holds the objects level after level, every other schedule array is indexed
+    // by the same slot; patch ids stay the persistent object keys (patchObjects, saved files)
+    vector<PatchObject*>    executionOrder;
+    vector<size_t>          scheduleLevels;         // first slot of each graph level, plus the end
+    vector<uint8_t>         scheduleFlags;          // SCHEDULE_* bits, constant for an object lifetime
+    vector<uint8_t>         scheduleChanged;        // outlets changed on the last run, written by its own slot only
+    vector<size_t>          scheduleUpstreamBegin;  // slots feeding slot i: scheduleUpstream[begin[i]..begin[i+1])
+    vector<size_t>          scheduleUpstream;
+    bool                    bGraphChanged;
+
+    // dense views of patchObjects (id order) for the per frame loops, patchObjects stays the id index
+    vector<PatchObject*>    objectsList;
+
+    // compiled audio nodes, published to the sound stream as immutable snapshots
+    AudioGraph              audioGraph;
+
+    // EVENTS THROUGHPUT (events sent on links per second of patch time)
+    uint64_t                eventsTime;
+    uint64_t                eventsLastCount;
+    float                   eventsPerSecond;
+
+    // PARALLEL UPDATE (independent objects of the same graph level, non GL objects only,
+    // plus the compute steps of the GL/GUI objects)
+    ThreadPool              updatePool;
+    ThreadPool::Job         computeJob;
+    bool                    parallelUpdate;
+
     // LOAD/SAVE
     ofxThreadedFileDialog   fileDialog;
     string                  currentPatchFile;
@@ -154,6 +202,10 @@ public:
     string                          glShadingVersion;
     bool                            profilerActive;
     bool                            inited;
+    bool                            headless;       // no drawing, no mouse/keyboard input, no file dialogs
+    bool                            hasGLContext;   // false without a GLFW window, GL and GUI objects are skipped
+    uint64_t                        headlessAudioTime;
+    vector<float>                   headlessInput;
 
     // GUI
     map<string,vector<string>>      objectsMatrix;
@@ -174,8 +226,6 @@ public:
     vector<int>             audioDevicesID_IN;
     vector<int>             audioDevicesID_OUT;
     ofSoundStream           soundStreamIN;
-    std::mutex              inputAudioMutex;
-    ofSoundBuffer           lastInputBuffer;
     ofPolyline              inputBufferWaveform;
     int                     audioINDev;
     int                     audioOUTDev;
@@ -191,4 +241,8 @@ public:
     
 private:
     void audioProcess(float *input, int bufferSize, int nChannels);
+    void publishAudioGraph();
+    void processAudioNodesIn(const AudioGraphSnapshot *graph, ofSoundBuffer &buffer);
+    void processAudioNodesOut(const AudioGraphSnapshot *graph, ofSoundBuffer &buffer);
+    void processHeadlessAudio();
 };